@@ -0,0 +1,138 @@
+// -------------------------------------------------
+/// A class to unit test simple_ansi_escape
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "simple_ansi_escape.hpp"
+#include "simple_shell_macros.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleAnsiEscape : public TestFixture
+{
+    public:
+
+        TestSimpleAnsiEscape(void) : TestFixture("TestSimpleAnsiEscape")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Strip)
+            TEST_CASE(Blocks)
+            TEST_CASE(Sequences)
+            TEST_CASE(DisplayWidth)
+        }
+
+        void Strip(void)
+        {
+            std::ostringstream colored;
+            colored << COULOURIZE_RED("[NOK]") << " and " << COULOURIZE_LIGHT_GREEN("[OK]") << FONT_BOLD << "!";
+            ASSERT_EQUALS("[NOK] and [OK]!", simple_ansi_parser::GetPlainText(colored.str()));
+            ASSERT_EQUALS("plain text without escapes, longer than 16 bytes", simple_ansi_parser::GetPlainText("plain text without escapes, longer than 16 bytes"));
+            // a window title (OSC with BEL and with ESC \), a charset selection and a cursor movement
+            ASSERT_EQUALS("ab\ncd", simple_ansi_parser::GetPlainText("\033]0;title\007a\033]2;x\033\\b\n\033(Bc\033[10;20Hd"));
+            // a control character within a sequence is kept, CAN cancels a sequence
+            ASSERT_EQUALS("\txy", simple_ansi_parser::GetPlainText("\033[3\t1mx\033[12\030y"));
+            // bytes above 0x7F end a sequence and are text
+            ASSERT_EQUALS("\xC3\xA4", simple_ansi_parser::GetPlainText("\033[\xC3\xA4"));
+            ASSERT_EQUALS("", simple_ansi_parser::GetPlainText("\033[1m\033[0m"));
+            // a string without terminator ends at the end of its line
+            ASSERT_EQUALS("a\nline2\nline3\n", simple_ansi_parser::GetPlainText("a\033]broken\nline2\nline3\n"));
+            ASSERT_EQUALS("a\nb", simple_ansi_parser::GetPlainText("a\033]broken\033\nb"));
+        }
+
+        void Blocks(void)
+        {
+            // every split of the input gives the same text, the state is kept between the blocks
+            const std::string strInput("\033[01;32mgreen\033[22;39m \033]8;;http://x\033\\link\033]8;;\007 \033[?25hend");
+            const std::string strExpected("green link end");
+            for(std::size_t split = 0; split <= strInput.size(); ++split)
+            {
+                simple_ansi_parser parser;
+                std::string strResult;
+                parser.Strip(strResult, std::string_view(strInput).substr(0, split));
+                parser.Strip(strResult, std::string_view(strInput).substr(split));
+                ASSERT_EQUALS(strExpected, strResult);
+                ASSERT_EQUALS_SIZE_T(5, parser.GetNumberOfSequences());
+                ASSERT_EQUALS_BOOL(false, parser.IsInSequence());
+            }
+            simple_ansi_parser parser;
+            std::string strResult;
+            parser.Strip(strResult, "text\033[1");
+            ASSERT_EQUALS_BOOL(true, parser.IsInSequence());
+            parser.Reset();
+            parser.Strip(strResult, "2m");
+            ASSERT_EQUALS("text2m", strResult);
+        }
+
+        void Sequences(void)
+        {
+            std::vector<simple_ansi_sequence> sequences;
+            std::string strText;
+            simple_ansi_parser parser;
+            parser.Parse("\033[22;31mA\033[?1049h\033[;5HB\033[38:5:196m\033(0\033]0;t\007\033[1;2;3;4;5;6;7;8;9;10;11;12;13;14;15;16;17m", [&strText](const char *p, std::size_t size)
+            {
+                strText.append(p, size);
+            }, [&sequences](const simple_ansi_sequence &roSequence)
+            {
+                sequences.push_back(roSequence);
+            });
+            ASSERT_EQUALS("AB", strText);
+            ASSERT_EQUALS_SIZE_T(7, sequences.size());
+
+            ASSERT_EQUALS_BOOL(true, sequences[0].type == simple_ansi_sequence::CSI);
+            ASSERT_EQUALS_CHAR('m', sequences[0].final);
+            ASSERT_EQUALS_UINT32(2, sequences[0].count);
+            ASSERT_EQUALS_INT(22, sequences[0].GetParam(0));
+            ASSERT_EQUALS_INT(31, sequences[0].GetParam(1));
+
+            ASSERT_EQUALS_CHAR('?', sequences[1].prefix);
+            ASSERT_EQUALS_INT(1049, sequences[1].GetParam(0));
+            ASSERT_EQUALS_CHAR('h', sequences[1].final);
+
+            // an empty parameter gets the default value
+            ASSERT_EQUALS_UINT32(2, sequences[2].count);
+            ASSERT_EQUALS_INT(1, sequences[2].GetParam(0, 1));
+            ASSERT_EQUALS_INT(5, sequences[2].GetParam(1, 1));
+            ASSERT_EQUALS_INT(7, sequences[2].GetParam(2, 7));
+
+            ASSERT_EQUALS_UINT32(3, sequences[3].count);
+            ASSERT_EQUALS_INT(196, sequences[3].GetParam(2));
+
+            ASSERT_EQUALS_BOOL(true, sequences[4].type == simple_ansi_sequence::ESCAPE);
+            ASSERT_EQUALS_CHAR('(', sequences[4].intermediate);
+            ASSERT_EQUALS_CHAR('0', sequences[4].final);
+
+            ASSERT_EQUALS_BOOL(true, sequences[5].type == simple_ansi_sequence::STRING);
+            ASSERT_EQUALS_CHAR(']', sequences[5].final);
+
+            // parameters beyond MAX_PARAMS are dropped
+            ASSERT_EQUALS_UINT32(simple_ansi_sequence::MAX_PARAMS, sequences[6].count);
+            ASSERT_EQUALS_INT(16, sequences[6].GetParam(15));
+        }
+
+        void DisplayWidth(void)
+        {
+            ASSERT_EQUALS_SIZE_T(0,  simple_ansi_parser::GetDisplayWidth(""));
+            ASSERT_EQUALS_SIZE_T(48, simple_ansi_parser::GetDisplayWidth("a line of ASCII text, which is longer than 16 by"));
+            ASSERT_EQUALS_SIZE_T(4,  simple_ansi_parser::GetDisplayWidth("\033[22;31m[OK]\033[22;39m\r\n"));
+            // a umlaut, a combining accent, two wide characters and an emoji
+            ASSERT_EQUALS_SIZE_T(1,  simple_ansi_parser::GetDisplayWidth("\xC3\xA4"));
+            ASSERT_EQUALS_SIZE_T(1,  simple_ansi_parser::GetDisplayWidth("e\xCC\x81"));
+            ASSERT_EQUALS_SIZE_T(4,  simple_ansi_parser::GetDisplayWidth("\xE6\x97\xA5\xE6\x9C\xAC"));
+            ASSERT_EQUALS_SIZE_T(2,  simple_ansi_parser::GetDisplayWidth("\xF0\x9F\x98\x80"));
+            // a tab advances to the next multiple of 8, a truncated character is one column
+            ASSERT_EQUALS_SIZE_T(9,  simple_ansi_parser::GetDisplayWidth("ab\tc"));
+            ASSERT_EQUALS_SIZE_T(2,  simple_ansi_parser::GetDisplayWidth("x\xE6\x97"));
+            // a wide character across the boundary of a 16 byte block
+            ASSERT_EQUALS_SIZE_T(17, simple_ansi_parser::GetDisplayWidth("0123456789abcde\xE6\x97\xA5"));
+        }
+};
+
+REGISTER_TEST(TestSimpleAnsiEscape)
@@ -0,0 +1,125 @@
+// -------------------------------------------------
+/// A class to unit test simple_fixed_width
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "simple_fixed_width.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleFixedWidth : public TestFixture
+{
+    public:
+
+        TestSimpleFixedWidth(void) : TestFixture("TestSimpleFixedWidth")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Trim)
+            TEST_CASE(Split)
+            TEST_CASE(SplitColumns)
+            TEST_CASE(ToInteger)
+        }
+
+        void Trim(void)
+        {
+            const std::string strField("                    value                    ");
+            const char *beg = strField.data();
+            const char *end = beg + strField.size();
+            ASSERT_EQUALS_SIZE_T(20, static_cast<std::size_t>(simple_simd::SkipByte(beg, end, ' ') - beg));
+            ASSERT_EQUALS_SIZE_T(25, static_cast<std::size_t>(simple_simd::SkipByteBackwards(beg, end, ' ') - beg));
+            const std::string strBlank(40, ' ');
+            ASSERT_EQUALS_BOOL(true, simple_simd::SkipByte(strBlank.data(), strBlank.data() + 40, ' ') == strBlank.data() + 40);
+            ASSERT_EQUALS_BOOL(true, simple_simd::SkipByteBackwards(strBlank.data(), strBlank.data() + 40, ' ') == strBlank.data());
+        }
+
+        void Split(void)
+        {
+            std::vector<simple_fixed_width_column> layout;
+            layout.push_back(simple_fixed_width_column(0, 6, SIMPLE_FIXED_WIDTH_TRIM_BOTH));
+            layout.push_back(simple_fixed_width_column(6, 4, SIMPLE_FIXED_WIDTH_TRIM_NONE));
+            layout.push_back(simple_fixed_width_column(10, 20));
+            simple_fixed_width splitter(layout);
+            ASSERT_EQUALS_SIZE_T(30, splitter.GetRecordLength());
+            ASSERT_EQUALS_SIZE_T(3, splitter.GetNumberOfColumns());
+
+            std::vector<std::string_view> fields;
+            splitter.Split(fields, "  A1  B 2     Smith, John       ");
+            ASSERT_EQUALS_SIZE_T(3, fields.size());
+            ASSERT_EQUALS("A1",          std::string(fields[0]));
+            ASSERT_EQUALS("B 2 ",        std::string(fields[1]));
+            // the trailing padding of text is removed, the leading one is kept
+            ASSERT_EQUALS("    Smith, John", std::string(fields[2]));
+
+            // a short record truncates the fields
+            splitter.Split(fields, "ABC");
+            ASSERT_EQUALS("ABC", std::string(fields[0]));
+            ASSERT_EQUALS_BOOL(true, fields[1].empty());
+            ASSERT_EQUALS_BOOL(true, fields[2].empty());
+        }
+
+        void SplitColumns(void)
+        {
+            std::vector<simple_fixed_width_column> layout;
+            layout.push_back(simple_fixed_width_column(0, 4, SIMPLE_FIXED_WIDTH_TRIM_LEADING, '0'));
+            layout.push_back(simple_fixed_width_column(4, 6, SIMPLE_FIXED_WIDTH_TRIM_LEADING, '0'));
+            simple_fixed_width splitter(layout);
+
+            // records separated by newlines
+            std::vector< std::vector<std::string_view> > columns;
+            ASSERT_EQUALS_SIZE_T(3, splitter.SplitColumns(columns, "0001000042\n0002001000\n0003\n"));
+            ASSERT_EQUALS_SIZE_T(2, columns.size());
+            ASSERT_EQUALS("1",  std::string(columns[0][0]));
+            ASSERT_EQUALS("42", std::string(columns[1][0]));
+            ASSERT_EQUALS("1000", std::string(columns[1][1]));
+            ASSERT_EQUALS("3",  std::string(columns[0][2]));
+            ASSERT_EQUALS_BOOL(true, columns[1][2].empty());
+
+            // records separated by CRLF, the last one without
+            ASSERT_EQUALS_SIZE_T(3, splitter.SplitColumns(columns, "0001000042\r\n0002001000\r\n0003\r"));
+            ASSERT_EQUALS("42", std::string(columns[1][0]));
+            ASSERT_EQUALS("1000", std::string(columns[1][1]));
+            ASSERT_EQUALS("3",  std::string(columns[0][2]));
+            ASSERT_EQUALS_BOOL(true, columns[1][2].empty());
+
+            // records without separator
+            ASSERT_EQUALS_SIZE_T(2, splitter.SplitColumns(columns, "00070000090008000010", 10));
+            ASSERT_EQUALS("7", std::string(columns[0][0]));
+            ASSERT_EQUALS("10", std::string(columns[1][1]));
+
+            // trailing zeros are significant, a zero keeps its last digit
+            ASSERT_EQUALS_SIZE_T(1, splitter.SplitColumns(columns, "0100000000"));
+            ASSERT_EQUALS("100", std::string(columns[0][0]));
+            ASSERT_EQUALS("0",   std::string(columns[1][0]));
+        }
+
+        void ToInteger(void)
+        {
+            int64_t value = 0;
+            ASSERT_EQUALS_BOOL(true, simple_fixed_width::ToInteger(value, "-042"));
+            ASSERT_EQUALS_INT64(-42, value);
+            ASSERT_EQUALS_BOOL(true, simple_fixed_width::ToInteger(value, "-9223372036854775808"));
+            ASSERT_EQUALS_BOOL(true, value == INT64_MIN);
+            ASSERT_EQUALS_BOOL(false, simple_fixed_width::ToInteger(value, "9223372036854775808"));
+            ASSERT_EQUALS_BOOL(false, simple_fixed_width::ToInteger(value, "12a"));
+            ASSERT_EQUALS_BOOL(false, simple_fixed_width::ToInteger(value, "-"));
+            ASSERT_EQUALS_BOOL(false, simple_fixed_width::ToInteger(value, ""));
+
+            std::vector<std::string_view> column;
+            column.push_back("17");
+            column.push_back("+3");
+            std::vector<int64_t> values;
+            ASSERT_EQUALS_BOOL(true, simple_fixed_width::ToIntegers(values, column));
+            ASSERT_EQUALS_SIZE_T(2, values.size());
+            ASSERT_EQUALS_INT64(3, values[1]);
+        }
+};
+
+REGISTER_TEST(TestSimpleFixedWidth)
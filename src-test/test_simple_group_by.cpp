@@ -0,0 +1,154 @@
+// -------------------------------------------------
+/// A class to unit test simple_group_by
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "simple_group_by.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleGroupBy : public TestFixture
+{
+    public:
+
+        TestSimpleGroupBy(void) : TestFixture("TestSimpleGroupBy")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Aggregates)
+            TEST_CASE(Growth)
+            TEST_CASE(Merge)
+            TEST_CASE(Lines)
+        }
+
+        void Aggregates(void)
+        {
+            simple_group_by groups;
+            std::vector<std::string_view> keys;
+            std::vector<int64_t> values;
+            keys.push_back("a");
+            values.push_back(5);
+            keys.push_back("b");
+            values.push_back(-2);
+            keys.push_back("a");
+            values.push_back(1);
+            keys.push_back("a");
+            values.push_back(9);
+            groups.AddColumns(keys, values);
+            groups.Add("c", 7);
+            ASSERT_EQUALS_SIZE_T(3, groups.Size());
+
+            simple_group_aggregate aggregate;
+            ASSERT_EQUALS_BOOL(true, groups.Get("a", aggregate));
+            ASSERT_EQUALS_UINT64(3,  aggregate.count);
+            ASSERT_EQUALS_INT64(15,  aggregate.sum);
+            ASSERT_EQUALS_INT64(1,   aggregate.min);
+            ASSERT_EQUALS_INT64(9,   aggregate.max);
+            ASSERT_EQUALS_BOOL(true, aggregate.Mean() == 5.0);
+            ASSERT_EQUALS_BOOL(true, groups.Get("b", aggregate));
+            ASSERT_EQUALS_INT64(-2,  aggregate.min);
+            ASSERT_EQUALS_INT64(-2,  aggregate.max);
+            ASSERT_EQUALS_BOOL(false, groups.Get("d", aggregate));
+
+            std::vector< std::pair<std::string, simple_group_aggregate> > sorted;
+            groups.GetGroups(sorted);
+            ASSERT_EQUALS_SIZE_T(3, sorted.size());
+            ASSERT_EQUALS("a", sorted[0].first);
+            ASSERT_EQUALS("c", sorted[2].first);
+            ASSERT_EQUALS_INT64(7, sorted[2].second.sum);
+
+            groups.Clear();
+            ASSERT_EQUALS_SIZE_T(0, groups.Size());
+            ASSERT_EQUALS_BOOL(false, groups.Get("a", aggregate));
+        }
+
+        void Growth(void)
+        {
+            // far more groups than expected, the table grows in the middle of the input
+            simple_group_by groups(4);
+            std::vector<std::string> storage;
+            for(int i = 0; i < 5000; ++i)
+            {
+                storage.push_back("key" + std::to_string(i));
+            }
+            std::vector<std::string_view> keys;
+            std::vector<int64_t> values;
+            for(int round = 0; round < 3; ++round)
+            {
+                for(int i = 0; i < 5000; ++i)
+                {
+                    keys.push_back(storage[i]);
+                    values.push_back(i);
+                }
+            }
+            groups.AddColumns(keys, values);
+            ASSERT_EQUALS_SIZE_T(5000, groups.Size());
+            simple_group_aggregate aggregate;
+            ASSERT_EQUALS_BOOL(true, groups.Get("key4321", aggregate));
+            ASSERT_EQUALS_UINT64(3, aggregate.count);
+            ASSERT_EQUALS_INT64(3 * 4321, aggregate.sum);
+        }
+
+        void Merge(void)
+        {
+            simple_group_by first;
+            simple_group_by second;
+            first.Add("x", 1);
+            first.Add("y", 10);
+            second.Add("y", -5);
+            second.Add("z", 3);
+            first.Merge(second);
+            ASSERT_EQUALS_SIZE_T(3, first.Size());
+            simple_group_aggregate aggregate;
+            ASSERT_EQUALS_BOOL(true, first.Get("y", aggregate));
+            ASSERT_EQUALS_UINT64(2, aggregate.count);
+            ASSERT_EQUALS_INT64(5,  aggregate.sum);
+            ASSERT_EQUALS_INT64(-5, aggregate.min);
+            ASSERT_EQUALS_INT64(10, aggregate.max);
+            ASSERT_EQUALS_BOOL(true, first.Get("z", aggregate));
+            ASSERT_EQUALS_INT64(3,  aggregate.min);
+        }
+
+        void Lines(void)
+        {
+            // group by field 1, aggregate field 2, invalid lines are skipped
+            std::string strData("t1 GET 10\nt2 PUT 20\nt3 GET 5\nshort\nt4 GET x\n\nt5 GET -1");
+            simple_group_by groups;
+            ASSERT_EQUALS_SIZE_T(4, groups.AddLines<CIsSpace>(strData, 1, 2));
+            simple_group_aggregate aggregate;
+            ASSERT_EQUALS_BOOL(true, groups.Get("GET", aggregate));
+            ASSERT_EQUALS_UINT64(3, aggregate.count);
+            ASSERT_EQUALS_INT64(14, aggregate.sum);
+            ASSERT_EQUALS_INT64(-1, aggregate.min);
+
+            // several threads give the same result
+            std::string strLarge;
+            for(int i = 0; i < 200000; ++i)
+            {
+                strLarge += "row" + std::to_string(i) + ",k" + std::to_string(i % 7) + "," + std::to_string(i % 100) + "\n";
+            }
+            simple_group_by serial;
+            simple_group_by parallel;
+            ASSERT_EQUALS_SIZE_T(200000, simple_group_by::AggregateLines(serial,   strLarge, 1, 2, 1, CIsComma()));
+            ASSERT_EQUALS_SIZE_T(200000, simple_group_by::AggregateLines(parallel, strLarge, 1, 2, 4, CIsComma()));
+            ASSERT_EQUALS_SIZE_T(7, parallel.Size());
+            simple_group_aggregate expected;
+            ASSERT_EQUALS_BOOL(true, serial.Get("k3", expected));
+            ASSERT_EQUALS_BOOL(true, parallel.Get("k3", aggregate));
+            ASSERT_EQUALS_UINT64(expected.count, aggregate.count);
+            ASSERT_EQUALS_INT64(expected.sum,    aggregate.sum);
+            ASSERT_EQUALS_INT64(0,  aggregate.min);
+            ASSERT_EQUALS_INT64(99, aggregate.max);
+        }
+};
+
+REGISTER_TEST(TestSimpleGroupBy)
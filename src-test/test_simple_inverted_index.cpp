@@ -0,0 +1,183 @@
+// -------------------------------------------------
+/// A class to unit test simple_inverted_index
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+
+#include "simple_inverted_index.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleInvertedIndex : public TestFixture
+{
+    public:
+
+        TestSimpleInvertedIndex(void) : TestFixture("TestSimpleInvertedIndex")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(DecodeDeltas)
+            TEST_CASE(Queries)
+            TEST_CASE(Invalidation)
+        }
+
+        static void WriteFile(const std::string &strFileName, const std::string &strContent)
+        {
+            std::ofstream ofs(strFileName.c_str(), std::ios::binary);
+            ofs << strContent;
+        }
+
+        static void RemoveFiles(const std::string &strFileName)
+        {
+            (void)remove(strFileName.c_str());
+            (void)remove(simple_inverted_index<>::GetIndexFileName(strFileName).c_str());
+        }
+
+        void DecodeDeltas(void)
+        {
+            // 20 one byte deltas, a three byte delta (20000) and two more one byte deltas, then the padding
+            std::vector<unsigned char> encoded(20, 1);
+            encoded.push_back(0xA0);
+            encoded.push_back(0x9C);
+            encoded.push_back(0x01);
+            encoded.push_back(5);
+            encoded.push_back(0);
+            encoded.resize(encoded.size() + 16, 0);
+
+            std::vector<uint64_t> values(23);
+            const unsigned char *p = simple_inverted_index<>::DecodeDeltas(encoded.data(), values.size(), values.data());
+            ASSERT_EQUALS_SIZE_T(25, static_cast<std::size_t>(p - encoded.data()));
+            ASSERT_EQUALS_UINT64(1,     values[0]);
+            ASSERT_EQUALS_UINT64(20,    values[19]);
+            ASSERT_EQUALS_UINT64(20020, values[20]);
+            ASSERT_EQUALS_UINT64(20025, values[21]);
+            ASSERT_EQUALS_UINT64(20025, values[22]);
+        }
+
+        void Queries(void)
+        {
+            const std::string strFileName("test_simple_inverted_index_queries.txt");
+            std::string strContent("error disk full\ninfo disk ok\n\nerror net error\n");
+            // enough lines in between, so that the offsets need varints of several bytes
+            for(int i = 0; i < 200; ++i)
+            {
+                strContent += "info padding line\n";
+            }
+            const uint64_t lastLine = strContent.size();
+            strContent += "warn disk error";
+            WriteFile(strFileName, strContent);
+
+            simple_inverted_index<> index;
+            ASSERT_EQUALS_BOOL(true, index.Open(strFileName, 2));
+            ASSERT_EQUALS_BOOL(true, index.WasIndexBuilt());
+            ASSERT_EQUALS_SIZE_T(9, index.GetNumberOfTerms());
+            ASSERT_EQUALS_SIZE_T(3,   index.GetNumberOfLines("error"));
+            ASSERT_EQUALS_SIZE_T(201, index.GetNumberOfLines("info"));
+            ASSERT_EQUALS_SIZE_T(0,   index.GetNumberOfLines("missing"));
+
+            std::vector<uint64_t> lines;
+            ASSERT_EQUALS_BOOL(true, index.Lookup(lines, "error"));
+            ASSERT_EQUALS_SIZE_T(3, lines.size());
+            ASSERT_EQUALS_UINT64(0,  lines[0]);
+            ASSERT_EQUALS_UINT64(30, lines[1]);
+            ASSERT_EQUALS_UINT64(lastLine, lines[2]);
+            ASSERT_EQUALS("error net error", std::string(index.GetLine(lines[1])));
+            ASSERT_EQUALS("warn disk error", std::string(index.GetLine(lines[2])));
+            ASSERT_EQUALS_BOOL(false, index.Lookup(lines, "missing"));
+            ASSERT_EQUALS_SIZE_T(0, lines.size());
+
+            index.QueryAnd(lines, {"disk", "error"});
+            ASSERT_EQUALS_SIZE_T(2, lines.size());
+            ASSERT_EQUALS_UINT64(0, lines[0]);
+            ASSERT_EQUALS_UINT64(lastLine, lines[1]);
+            index.QueryAnd(lines, {"disk", "missing"});
+            ASSERT_EQUALS_SIZE_T(0, lines.size());
+
+            index.QueryOr(lines, {"net", "ok", "missing", "warn"});
+            ASSERT_EQUALS_SIZE_T(3, lines.size());
+            ASSERT_EQUALS_UINT64(16, lines[0]);
+            ASSERT_EQUALS_UINT64(30, lines[1]);
+            ASSERT_EQUALS_UINT64(lastLine, lines[2]);
+
+            // the second run maps the existing index
+            simple_inverted_index<> again;
+            ASSERT_EQUALS_BOOL(true,  again.Open(strFileName));
+            ASSERT_EQUALS_BOOL(false, again.WasIndexBuilt());
+            again.QueryAnd(lines, {"padding"});
+            ASSERT_EQUALS_SIZE_T(200, lines.size());
+
+            index.Close();
+            again.Close();
+            RemoveFiles(strFileName);
+        }
+
+        void Invalidation(void)
+        {
+            const std::string strFileName("test_simple_inverted_index_invalidation.txt");
+            WriteFile(strFileName, "one two\nthree");
+            {
+                simple_inverted_index<> index;
+                ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+                ASSERT_EQUALS_BOOL(true, index.WasIndexBuilt());
+            }
+
+            // a changed input of the same size
+            WriteFile(strFileName, "one two\nfour!");
+            {
+                simple_inverted_index<> index;
+                ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+                ASSERT_EQUALS_BOOL(true, index.WasIndexBuilt());
+                ASSERT_EQUALS_SIZE_T(1, index.GetNumberOfLines("four!"));
+                ASSERT_EQUALS_SIZE_T(0, index.GetNumberOfLines("three"));
+            }
+
+            // a truncated index is rebuilt
+            {
+                std::ofstream ofs(simple_inverted_index<>::GetIndexFileName(strFileName).c_str(), std::ios::binary);
+                ofs << "SINVX";
+            }
+            {
+                simple_inverted_index<> index;
+                ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+                ASSERT_EQUALS_BOOL(true, index.WasIndexBuilt());
+            }
+
+            // an index of an other tokenizer is rebuilt
+            WriteFile(strFileName, "a,b c\nd");
+            {
+                simple_inverted_index<> index;
+                ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+                ASSERT_EQUALS_SIZE_T(1, index.GetNumberOfLines("a,b"));
+            }
+            {
+                simple_inverted_index<CIsComma> index;
+                ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+                ASSERT_EQUALS_BOOL(true, index.WasIndexBuilt());
+                ASSERT_EQUALS_SIZE_T(1, index.GetNumberOfLines("b c"));
+                ASSERT_EQUALS_SIZE_T(0, index.GetNumberOfLines("a,b"));
+            }
+            {
+                simple_inverted_index<CIsFromString> index(CIsFromString(" "), "CIsFromString( )");
+                ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+                ASSERT_EQUALS_BOOL(true, index.WasIndexBuilt());
+                simple_inverted_index<CIsFromString> same(CIsFromString(" "), "CIsFromString( )");
+                ASSERT_EQUALS_BOOL(true, same.Open(strFileName));
+                ASSERT_EQUALS_BOOL(false, same.WasIndexBuilt());
+            }
+
+            simple_inverted_index<> missing;
+            ASSERT_EQUALS_BOOL(false, missing.Open("test_simple_inverted_index_missing.txt"));
+            RemoveFiles(strFileName);
+        }
+};
+
+REGISTER_TEST(TestSimpleInvertedIndex)
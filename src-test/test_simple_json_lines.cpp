@@ -0,0 +1,113 @@
+// -------------------------------------------------
+/// A class to unit test simple_json_lines
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <string_view>
+
+#include "simple_json_lines.hpp"
+#include "simple_testsuite.hpp"
+
+static constexpr auto jsonSchema = simple_make_kv_schema("user", "status", "msg", "meta", "ok");
+
+class TestSimpleJsonLines : public TestFixture
+{
+    public:
+
+        TestSimpleJsonLines(void) : TestFixture("TestSimpleJsonLines")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Values)
+            TEST_CASE(Strings)
+            TEST_CASE(Invalid)
+            TEST_CASE(Unescape)
+        }
+
+        void Values(void)
+        {
+            simple_json_lines_parser<5> parser(jsonSchema);
+            const std::size_t USER   = jsonSchema.Find("user");
+            const std::size_t STATUS = jsonSchema.Find("status");
+            const std::size_t META   = jsonSchema.Find("meta");
+            const std::size_t OK     = jsonSchema.Find("ok");
+            const std::size_t MSG    = jsonSchema.Find("msg");
+            // the keys of the nested object are not top-level keys
+            ASSERT_EQUALS_SIZE_T(4, parser.Parse("{ \"meta\" : {\"user\":\"eve\",\"list\":[1,{\"x\":2}]}, \"status\": 200 ,\"user\":\"bob\",\"ok\":true}"));
+            ASSERT_EQUALS("bob", std::string(parser.Get(USER)));
+            ASSERT_EQUALS_BOOL(true, parser.GetType(USER) == SIMPLE_JSON_STRING);
+            ASSERT_EQUALS("200", std::string(parser.Get(STATUS)));
+            ASSERT_EQUALS_BOOL(true, parser.GetType(STATUS) == SIMPLE_JSON_NUMBER);
+            ASSERT_EQUALS("{\"user\":\"eve\",\"list\":[1,{\"x\":2}]}", std::string(parser.Get(META)));
+            ASSERT_EQUALS_BOOL(true, parser.GetType(META) == SIMPLE_JSON_OBJECT);
+            ASSERT_EQUALS("true", std::string(parser.Get(OK)));
+            ASSERT_EQUALS_BOOL(false, parser.Has(MSG));
+            ASSERT_EQUALS_BOOL(true, parser.GetType(MSG) == SIMPLE_JSON_NONE);
+
+            // the first value of a repeated key is kept, the previous line is forgotten
+            ASSERT_EQUALS_SIZE_T(2, parser.Parse("{\"msg\":null,\"user\":[],\"user\":\"x\"}"));
+            ASSERT_EQUALS_BOOL(true, parser.GetType(MSG) == SIMPLE_JSON_NULL);
+            ASSERT_EQUALS("[]", std::string(parser.Get(USER)));
+            ASSERT_EQUALS_BOOL(false, parser.Has(STATUS));
+        }
+
+        void Strings(void)
+        {
+            simple_json_lines_parser<5> parser(jsonSchema);
+            const std::size_t USER = jsonSchema.Find("user");
+            const std::size_t MSG  = jsonSchema.Find("msg");
+            // structural characters and escaped quotes within strings, a run of backslashes across a block boundary
+            const std::string strLine("{\"msg\":\"a, \\\"b\\\": {c}\",\"x\":\"0123456789\\\\\\\\\",\"user\":\"u\\\\\"}");
+            ASSERT_EQUALS_SIZE_T(2, parser.Parse(strLine));
+            ASSERT_EQUALS("a, \\\"b\\\": {c}", std::string(parser.Get(MSG)));
+            ASSERT_EQUALS_BOOL(true, parser.IsEscaped(MSG));
+            ASSERT_EQUALS("u\\\\", std::string(parser.Get(USER)));
+            std::string strValue;
+            ASSERT_EQUALS_BOOL(true, simple_json_lines_parser<5>::Unescape(strValue, parser.Get(MSG)));
+            ASSERT_EQUALS("a, \"b\": {c}", strValue);
+
+            // every position of an escaped quote and of a run of backslashes relative to the 64 byte blocks
+            for(std::size_t padding = 0; padding < 70; ++padding)
+            {
+                const std::string strPadded("{\"pad\":\"" + std::string(padding, 'p') + "\\\"}\",\"user\":\"ok\"}");
+                ASSERT_EQUALS_SIZE_T(1, parser.Parse(strPadded));
+                ASSERT_EQUALS("ok", std::string(parser.Get(USER)));
+                ASSERT_EQUALS_BOOL(false, parser.IsEscaped(USER));
+                const std::string strRun("{\"pad\":\"" + std::string(padding, 'p') + "\\\\\\\"\\\\\",\"user\":\"ok\"}");
+                ASSERT_EQUALS_SIZE_T(1, parser.Parse(strRun));
+                ASSERT_EQUALS("ok", std::string(parser.Get(USER)));
+            }
+        }
+
+        void Invalid(void)
+        {
+            simple_json_lines_parser<5> parser(jsonSchema);
+            ASSERT_EQUALS_SIZE_T(0, parser.Parse(""));
+            ASSERT_EQUALS_SIZE_T(0, parser.Parse("[1,2]"));
+            ASSERT_EQUALS_SIZE_T(0, parser.Parse("\"user\""));
+            // the values before the end of a truncated line are kept
+            ASSERT_EQUALS_SIZE_T(1, parser.Parse("{\"status\":1,\"user\":\"trunc"));
+            ASSERT_EQUALS_BOOL(true, parser.Has(jsonSchema.Find("status")));
+            ASSERT_EQUALS_BOOL(false, parser.Has(jsonSchema.Find("user")));
+        }
+
+        void Unescape(void)
+        {
+            std::string strResult;
+            ASSERT_EQUALS_BOOL(true, simple_json_lines_parser<1>::Unescape(strResult, "tab\\there\\n\\/\\\\"));
+            ASSERT_EQUALS("tab\there\n/\\", strResult);
+            ASSERT_EQUALS_BOOL(true, simple_json_lines_parser<1>::Unescape(strResult, "\\u00e4\\u65E5\\ud83d\\ude00"));
+            ASSERT_EQUALS("\xC3\xA4\xE6\x97\xA5\xF0\x9F\x98\x80", strResult);
+            ASSERT_EQUALS_BOOL(false, simple_json_lines_parser<1>::Unescape(strResult, "\\x"));
+            ASSERT_EQUALS_BOOL(false, simple_json_lines_parser<1>::Unescape(strResult, "\\u12"));
+            ASSERT_EQUALS_BOOL(false, simple_json_lines_parser<1>::Unescape(strResult, "\\ud83d"));
+            ASSERT_EQUALS_BOOL(false, simple_json_lines_parser<1>::Unescape(strResult, "end\\"));
+        }
+};
+
+REGISTER_TEST(TestSimpleJsonLines)
@@ -0,0 +1,97 @@
+// -------------------------------------------------
+/// A class to unit test simple_kv_parser
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "simple_kv_parser.hpp"
+#include "simple_testsuite.hpp"
+
+// the hash table of the schema is built by the compiler
+static constexpr auto g_Schema = simple_make_kv_schema("ts", "level", "user", "ip", "status", "latency");
+static constexpr std::size_t LEVEL  = g_Schema.Find("level");
+static constexpr std::size_t STATUS = g_Schema.Find("status");
+
+static_assert(g_Schema.IsValid(), "the keys are distinct");
+static_assert(LEVEL == 1, "the slot of a key is its position in the schema");
+static_assert(STATUS == 4, "the slot of a key is its position in the schema");
+static_assert(g_Schema.Find("unknown") == simple_kv_schema<6>::NPOS, "unknown keys have no slot");
+// duplicate keys are rejected instead of searching a seed forever
+static_assert(!simple_make_kv_schema("user", "ip", "user").IsValid(), "duplicate keys are invalid");
+
+class TestSimpleKvParser : public TestFixture
+{
+    public:
+
+        TestSimpleKvParser(void) : TestFixture("TestSimpleKvParser")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Schema)
+            TEST_CASE(Parse)
+            TEST_CASE(Overflow)
+        }
+
+        void Schema(void)
+        {
+            std::size_t found = 0;
+            for(std::size_t ui = 0; ui < g_Schema.size(); ++ui)
+            {
+                found += (g_Schema.Find(g_Schema.GetKey(ui)) == ui) ? 1 : 0;
+            }
+            ASSERT_EQUALS_SIZE_T(6, found);
+            ASSERT_EQUALS_BOOL(true, g_Schema.Find("") == simple_kv_schema<6>::NPOS);
+            ASSERT_EQUALS_BOOL(true, g_Schema.Find("statu") == simple_kv_schema<6>::NPOS);
+
+            // a schema, which is built at runtime, with a duplicate key
+            const std::string strKey("ip");
+            const simple_kv_schema<3> duplicates(std::array<std::string_view, 3> {{ "ip", "user", strKey }});
+            ASSERT_EQUALS_BOOL(false, duplicates.IsValid());
+            ASSERT_EQUALS_BOOL(true, duplicates.Find("user") == simple_kv_schema<3>::NPOS);
+        }
+
+        void Parse(void)
+        {
+            simple_kv_parser<6> parser(g_Schema);
+            ASSERT_EQUALS_SIZE_T(4, parser.Parse("  level=warn user=bob  status=503 latency= noassign"));
+            ASSERT_EQUALS("warn", std::string(parser.Get(LEVEL)));
+            ASSERT_EQUALS("503",  std::string(parser.Get(STATUS)));
+            ASSERT_EQUALS_BOOL(true,  parser.Has(g_Schema.Find("latency")));
+            ASSERT_EQUALS_BOOL(true,  parser.Get(g_Schema.Find("latency")).empty());
+            ASSERT_EQUALS_BOOL(false, parser.Has(g_Schema.Find("ip")));
+            ASSERT_EQUALS_BOOL(false, parser.Has(simple_kv_schema<6>::NPOS));
+
+            // the values of the previous line are removed, the last value of a key is kept
+            ASSERT_EQUALS_SIZE_T(1, parser.Parse("status=200 status=404"));
+            ASSERT_EQUALS("404", std::string(parser.Get(STATUS)));
+            ASSERT_EQUALS_BOOL(false, parser.Has(LEVEL));
+
+            // only the first assignment character separates key and value
+            simple_kv_parser<6, CIsAmpersand> query(g_Schema);
+            ASSERT_EQUALS_SIZE_T(2, query.Parse("user=a=b&&ip=::1"));
+            ASSERT_EQUALS("a=b", std::string(query.Get(g_Schema.Find("user"))));
+            ASSERT_EQUALS("::1", std::string(query.Get(g_Schema.Find("ip"))));
+        }
+
+        void Overflow(void)
+        {
+            simple_kv_parser<6, CIsComma> parser(g_Schema, ':');
+            std::vector<simple_kv_parser<6, CIsComma>::pair_type> overflow;
+            ASSERT_EQUALS_SIZE_T(1, parser.Parse("user:eve,region:eu,zone:", &overflow));
+            ASSERT_EQUALS_SIZE_T(2, overflow.size());
+            ASSERT_EQUALS("region", std::string(overflow[0].first));
+            ASSERT_EQUALS("eu",     std::string(overflow[0].second));
+            ASSERT_EQUALS("zone",   std::string(overflow[1].first));
+            ASSERT_EQUALS_BOOL(true, overflow[1].second.empty());
+        }
+};
+
+REGISTER_TEST(TestSimpleKvParser)
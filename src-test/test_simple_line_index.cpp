@@ -0,0 +1,162 @@
+// -------------------------------------------------
+/// A class to unit test simple_line_index
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdio>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simple_line_index.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleLineIndex : public TestFixture
+{
+    public:
+
+        TestSimpleLineIndex(void) : TestFixture("TestSimpleLineIndex")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(SmallFile)
+            TEST_CASE(Reuse)
+            TEST_CASE(ParallelBuild)
+            TEST_CASE(UnwritableIndex)
+        }
+
+        static void WriteFile(const std::string &strFileName, const std::string &strContent)
+        {
+            std::ofstream ofs(strFileName.c_str(), std::ios::binary);
+            ofs << strContent;
+        }
+
+        static void RemoveFiles(const std::string &strFileName)
+        {
+            (void)remove(strFileName.c_str());
+            (void)remove(simple_line_index::GetIndexFileName(strFileName).c_str());
+        }
+
+        void SmallFile(void)
+        {
+            const std::string strFileName("test_simple_line_index_small.txt");
+            simple_line_index index;
+
+            WriteFile(strFileName, "");
+            ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+            ASSERT_EQUALS_SIZE_T(0, index.GetNumberOfRecords());
+
+            WriteFile(strFileName, "first line\n\nthird\tline\nlast line without newline");
+            ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+            ASSERT_EQUALS_SIZE_T(4, index.GetNumberOfRecords());
+            ASSERT_EQUALS("first line", std::string(index.GetRecord(0)));
+            ASSERT_EQUALS("",           std::string(index.GetRecord(1)));
+            ASSERT_EQUALS("last line without newline", std::string(index.GetRecord(3)));
+
+            std::vector<std::string> strResult;
+            index.TokenizeRecord<CIsSpace>(strResult, 2);
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS("line", strResult[1]);
+
+            // a trailing newline does not start a record
+            WriteFile(strFileName, "a\nb\n");
+            ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+            ASSERT_EQUALS_SIZE_T(2, index.GetNumberOfRecords());
+            ASSERT_EQUALS("b", std::string(index.GetRecord(1)));
+
+            index.Close();
+            RemoveFiles(strFileName);
+            ASSERT_EQUALS_BOOL(false, index.Open(strFileName));
+        }
+
+        void Reuse(void)
+        {
+            const std::string strFileName("test_simple_line_index_reuse.txt");
+            WriteFile(strFileName, "1\n2\n3\n");
+            {
+                simple_line_index index;
+                ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+                ASSERT_EQUALS_BOOL(true, index.WasIndexBuilt());
+            }
+            simple_line_index index;
+            ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+            ASSERT_EQUALS_BOOL(false, index.WasIndexBuilt());
+            ASSERT_EQUALS("3", std::string(index.GetRecord(2)));
+
+            // a changed file invalidates the index
+            WriteFile(strFileName, "1\n2\n3\n4\n");
+            ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+            ASSERT_EQUALS_BOOL(true, index.WasIndexBuilt());
+            ASSERT_EQUALS_SIZE_T(4, index.GetNumberOfRecords());
+
+            // a corrupt index is rebuilt
+            index.Close();
+            WriteFile(simple_line_index::GetIndexFileName(strFileName), "garbage");
+            ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+            ASSERT_EQUALS_BOOL(true, index.WasIndexBuilt());
+            ASSERT_EQUALS("4", std::string(index.GetRecord(3)));
+            index.Close();
+            RemoveFiles(strFileName);
+        }
+
+        void ParallelBuild(void)
+        {
+            // about 3 MB, such that several chunks are indexed in parallel
+            const std::string strFileName("test_simple_line_index_parallel.txt");
+            std::vector<std::string> lines;
+            std::string strContent;
+            for(unsigned int i = 0; strContent.size() < 3 * 1024 * 1024; ++i)
+            {
+                lines.push_back("record " + std::to_string(i) + " " + std::string(i % 97, 'x'));
+                strContent += lines.back() + "\n";
+            }
+            WriteFile(strFileName, strContent);
+
+            ASSERT_EQUALS_BOOL(true, simple_line_index::Build(strFileName, simple_line_index::GetIndexFileName(strFileName), 4));
+            simple_line_index index;
+            ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+            ASSERT_EQUALS_BOOL(false, index.WasIndexBuilt());
+            ASSERT_EQUALS_SIZE_T(lines.size(), index.GetNumberOfRecords());
+            std::size_t mismatches = 0;
+            for(std::size_t ui = 0; ui < lines.size(); ++ui)
+            {
+                if(index.GetRecord(ui) != lines[ui])
+                {
+                    ++mismatches;
+                }
+            }
+            ASSERT_EQUALS_SIZE_T(0, mismatches);
+            index.Close();
+            RemoveFiles(strFileName);
+        }
+
+        void UnwritableIndex(void)
+        {
+            // a directory in place of the index cannot be replaced, the index stays in memory
+            const std::string strFileName("test_simple_line_index_unwritable.txt");
+            const std::string strIndexFileName(simple_line_index::GetIndexFileName(strFileName));
+            WriteFile(strFileName, "one\ntwo\n");
+            ASSERT_EQUALS_INT(0, mkdir(strIndexFileName.c_str(), 0755));
+            simple_line_index index;
+            ASSERT_EQUALS_BOOL(true, index.Open(strFileName));
+            ASSERT_EQUALS_BOOL(true, index.WasIndexBuilt());
+            ASSERT_EQUALS_BOOL(true, index.IsIndexInMemory());
+            ASSERT_EQUALS_SIZE_T(2, index.GetNumberOfRecords());
+            ASSERT_EQUALS("two", std::string(index.GetRecord(1)));
+            ASSERT_EQUALS_BOOL(false, simple_line_index::Build(strFileName, strIndexFileName));
+            index.Close();
+            ASSERT_EQUALS_BOOL(false, index.IsIndexInMemory());
+            (void)rmdir(strIndexFileName.c_str());
+            (void)remove((strIndexFileName + ".tmp").c_str());
+            RemoveFiles(strFileName);
+        }
+};
+
+REGISTER_TEST(TestSimpleLineIndex)
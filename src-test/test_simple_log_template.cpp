@@ -0,0 +1,142 @@
+// -------------------------------------------------
+/// A class to unit test simple_log_template
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "simple_log_template.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleLogTemplate : public TestFixture
+{
+    public:
+
+        TestSimpleLogTemplate(void) : TestFixture("TestSimpleLogTemplate")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Templates)
+            TEST_CASE(Routing)
+            TEST_CASE(Eviction)
+            TEST_CASE(Merge)
+        }
+
+        void Templates(void)
+        {
+            simple_log_template_miner<> miner;
+            std::vector<std::string_view> params;
+            const std::size_t id = miner.Add("Connection from 10.0.0.1 closed after 17 ms", params);
+            ASSERT_EQUALS_SIZE_T(0, params.size());
+            ASSERT_EQUALS_SIZE_T(id, miner.Add("Connection  from 10.0.0.2 closed after 5 ms", params));
+            ASSERT_EQUALS("Connection from <*> closed after <*> ms", miner.GetTemplate(id));
+            ASSERT_EQUALS_SIZE_T(2, params.size());
+            ASSERT_EQUALS("10.0.0.2", std::string(params[0]));
+            ASSERT_EQUALS("5", std::string(params[1]));
+
+            // an other length and a dissimilar line of the same length are other templates
+            const std::size_t other = miner.Add("Connection from 10.0.0.3 closed");
+            ASSERT_EQUALS_BOOL(true, other != id);
+            const std::size_t disk = miner.Add("Disk sda1 is at 93 percent usage");
+            ASSERT_EQUALS_BOOL(true, disk != id && disk != other);
+            ASSERT_EQUALS_SIZE_T(3, miner.GetNumberOfTemplates());
+            ASSERT_EQUALS_UINT64(4, miner.GetTotal());
+            ASSERT_EQUALS_UINT64(2, miner.GetCount(id));
+
+            // a match does not change the templates
+            ASSERT_EQUALS_SIZE_T(id, miner.Match("Connection from host closed after 1 ms"));
+            ASSERT_EQUALS_SIZE_T(simple_log_template_miner<>::NPOS, miner.Match("Unknown line"));
+            ASSERT_EQUALS("Connection from <*> closed after <*> ms", miner.GetTemplate(id));
+            ASSERT_EQUALS_UINT64(2, miner.GetCount(id));
+
+            std::vector<std::size_t> ids;
+            miner.GetTemplateIds(ids);
+            ASSERT_EQUALS_SIZE_T(3, ids.size());
+            ASSERT_EQUALS_SIZE_T(id, ids[0]);
+            ASSERT_EQUALS("", miner.GetTemplate(99));
+
+            // an empty line has a template of its own
+            const std::size_t empty = miner.Add("   ");
+            ASSERT_EQUALS_SIZE_T(empty, miner.Add(""));
+            ASSERT_EQUALS("", miner.GetTemplate(empty));
+            ASSERT_EQUALS_UINT64(2, miner.GetCount(empty));
+        }
+
+        void Routing(void)
+        {
+            // the third new first token goes to the wildcard child
+            simple_log_template_miner<> miner(0.5, 1, 3);
+            const std::size_t alpha = miner.Add("alpha started fine");
+            const std::size_t beta  = miner.Add("beta started fine");
+            const std::size_t gamma = miner.Add("gamma started fine");
+            const std::size_t delta = miner.Add("delta started fine");
+            ASSERT_EQUALS_BOOL(true, alpha != beta);
+            ASSERT_EQUALS_SIZE_T(gamma, delta);
+            ASSERT_EQUALS("<*> started fine", miner.GetTemplate(gamma));
+            ASSERT_EQUALS_SIZE_T(alpha, miner.Add("alpha started again"));
+            // tokens with digits are routed to the wildcard child as well
+            ASSERT_EQUALS_SIZE_T(gamma, miner.Add("42 started fine"));
+            // the root, the length node, alpha, beta and the wildcard
+            ASSERT_EQUALS_SIZE_T(5, miner.GetNumberOfNodes());
+        }
+
+        void Eviction(void)
+        {
+            simple_log_template_miner<> miner(0.5, 2, 100, 2);
+            const std::size_t first  = miner.Add("first kind of line");
+            const std::size_t second = miner.Add("second kind");
+            miner.Add("first kind of event");
+            // the least recently matched template is replaced, its nodes are removed
+            const std::size_t third = miner.Add("third");
+            ASSERT_EQUALS_SIZE_T(second, third);
+            ASSERT_EQUALS_SIZE_T(2, miner.GetNumberOfTemplates());
+            ASSERT_EQUALS_UINT64(1, miner.GetNumberOfEvictions());
+            ASSERT_EQUALS("third", miner.GetTemplate(third));
+            ASSERT_EQUALS("first kind of <*>", miner.GetTemplate(first));
+            ASSERT_EQUALS_SIZE_T(simple_log_template_miner<>::NPOS, miner.Match("second kind"));
+            // the root, two length nodes, first, kind and third
+            ASSERT_EQUALS_SIZE_T(6, miner.GetNumberOfNodes());
+
+            miner.Clear();
+            ASSERT_EQUALS_SIZE_T(0, miner.GetNumberOfTemplates());
+            ASSERT_EQUALS_SIZE_T(1, miner.GetNumberOfNodes());
+            ASSERT_EQUALS_SIZE_T(0, miner.Add("again"));
+        }
+
+        void Merge(void)
+        {
+            // only the first token routes, the second one differs without digits
+            simple_log_template_miner<CIsComma> lhs(0.4, 1);
+            simple_log_template_miner<CIsComma> rhs(0.4, 1);
+            const std::size_t user = lhs.Add("user,bob,logged in");
+            lhs.Add("user,eve,logged in");
+            rhs.Add("disk,full");
+            const std::size_t login = rhs.Add("user,max,logged in");
+            std::vector<std::size_t> mapping;
+            ASSERT_EQUALS_BOOL(false, lhs.Merge(lhs));
+            ASSERT_EQUALS_BOOL(true, lhs.Merge(rhs, &mapping));
+            ASSERT_EQUALS_SIZE_T(2, mapping.size());
+            ASSERT_EQUALS_SIZE_T(user, mapping[login]);
+            ASSERT_EQUALS_UINT64(3, lhs.GetCount(user));
+            ASSERT_EQUALS("user <*> logged in", lhs.GetTemplate(user));
+            ASSERT_EQUALS("disk full", lhs.GetTemplate(mapping[1 - login]));
+            ASSERT_EQUALS_UINT64(4, lhs.GetTotal());
+
+            // a template of rhs, which was evicted during the merge, has no mapping
+            simple_log_template_miner<> small(0.4, 2, 100, 1);
+            simple_log_template_miner<> many;
+            many.Add("one");
+            many.Add("two words");
+            ASSERT_EQUALS_BOOL(true, small.Merge(many, &mapping));
+            ASSERT_EQUALS_SIZE_T(simple_log_template_miner<>::NPOS, mapping[0]);
+            ASSERT_EQUALS("two words", small.GetTemplate(mapping[1]));
+        }
+};
+
+REGISTER_TEST(TestSimpleLogTemplate)
@@ -0,0 +1,130 @@
+// -------------------------------------------------
+/// A class to unit test simple_multi_file_reader
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <cstdio>
+
+#include "simple_multi_file_reader.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleMultiFileReader : public TestFixture
+{
+    public:
+
+        TestSimpleMultiFileReader(void) : TestFixture("TestSimpleMultiFileReader")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(IoUring)
+            TEST_CASE(Fallback)
+            TEST_CASE(SlowWorker)
+        }
+
+        static std::vector<std::string> WriteFiles(std::size_t &tokens)
+        {
+            std::vector<std::string> strFiles;
+            tokens = 0;
+            for(unsigned int ui = 0; ui < 40; ++ui)
+            {
+                const std::string strFileName("test_simple_multi_file_reader_" + std::to_string(ui) + ".txt");
+                std::ofstream ofs(strFileName.c_str(), std::ios::binary);
+                // the first file is empty
+                for(unsigned int uj = 0; uj < ui * 50; ++uj)
+                {
+                    ofs << "file" << ui << " token" << uj << "\n";
+                    tokens += 2;
+                }
+                strFiles.push_back(strFileName);
+            }
+            return strFiles;
+        }
+
+        static void RemoveFiles(const std::vector<std::string> &strFiles)
+        {
+            for(std::size_t ui = 0; ui < strFiles.size(); ++ui)
+            {
+                (void)remove(strFiles[ui].c_str());
+            }
+        }
+
+        void Check(simple_multi_file_reader &reader)
+        {
+            std::size_t expectedTokens = 0;
+            std::vector<std::string> strFiles(WriteFiles(expectedTokens));
+            strFiles.insert(strFiles.begin() + 5, "test_simple_multi_file_reader_missing.txt");
+
+            std::atomic<uint64_t> tokens(0);
+            std::mutex mutex;
+            std::vector<std::string> strFirstTokens(strFiles.size());
+            ASSERT_EQUALS_BOOL(false, reader.TokenizeFiles<CIsSpace>(strFiles, [&](std::size_t fileIndex, std::string_view token)
+            {
+                tokens.fetch_add(1, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> lock(mutex);
+                if(strFirstTokens[fileIndex].empty())
+                {
+                    strFirstTokens[fileIndex] = std::string(token);
+                }
+            }));
+            ASSERT_EQUALS_SIZE_T(1, reader.GetFailedFiles().size());
+            ASSERT_EQUALS_SIZE_T(5, reader.GetFailedFiles()[0]);
+            ASSERT_EQUALS_UINT64(expectedTokens, tokens.load());
+            ASSERT_EQUALS("file7", strFirstTokens[8]);
+            ASSERT_EQUALS_BOOL(true, reader.GetThroughput() > 0.0);
+            ASSERT_EQUALS_BOOL(true, reader.GetMaxQueueDepth() > 0);
+
+            strFiles.erase(strFiles.begin() + 5);
+            RemoveFiles(strFiles);
+        }
+
+        void IoUring(void)
+        {
+            simple_multi_file_reader reader(16, 2);
+            Check(reader);
+            // the result is the same, in case io_uring is not available
+            if(reader.UsedIoUring())
+            {
+                ASSERT_EQUALS_BOOL(true, reader.GetSyscallsSaved() > 0);
+                ASSERT_EQUALS_BOOL(true, reader.GetMaxQueueDepth() <= 16);
+            }
+        }
+
+        void Fallback(void)
+        {
+            simple_multi_file_reader reader(16, 3, false);
+            Check(reader);
+            ASSERT_EQUALS_BOOL(false, reader.UsedIoUring());
+            ASSERT_EQUALS_UINT64(0, reader.GetSyscallsSaved());
+        }
+
+        void SlowWorker(void)
+        {
+            std::size_t expectedTokens = 0;
+            const std::vector<std::string> strFiles(WriteFiles(expectedTokens));
+            simple_multi_file_reader reader(16, 1);
+            std::size_t files = 0;
+            ASSERT_EQUALS_BOOL(true, reader.ReadFiles(strFiles, [&files](std::size_t, std::string_view)
+            {
+                ++files;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }));
+            ASSERT_EQUALS_SIZE_T(strFiles.size(), files);
+            // the reading waits for the worker, instead of queueing every file
+            ASSERT_EQUALS_BOOL(true, reader.GetMaxQueuedFiles() <= 2);
+            RemoveFiles(strFiles);
+        }
+};
+
+REGISTER_TEST(TestSimpleMultiFileReader)
@@ -0,0 +1,144 @@
+// -------------------------------------------------
+/// A class to unit test simple_queue
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include "simple_queue.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleQueue : public TestFixture
+{
+    public:
+
+        TestSimpleQueue(void) : TestFixture("TestSimpleQueue")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Capacity)
+            TEST_CASE(SpscBounded)
+            TEST_CASE(SpscThreads)
+            TEST_CASE(MpmcBounded)
+            TEST_CASE(MpmcThreads)
+        }
+
+        void Capacity(void)
+        {
+            ASSERT_EQUALS_SIZE_T(2,  simple_queue_capacity(0));
+            ASSERT_EQUALS_SIZE_T(8,  simple_queue_capacity(5));
+            ASSERT_EQUALS_SIZE_T(64, simple_queue_capacity(64));
+        }
+
+        void SpscBounded(void)
+        {
+            simple_spsc_queue<int> queue(3);
+            ASSERT_EQUALS_SIZE_T(4, queue.Capacity());
+            for(int i = 0; i < 4; ++i)
+            {
+                ASSERT_EQUALS_BOOL(true, queue.TryPush(i));
+            }
+            ASSERT_EQUALS_BOOL(false, queue.TryPush(4));
+            ASSERT_EQUALS_SIZE_T(4, queue.Size());
+            int value = -1;
+            ASSERT_EQUALS_BOOL(true, queue.TryPop(value));
+            ASSERT_EQUALS(0, value);
+            ASSERT_EQUALS_BOOL(true, queue.TryPush(4));
+            for(int i = 1; i < 5; ++i)
+            {
+                queue.Pop(value);
+                ASSERT_EQUALS(i, value);
+            }
+            ASSERT_EQUALS_BOOL(false, queue.TryPop(value));
+        }
+
+        void SpscThreads(void)
+        {
+            simple_spsc_queue<uint64_t> queue(16);
+            const uint64_t count = 100000;
+            std::thread producer([&queue, count]()
+            {
+                for(uint64_t i = 1; i <= count; ++i)
+                {
+                    queue.Push(i);
+                }
+            });
+            // the order is kept
+            bool bOrdered = true;
+            uint64_t value = 0;
+            for(uint64_t i = 1; i <= count; ++i)
+            {
+                queue.Pop(value);
+                bOrdered = bOrdered && (value == i);
+            }
+            producer.join();
+            ASSERT_EQUALS_BOOL(true, bOrdered);
+            ASSERT_EQUALS_SIZE_T(0, queue.Size());
+        }
+
+        void MpmcBounded(void)
+        {
+            simple_mpmc_queue<int> queue(2);
+            ASSERT_EQUALS_BOOL(true,  queue.TryPush(1));
+            ASSERT_EQUALS_BOOL(true,  queue.TryPush(2));
+            ASSERT_EQUALS_BOOL(false, queue.TryPush(3));
+            int value = 0;
+            ASSERT_EQUALS_BOOL(true, queue.TryPop(value));
+            ASSERT_EQUALS(1, value);
+            ASSERT_EQUALS_BOOL(true, queue.TryPush(3));
+            ASSERT_EQUALS_BOOL(true, queue.TryPop(value));
+            ASSERT_EQUALS(2, value);
+            ASSERT_EQUALS_BOOL(true, queue.TryPop(value));
+            ASSERT_EQUALS(3, value);
+            ASSERT_EQUALS_BOOL(false, queue.TryPop(value));
+        }
+
+        void MpmcThreads(void)
+        {
+            simple_mpmc_queue<uint64_t> queue(8);
+            const uint64_t count = 20000;
+            const unsigned int producers = 3;
+            const unsigned int consumers = 3;
+            std::atomic<uint64_t> sum(0);
+            std::atomic<uint64_t> popped(0);
+            std::vector<std::thread> threads;
+            for(unsigned int t = 0; t < producers; ++t)
+            {
+                threads.push_back(std::thread([&queue, count]()
+                {
+                    for(uint64_t i = 1; i <= count; ++i)
+                    {
+                        queue.Push(i);
+                    }
+                }));
+            }
+            for(unsigned int t = 0; t < consumers; ++t)
+            {
+                threads.push_back(std::thread([&queue, &sum, &popped, count]()
+                {
+                    uint64_t value = 0;
+                    while(popped.fetch_add(1) < producers * count)
+                    {
+                        queue.Pop(value);
+                        sum += value;
+                    }
+                }));
+            }
+            for(std::size_t ui = 0; ui < threads.size(); ++ui)
+            {
+                threads[ui].join();
+            }
+            // every item is popped exactly once
+            ASSERT_EQUALS_UINT64(producers * count * (count + 1) / 2, sum.load());
+            ASSERT_EQUALS_SIZE_T(0, queue.Size());
+        }
+};
+
+REGISTER_TEST(TestSimpleQueue)
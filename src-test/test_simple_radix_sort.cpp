@@ -0,0 +1,122 @@
+// -------------------------------------------------
+/// A class to unit test simple_radix_sort
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "simple_radix_sort.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleRadixSort : public TestFixture
+{
+    public:
+
+        TestSimpleRadixSort(void) : TestFixture("TestSimpleRadixSort")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(SortedUniqueTokens)
+            TEST_CASE(SortUnique)
+            TEST_CASE(CompareWithStdSort)
+            TEST_CASE(DeepPrefixes)
+        }
+
+        void SortedUniqueTokens(void)
+        {
+            std::vector<std::string_view> vocabulary;
+            simple_radix_sort::SortedUniqueTokens(vocabulary, "to be or not to be");
+            ASSERT_EQUALS_SIZE_T(4, vocabulary.size());
+            ASSERT_EQUALS("be",  std::string(vocabulary[0]));
+            ASSERT_EQUALS("not", std::string(vocabulary[1]));
+            ASSERT_EQUALS("or",  std::string(vocabulary[2]));
+            ASSERT_EQUALS("to",  std::string(vocabulary[3]));
+
+            std::vector<std::string> strResult;
+            simple_radix_sort::SortedUniqueTokens<CIsComma>(strResult, "b,a,,b,a");
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS("a", strResult[0]);
+            ASSERT_EQUALS("b", strResult[1]);
+
+            simple_radix_sort::SortedUniqueTokens(strResult, "  ");
+            ASSERT_EQUALS_SIZE_T(0, strResult.size());
+        }
+
+        void SortUnique(void)
+        {
+            // more tokens than the insertion sort cutoff, with prefixes, a common prefix and bytes above 127
+            std::vector<std::string> strTokens;
+            for(unsigned int ui = 0; ui < 200; ++ui)
+            {
+                strTokens.push_back("key" + std::string(ui % 7, 'x'));
+                strTokens.push_back("key");
+                strTokens.push_back(std::string("key\xff") + std::to_string(ui % 50));
+            }
+            simple_radix_sort::SortUnique(strTokens);
+            ASSERT_EQUALS_SIZE_T(57, strTokens.size());
+            ASSERT_EQUALS("key",  strTokens[0]);
+            ASSERT_EQUALS("keyx", strTokens[1]);
+            ASSERT_EQUALS(std::string("key\xff") + "0", strTokens[7]);
+            ASSERT_EQUALS(std::string("key\xff") + "9", strTokens[56]);
+
+            std::vector<std::string_view> empty;
+            simple_radix_sort::SortUnique(empty);
+            ASSERT_EQUALS_SIZE_T(0, empty.size());
+        }
+
+        void CompareWithStdSort(void)
+        {
+            // pseudo random tokens of a small alphabet, to have many duplicates
+            std::vector<std::string> strTokens;
+            unsigned int seed = 12345;
+            for(unsigned int ui = 0; ui < 20000; ++ui)
+            {
+                seed = seed * 1103515245U + 12345U;
+                const std::size_t length = (seed >> 16) % 6;
+                std::string strToken;
+                for(std::size_t uj = 0; uj < length; ++uj)
+                {
+                    seed = seed * 1103515245U + 12345U;
+                    strToken.push_back(static_cast<char>('a' + (seed >> 16) % 4));
+                }
+                strTokens.push_back(strToken);
+            }
+            std::vector<std::string_view> tokens(strTokens.begin(), strTokens.end());
+            std::vector<std::string_view> expected(tokens);
+            std::sort(expected.begin(), expected.end());
+            expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+            simple_radix_sort::SortUnique(tokens);
+            ASSERT_EQUALS_SIZE_T(expected.size(), tokens.size());
+            ASSERT_EQUALS_BOOL(true, expected == tokens);
+        }
+
+        void DeepPrefixes(void)
+        {
+            // nested prefixes "a", "aa", "aaa", ... need one level per byte, twice and in descending order
+            std::vector<std::string> strTokens;
+            for(std::size_t ui = 5000; ui > 0; --ui)
+            {
+                strTokens.push_back(std::string(ui, 'a'));
+                strTokens.push_back(std::string(ui, 'a') + "b");
+                strTokens.push_back(std::string(ui, 'a'));
+            }
+            std::vector<std::string_view> tokens(strTokens.begin(), strTokens.end());
+            simple_radix_sort::SortUnique(tokens);
+            ASSERT_EQUALS_SIZE_T(10000, tokens.size());
+            ASSERT_EQUALS("a",  std::string(tokens[0]));
+            ASSERT_EQUALS("aa", std::string(tokens[1]));
+            ASSERT_EQUALS(std::string(5000, 'a'), std::string(tokens[4999]));
+            ASSERT_EQUALS(std::string(5000, 'a') + "b", std::string(tokens[5000]));
+            ASSERT_EQUALS("ab", std::string(tokens[9999]));
+        }
+};
+
+REGISTER_TEST(TestSimpleRadixSort)
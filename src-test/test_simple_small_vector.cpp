@@ -0,0 +1,108 @@
+// -------------------------------------------------
+/// A class to unit test simple_small_vector
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <string_view>
+
+#include "simple_small_vector.hpp"
+#include "simple_tokenize.hpp"
+#include "simple_tokenize_regex.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleSmallVector : public TestFixture
+{
+    public:
+
+        TestSimpleSmallVector(void) : TestFixture("TestSimpleSmallVector")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(InlineAndSpill)
+            TEST_CASE(CopyAndMove)
+            TEST_CASE(Tokenize)
+        }
+
+        void InlineAndSpill(void)
+        {
+            simple_small_vector<std::string, 4> vec;
+            ASSERT_EQUALS_SIZE_T(4, vec.capacity());
+            for(int i = 0; i < 4; ++i)
+            {
+                vec.push_back(std::to_string(i));
+            }
+            ASSERT_EQUALS_BOOL(true, vec.is_inline());
+            // refers to an element, that is moved by the growth
+            vec.push_back(vec[0]);
+            ASSERT_EQUALS_BOOL(false, vec.is_inline());
+            ASSERT_EQUALS_SIZE_T(5, vec.size());
+            ASSERT_EQUALS("0", vec[4]);
+            ASSERT_EQUALS("3", vec[3]);
+            vec.pop_back();
+            ASSERT_EQUALS("3", vec.back());
+
+            // the capacity is kept
+            vec.clear();
+            ASSERT_EQUALS_BOOL(true, vec.empty());
+            ASSERT_EQUALS_SIZE_T(8, vec.capacity());
+        }
+
+        void CopyAndMove(void)
+        {
+            simple_small_vector<std::string, 2> small;
+            small.push_back("a long string, that does not fit into the small string buffer");
+            simple_small_vector<std::string, 2> copy(small);
+            ASSERT_EQUALS(small[0], copy[0]);
+
+            simple_small_vector<std::string, 2> moved(std::move(small));
+            ASSERT_EQUALS_SIZE_T(0, small.size());
+            ASSERT_EQUALS(copy[0], moved[0]);
+
+            simple_small_vector<std::string, 2> large;
+            for(int i = 0; i < 10; ++i)
+            {
+                large.emplace_back(3, static_cast<char>('a' + i));
+            }
+            moved = std::move(large);
+            ASSERT_EQUALS_SIZE_T(10, moved.size());
+            ASSERT_EQUALS_BOOL(false, moved.is_inline());
+            ASSERT_EQUALS_BOOL(true, large.is_inline());
+            ASSERT_EQUALS("jjj", moved[9]);
+
+            copy = moved;
+            ASSERT_EQUALS_SIZE_T(10, copy.size());
+            ASSERT_EQUALS("aaa", copy[0]);
+        }
+
+        void Tokenize(void)
+        {
+            const std::string line("GET /index.html HTTP/1.1");
+            simple_small_vector<std::string_view, 16> views;
+            simple_tokenize<>::Tokenize(views, line);
+            ASSERT_EQUALS_SIZE_T(3, views.size());
+            ASSERT_EQUALS_BOOL(true, views.is_inline());
+            ASSERT_EQUALS("/index.html", std::string(views[1]));
+
+            // long lines spill to the heap
+            std::string longLine;
+            for(int i = 0; i < 100; ++i)
+            {
+                longLine += std::to_string(i) + ",";
+            }
+            simple_small_vector<std::string, 16> strings;
+            simple_tokenize<CIsComma>::Tokenize(strings, longLine);
+            ASSERT_EQUALS_SIZE_T(100, strings.size());
+            ASSERT_EQUALS("99", strings[99]);
+
+            simple_tokenize<CIsRegex>::Tokenize(views, "a , b;c", CIsRegex(" *[,;] *"));
+            ASSERT_EQUALS_SIZE_T(3, views.size());
+            ASSERT_EQUALS("c", std::string(views[2]));
+        }
+};
+
+REGISTER_TEST(TestSimpleSmallVector)
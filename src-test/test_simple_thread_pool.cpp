@@ -0,0 +1,202 @@
+// -------------------------------------------------
+/// A class to unit test simple_thread_pool
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include "simple_thread_pool.hpp"
+#include "simple_tokenize_parallel.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleThreadPool : public TestFixture
+{
+    public:
+
+        TestSimpleThreadPool(void) : TestFixture("TestSimpleThreadPool")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Deque)
+            TEST_CASE(DequeThreads)
+            TEST_CASE(ParallelFor)
+            TEST_CASE(Exceptions)
+            TEST_CASE(TokenizeVector)
+        }
+
+        void Deque(void)
+        {
+            // the owner takes the newest item, a thief the oldest one, the array grows beyond 2 items
+            simple_work_stealing_deque<int> deque(2);
+            std::vector<int> items(100);
+            for(std::size_t ui = 0; ui < items.size(); ++ui)
+            {
+                items[ui] = static_cast<int>(ui);
+                deque.Push(&items[ui]);
+            }
+            ASSERT_EQUALS_SIZE_T(100, deque.Size());
+            ASSERT_EQUALS_INT(99, *deque.Pop());
+            ASSERT_EQUALS_INT(0,  *deque.Steal());
+            ASSERT_EQUALS_INT(1,  *deque.Steal());
+            ASSERT_EQUALS_SIZE_T(97, deque.Size());
+            while(deque.Pop() != NULL)
+            {}
+            ASSERT_EQUALS_SIZE_T(0, deque.Size());
+            ASSERT_EQUALS_BOOL(true, deque.Steal() == NULL);
+        }
+
+        void DequeThreads(void)
+        {
+            // every item is taken exactly once, either by the owner or by one of the thieves
+            const int count = 100000;
+            std::vector<int> items(count, 1);
+            simple_work_stealing_deque<int> deque(16);
+            std::atomic<bool> done(false);
+            std::atomic<int64_t> taken(0);
+            std::vector<std::thread> thieves;
+            for(int i = 0; i < 3; ++i)
+            {
+                thieves.push_back(std::thread([&]
+                {
+                    int64_t sum = 0;
+                    while(!done.load())
+                    {
+                        int *pItem = deque.Steal();
+                        if(pItem != NULL)
+                        {
+                            sum += *pItem;
+                            *pItem = 0;
+                        }
+                    }
+                    taken += sum;
+                }));
+            }
+            int64_t sum = 0;
+            for(int i = 0; i < count; ++i)
+            {
+                deque.Push(&items[static_cast<std::size_t>(i)]);
+                if(i % 3 == 0)
+                {
+                    int *pItem = deque.Pop();
+                    if(pItem != NULL)
+                    {
+                        sum += *pItem;
+                        *pItem = 0;
+                    }
+                }
+            }
+            int *pItem = NULL;
+            while((pItem = deque.Pop()) != NULL)
+            {
+                sum += *pItem;
+                *pItem = 0;
+            }
+            done = true;
+            for(std::size_t ui = 0; ui < thieves.size(); ++ui)
+            {
+                thieves[ui].join();
+            }
+            ASSERT_EQUALS_INT64(count, sum + taken.load());
+        }
+
+        void ParallelFor(void)
+        {
+            for(std::size_t threads = 1; threads <= 4; threads += 3)
+            {
+                simple_thread_pool pool(threads);
+                ASSERT_EQUALS_SIZE_T(threads, pool.GetNumberOfThreads());
+                std::vector<uint64_t> squares(10000, 0);
+                pool.ParallelFor(0, squares.size(), [&squares](std::size_t ui)
+                {
+                    squares[ui] += static_cast<uint64_t>(ui) * ui;
+                });
+                uint64_t sum = 0;
+                for(std::size_t ui = 0; ui < squares.size(); ++ui)
+                {
+                    sum += squares[ui];
+                }
+                ASSERT_EQUALS_UINT64(333283335000ULL, sum);
+
+                // nested loops and empty ranges
+                std::atomic<std::size_t> calls(0);
+                pool.ParallelFor(0, 50, [&pool, &calls](std::size_t)
+                {
+                    pool.ParallelFor(0, 40, [&calls](std::size_t)
+                    {
+                        ++calls;
+                    });
+                    pool.ParallelFor(7, 7, [&calls](std::size_t)
+                    {
+                        ++calls;
+                    });
+                });
+                ASSERT_EQUALS_SIZE_T(2000, calls.load());
+            }
+        }
+
+        void Exceptions(void)
+        {
+            simple_thread_pool pool(4);
+            simple_task_group group(pool);
+            std::atomic<int> done(0);
+            for(int i = 0; i < 20; ++i)
+            {
+                group.Run([&done, i]
+                {
+                    if(i == 5)
+                    {
+                        throw std::runtime_error("task 5");
+                    }
+                    ++done;
+                });
+            }
+            ASSERT_THROW(group.Wait(), std::runtime_error)
+            ASSERT_EQUALS_BOOL(false, group.IsFailed());
+            // the group is usable again
+            group.Run([&done]
+            {
+                ++done;
+            });
+            group.Wait();
+            ASSERT_EQUALS_BOOL(true, done.load() >= 1);
+
+            // the lambda is put in parentheses, because of the commas in the macro argument
+            ASSERT_THROW((pool.ParallelFor(0, 1000, [](std::size_t ui)
+            {
+                if(ui == 777)
+                {
+                    throw std::out_of_range("777");
+                }
+            })), std::out_of_range)
+        }
+
+        void TokenizeVector(void)
+        {
+            // the strings are tokenized by the shared pool, the order is kept
+            std::vector<std::string> strLines;
+            for(int i = 0; i < 1000; ++i)
+            {
+                strLines.push_back("line " + std::to_string(i) + " of  many");
+            }
+            const std::vector< std::vector<std::string> > strResult = simple_tokenize_parallel<>::Tokenize(strLines);
+            ASSERT_EQUALS_SIZE_T(1000, strResult.size());
+            ASSERT_EQUALS_SIZE_T(4, strResult[999].size());
+            ASSERT_EQUALS("999", strResult[999][1]);
+            ASSERT_EQUALS("many", strResult[0][3]);
+            ASSERT_EQUALS("512", strResult[512][1]);
+            ASSERT_EQUALS_SIZE_T(0, simple_tokenize_parallel<>::Tokenize(std::vector<std::string>()).size());
+            // the sequential version gives the same result
+            ASSERT_EQUALS_BOOL(true, simple_tokenize<>::Tokenize(strLines) == strResult);
+        }
+};
+
+REGISTER_TEST(TestSimpleThreadPool)
@@ -0,0 +1,130 @@
+// -------------------------------------------------
+/// A class to unit test simple_token_cache_file
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+
+#include "simple_token_cache_file.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleTokenCacheFile : public TestFixture
+{
+    public:
+
+        TestSimpleTokenCacheFile(void) : TestFixture("TestSimpleTokenCacheFile")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Tokens)
+            TEST_CASE(Invalidation)
+        }
+
+        static void WriteFile(const std::string &strFileName, const std::string &strContent)
+        {
+            std::ofstream ofs(strFileName.c_str(), std::ios::binary);
+            ofs << strContent;
+        }
+
+        static void RemoveFiles(const std::string &strFileName)
+        {
+            (void)remove(strFileName.c_str());
+            (void)remove(simple_token_cache_file<>::GetCacheFileName(strFileName).c_str());
+        }
+
+        void Tokens(void)
+        {
+            const std::string strFileName("test_simple_token_cache_file_tokens.txt");
+            const std::string strLong(300, 'y');
+            WriteFile(strFileName, "a,bb,,ccc\n\n," + strLong + ",z\nlast");
+
+            simple_token_cache_file<CIsComma> cache;
+            ASSERT_EQUALS_BOOL(true, cache.Open(strFileName));
+            ASSERT_EQUALS_BOOL(true, cache.WasCacheBuilt());
+            ASSERT_EQUALS_SIZE_T(4, cache.GetNumberOfRecords());
+            ASSERT_EQUALS_UINT64(6, cache.GetNumberOfTokens());
+            ASSERT_EQUALS_SIZE_T(0, cache.GetNumberOfTokens(1));
+
+            std::vector<std::string_view> tokens;
+            cache.Tokenize(tokens, 0);
+            ASSERT_EQUALS_SIZE_T(3, tokens.size());
+            ASSERT_EQUALS("bb",  std::string(tokens[1]));
+            ASSERT_EQUALS("ccc", std::string(tokens[2]));
+            // a token, whose length needs two varint bytes
+            cache.Tokenize(tokens, 2);
+            ASSERT_EQUALS_SIZE_T(2, tokens.size());
+            ASSERT_EQUALS(strLong, std::string(tokens[0]));
+            ASSERT_EQUALS("z",     std::string(tokens[1]));
+            cache.Tokenize(tokens, 3);
+            ASSERT_EQUALS("last",  std::string(tokens[0]));
+
+            // the second run reads the cache
+            simple_token_cache_file<CIsComma> again;
+            ASSERT_EQUALS_BOOL(true,  again.Open(strFileName));
+            ASSERT_EQUALS_BOOL(false, again.WasCacheBuilt());
+            again.Tokenize(tokens, 2);
+            ASSERT_EQUALS("z", std::string(tokens[1]));
+
+            cache.Close();
+            again.Close();
+            RemoveFiles(strFileName);
+        }
+
+        void Invalidation(void)
+        {
+            const std::string strFileName("test_simple_token_cache_file_invalidation.txt");
+            WriteFile(strFileName, "one two\nthree");
+            {
+                simple_token_cache_file<> cache;
+                ASSERT_EQUALS_BOOL(true, cache.Open(strFileName));
+                ASSERT_EQUALS_BOOL(true, cache.WasCacheBuilt());
+            }
+
+            // an other tokenizer
+            {
+                simple_token_cache_file<CIsComma> cache;
+                ASSERT_EQUALS_BOOL(true, cache.Open(strFileName));
+                ASSERT_EQUALS_BOOL(true, cache.WasCacheBuilt());
+                ASSERT_EQUALS_UINT64(2, cache.GetNumberOfTokens());
+            }
+
+            // a changed input of the same size
+            WriteFile(strFileName, "one two\nfour!");
+            {
+                simple_token_cache_file<CIsComma> cache;
+                ASSERT_EQUALS_BOOL(true, cache.Open(strFileName));
+                ASSERT_EQUALS_BOOL(true, cache.WasCacheBuilt());
+                std::vector<std::string_view> tokens;
+                cache.Tokenize(tokens, 1);
+                ASSERT_EQUALS("four!", std::string(tokens[0]));
+            }
+
+            // a damaged cache is detected by its checksum
+            {
+                std::fstream fs(simple_token_cache_file<>::GetCacheFileName(strFileName).c_str(), std::ios::binary | std::ios::in | std::ios::out);
+                fs.seekp(-1, std::ios::end);
+                fs.put('X');
+            }
+            {
+                simple_token_cache_file<CIsComma> cache;
+                ASSERT_EQUALS_BOOL(true, cache.Open(strFileName));
+                ASSERT_EQUALS_BOOL(true, cache.WasCacheBuilt());
+                ASSERT_EQUALS_BOOL(true, cache.Open(strFileName));
+                ASSERT_EQUALS_BOOL(false, cache.WasCacheBuilt());
+            }
+
+            simple_token_cache_file<> missing;
+            ASSERT_EQUALS_BOOL(false, missing.Open("test_simple_token_cache_file_missing.txt"));
+            RemoveFiles(strFileName);
+        }
+};
+
+REGISTER_TEST(TestSimpleTokenCacheFile)
@@ -0,0 +1,124 @@
+// -------------------------------------------------
+/// A class to unit test simple_token_frequency
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "simple_token_frequency.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleTokenFrequency : public TestFixture
+{
+    public:
+
+        TestSimpleTokenFrequency(void) : TestFixture("TestSimpleTokenFrequency")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Dimensions)
+            TEST_CASE(Estimates)
+            TEST_CASE(HeavyHitters)
+            TEST_CASE(Merge)
+        }
+
+        void Dimensions(void)
+        {
+            simple_token_frequency<> frequency(0.01, 0.01, 5);
+            // e / 0.01 = 272 is rounded up to 512, ln(100) = 4.6 to 5
+            ASSERT_EQUALS_SIZE_T(512, frequency.GetWidth());
+            ASSERT_EQUALS_SIZE_T(5,   frequency.GetDepth());
+            ASSERT_EQUALS_SIZE_T(5,   frequency.GetCapacity());
+            ASSERT_EQUALS_SIZE_T(512 * 5 * sizeof(uint64_t), frequency.GetSketchSize());
+        }
+
+        void Estimates(void)
+        {
+            simple_token_frequency<CIsComma> frequency;
+            frequency.AddTokens("a,b,,a");
+            frequency.AddTokens("c,a");
+            frequency.Add("b", 10);
+            ASSERT_EQUALS_UINT64(15, frequency.GetTotal());
+            ASSERT_EQUALS_UINT64(3,  frequency.Estimate("a"));
+            ASSERT_EQUALS_UINT64(11, frequency.Estimate("b"));
+            ASSERT_EQUALS_UINT64(1,  frequency.Estimate("c"));
+            ASSERT_EQUALS_UINT64(0,  frequency.Estimate("d"));
+
+            std::vector< std::pair<std::string, uint64_t> > top;
+            frequency.GetTopK(top);
+            ASSERT_EQUALS_SIZE_T(3, top.size());
+            ASSERT_EQUALS("b", top[0].first);
+            ASSERT_EQUALS("a", top[1].first);
+            ASSERT_EQUALS_UINT64(3, top[1].second);
+            ASSERT_EQUALS("c", top[2].first);
+
+            frequency.Clear();
+            ASSERT_EQUALS_UINT64(0, frequency.GetTotal());
+            ASSERT_EQUALS_UINT64(0, frequency.Estimate("b"));
+            frequency.GetTopK(top);
+            ASSERT_EQUALS_SIZE_T(0, top.size());
+        }
+
+        /// A small sketch: the estimates collide, but are never too low, and the
+        /// frequent tokens are found in a long tail of rare ones.
+        static void Feed(simple_token_frequency<> &roFrequency, int begin, int end)
+        {
+            for(int i = begin; i < end; ++i)
+            {
+                roFrequency.AddTokens("hot warm rare" + std::to_string(i));
+                if(i % 2 == 0)
+                {
+                    roFrequency.AddTokens("hot");
+                }
+            }
+        }
+
+        void HeavyHitters(void)
+        {
+            simple_token_frequency<> frequency(0.01, 0.01, 2);
+            Feed(frequency, 0, 2000);
+            ASSERT_EQUALS_UINT64(7000, frequency.GetTotal());
+            ASSERT_EQUALS_BOOL(true, frequency.Estimate("hot")  >= 3000);
+            ASSERT_EQUALS_BOOL(true, frequency.Estimate("hot")  <= 3000 + frequency.GetErrorBound());
+            ASSERT_EQUALS_BOOL(true, frequency.Estimate("warm") >= 2000);
+            ASSERT_EQUALS_BOOL(true, frequency.Estimate("rare7") >= 1);
+
+            std::vector< std::pair<std::string, uint64_t> > top;
+            frequency.GetTopK(top);
+            ASSERT_EQUALS_SIZE_T(2, top.size());
+            ASSERT_EQUALS("hot",  top[0].first);
+            ASSERT_EQUALS("warm", top[1].first);
+        }
+
+        void Merge(void)
+        {
+            simple_token_frequency<> first(0.01, 0.01, 2);
+            simple_token_frequency<> second(0.01, 0.01, 2);
+            simple_token_frequency<> whole(0.01, 0.01, 2);
+            Feed(first,  0, 1000);
+            Feed(second, 1000, 2000);
+            Feed(whole,  0, 2000);
+            ASSERT_EQUALS_BOOL(true, first.Merge(second));
+            ASSERT_EQUALS_UINT64(whole.GetTotal(), first.GetTotal());
+            ASSERT_EQUALS_BOOL(true, first.Estimate("hot") >= 3000);
+
+            std::vector< std::pair<std::string, uint64_t> > top;
+            first.GetTopK(top);
+            ASSERT_EQUALS_SIZE_T(2, top.size());
+            ASSERT_EQUALS("hot",  top[0].first);
+            ASSERT_EQUALS("warm", top[1].first);
+
+            simple_token_frequency<> other(0.1, 0.01, 2);
+            ASSERT_EQUALS_BOOL(false, first.Merge(other));
+            ASSERT_EQUALS_BOOL(false, first.Merge(first));
+        }
+};
+
+REGISTER_TEST(TestSimpleTokenFrequency)
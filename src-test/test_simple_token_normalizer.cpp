@@ -0,0 +1,96 @@
+// -------------------------------------------------
+/// A class to unit test simple_token_normalizer
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <vector>
+
+#include "simple_token_normalizer.hpp"
+#include "simple_tokenize.hpp"
+#include "simple_tokenizer.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleTokenNormalizer : public TestFixture
+{
+    public:
+
+        TestSimpleTokenNormalizer(void) : TestFixture("TestSimpleTokenNormalizer")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Lowercase)
+            TEST_CASE(StripPunctuation)
+            TEST_CASE(CollapseDigits)
+            TEST_CASE(TokenizeAndTransform)
+        }
+
+        void Lowercase(void)
+        {
+            const simple_token_normalizer normalizer;
+            std::string strResult;
+            ASSERT_EQUALS_BOOL(true, normalizer.Apply(strResult, "HeLLo"));
+            ASSERT_EQUALS("hello", strResult);
+            // longer than a SSE2 block, the bytes around A-Z and non ASCII bytes are kept
+            ASSERT_EQUALS_BOOL(true, normalizer.Apply(strResult, "@AZ[`az{ QUICK-Brown_FOX \xC3\x84XYZ"));
+            ASSERT_EQUALS("@az[`az{ quick-brown_fox \xC3\x84xyz", strResult);
+            ASSERT_EQUALS_BOOL(false, normalizer.Apply(strResult, ""));
+            ASSERT_EQUALS_SIZE_T(0, strResult.size());
+        }
+
+        void StripPunctuation(void)
+        {
+            const simple_token_normalizer normalizer(simple_token_normalizer::STRIP_PUNCTUATION);
+            std::string strResult;
+            ASSERT_EQUALS_BOOL(true, normalizer.Apply(strResult, "(\"Hello,\")"));
+            ASSERT_EQUALS("Hello", strResult);
+            ASSERT_EQUALS_BOOL(true, normalizer.Apply(strResult, "e-mail."));
+            ASSERT_EQUALS("e-mail", strResult);
+            ASSERT_EQUALS_BOOL(false, normalizer.Apply(strResult, "?!--"));
+
+            const simple_token_normalizer quotes(simple_token_normalizer::STRIP_PUNCTUATION | simple_token_normalizer::LOWERCASE, "'\"");
+            ASSERT_EQUALS_BOOL(true, quotes.Apply(strResult, "'Done.'"));
+            ASSERT_EQUALS("done.", strResult);
+        }
+
+        void CollapseDigits(void)
+        {
+            const simple_token_normalizer normalizer(simple_token_normalizer::COLLAPSE_DIGITS | simple_token_normalizer::LOWERCASE, "", '0');
+            std::string strResult;
+            ASSERT_EQUALS_BOOL(true, normalizer.Apply(strResult, "User1234"));
+            ASSERT_EQUALS("user0", strResult);
+            ASSERT_EQUALS_BOOL(true, normalizer.Apply(strResult, "10.0.0.255"));
+            ASSERT_EQUALS("0.0.0.0", strResult);
+            // a run of digits across a block boundary, a block without digits and a tail
+            ASSERT_EQUALS_BOOL(true, normalizer.Apply(strResult, "REQUEST-ID-12345678901234567890-ABCDEFGHIJKLMNOPQRS-99"));
+            ASSERT_EQUALS("request-id-0-abcdefghijklmnopqrs-0", strResult);
+        }
+
+        void TokenizeAndTransform(void)
+        {
+            const simple_token_normalizer normalizer(simple_token_normalizer::LOWERCASE
+                    | simple_token_normalizer::STRIP_PUNCTUATION
+                    | simple_token_normalizer::COLLAPSE_DIGITS);
+            std::vector<std::string> strResult(1, "stale");
+            normalizer.Tokenize(strResult, "Error: user42 (ID 7)! --");
+            ASSERT_EQUALS_SIZE_T(4, strResult.size());
+            ASSERT_EQUALS("error", strResult[0]);
+            ASSERT_EQUALS("user#", strResult[1]);
+            ASSERT_EQUALS("id",    strResult[2]);
+            ASSERT_EQUALS("#",     strResult[3]);
+
+            simple_tokenizer<CIsComma> tokenizer;
+            ASSERT_EQUALS_SIZE_T(3, tokenizer.TokenizeAndTransform("A,!!,B.,C", normalizer));
+            ASSERT_EQUALS("a", tokenizer[0]);
+            ASSERT_EQUALS("b", tokenizer[1]);
+            ASSERT_EQUALS("c", tokenizer[2]);
+            ASSERT_EQUALS_SIZE_T(1, tokenizer.TokenizeAndTransform("X", normalizer));
+            ASSERT_EQUALS("x", tokenizer[0]);
+        }
+};
+
+REGISTER_TEST(TestSimpleTokenNormalizer)
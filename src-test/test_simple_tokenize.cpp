@@ -0,0 +1,127 @@
+// -------------------------------------------------
+/// A class to unit test simple_tokenize
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <vector>
+
+#include "simple_tokenize.hpp"
+#include "simple_testsuite.hpp"
+
+// the tokenization of these strings is done by the compiler
+static constexpr std::string_view g_Route = "/api/v1//users/";
+static constexpr auto g_RouteTokens  = SIMPLE_TOKENIZE_CONSTEXPR_WITH(CIsFromChars, CIsFromChars("/"), g_Route);
+static constexpr auto g_ConfigTokens = SIMPLE_TOKENIZE_CONSTEXPR(CIsComma, "host,port,,user");
+
+static_assert(g_RouteTokens.size() == 3, "the route has three tokens");
+static_assert(g_RouteTokens[2] == "users", "the third token of the route is 'users'");
+static_assert(g_ConfigTokens.size() == 3, "empty tokens are skipped");
+static_assert(simple_tokenize<CIsSpace>::CountTokens(" \t a b\n") == 2, "CIsSpace is constexpr");
+
+class TestSimpleTokenize : public TestFixture
+{
+    public:
+
+        TestSimpleTokenize(void) : TestFixture("TestSimpleTokenize")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Tokenize)
+            TEST_CASE(ConstexprTokenize)
+            TEST_CASE(TokenizeFirstN)
+            TEST_CASE(TokenizeLastN)
+        }
+
+        void Tokenize(void)
+        {
+            std::vector<std::string> strResult(simple_tokenize<>::Tokenize("sum\tsum\ngoes   home\r   now!!!"));
+            ASSERT_EQUALS_SIZE_T(5, strResult.size());
+            ASSERT_EQUALS("sum",    strResult[0]);
+            ASSERT_EQUALS("goes",   strResult[2]);
+            ASSERT_EQUALS("now!!!", strResult[4]);
+
+            simple_tokenize<CIsComma>::Tokenize(strResult, ",a,,b,");
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS("a", strResult[0]);
+            ASSERT_EQUALS("b", strResult[1]);
+        }
+
+        void ConstexprTokenize(void)
+        {
+            ASSERT_EQUALS("api",   std::string(g_RouteTokens[0]));
+            ASSERT_EQUALS("v1",    std::string(g_RouteTokens[1]));
+            ASSERT_EQUALS("users", std::string(g_RouteTokens[2]));
+            ASSERT_EQUALS("user",  std::string(g_ConfigTokens[2]));
+
+            // surplus tokens are dropped, missing tokens are empty
+            constexpr auto first = simple_tokenize<CIsArithmetic>::Tokenize<2>("a+b-c");
+            ASSERT_EQUALS("b", std::string(first[1]));
+            constexpr auto padded = simple_tokenize<CIsAmpersand>::Tokenize<3>("x&y");
+            ASSERT_EQUALS_BOOL(true, padded[2].empty());
+
+            // the views can be used at runtime as well
+            const std::string line("k1 = v1");
+            std::size_t pos = 0;
+            ASSERT_EQUALS("k1", std::string(simple_tokenize<>::NextToken(line, pos)));
+            ASSERT_EQUALS("=",  std::string(simple_tokenize<>::NextToken(line, pos)));
+            ASSERT_EQUALS("v1", std::string(simple_tokenize<>::NextToken(line, pos)));
+            ASSERT_EQUALS_BOOL(true, simple_tokenize<>::NextToken(line, pos).empty());
+        }
+
+        void TokenizeFirstN(void)
+        {
+            std::vector<std::string> strResult;
+            simple_tokenize<>::TokenizeFirstN(strResult, "  GET /index.html  HTTP/1.1  extra ", 2);
+            ASSERT_EQUALS_SIZE_T(3, strResult.size());
+            ASSERT_EQUALS("GET",                 strResult[0]);
+            ASSERT_EQUALS("/index.html",         strResult[1]);
+            ASSERT_EQUALS("HTTP/1.1  extra ",    strResult[2]);
+
+            // no split at all returns the string without leading separators
+            simple_tokenize<CIsComma>::TokenizeFirstN(strResult, ",,a,b", 0);
+            ASSERT_EQUALS_SIZE_T(1, strResult.size());
+            ASSERT_EQUALS("a,b", strResult[0]);
+
+            // fewer tokens than requested
+            simple_tokenize<CIsComma>::TokenizeFirstN(strResult, "a,b,,", 5);
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS("b", strResult[1]);
+
+            simple_tokenize<CIsComma>::TokenizeFirstN(strResult, "a,b,", 2);
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+
+            simple_tokenize<>::TokenizeFirstN(strResult, "", 3);
+            ASSERT_EQUALS_SIZE_T(0, strResult.size());
+        }
+
+        void TokenizeLastN(void)
+        {
+            std::vector<std::string> strResult;
+            simple_tokenize<CIsComma>::TokenizeLastN(strResult, "a,b,c,d", 2);
+            ASSERT_EQUALS_SIZE_T(3, strResult.size());
+            ASSERT_EQUALS("a,b", strResult[0]);
+            ASSERT_EQUALS("c",   strResult[1]);
+            ASSERT_EQUALS("d",   strResult[2]);
+
+            simple_tokenize<>::TokenizeLastN(strResult, " x y\t z \n", 1);
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS(" x y", strResult[0]);
+            ASSERT_EQUALS("z",    strResult[1]);
+
+            // the tokens are the same as the ones of Tokenize
+            simple_tokenize<CIsComma>::TokenizeLastN(strResult, ",,a,,b,", 10);
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS("a", strResult[0]);
+            ASSERT_EQUALS("b", strResult[1]);
+
+            simple_tokenize<CIsComma>::TokenizeLastN(strResult, ",,,", 1);
+            ASSERT_EQUALS_SIZE_T(0, strResult.size());
+        }
+};
+
+REGISTER_TEST(TestSimpleTokenize)
@@ -0,0 +1,130 @@
+// -------------------------------------------------
+/// A class to unit test the memoizing front end of simple_tokenize
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <vector>
+#include <thread>
+
+#include "simple_tokenize_cache.hpp"
+#include "simple_tokenize_regex.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleTokenizeCache : public TestFixture
+{
+    public:
+
+        TestSimpleTokenizeCache(void) : TestFixture("TestSimpleTokenizeCache")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(HitsAndMisses)
+            TEST_CASE(ByteBudget)
+            TEST_CASE(Predicates)
+            TEST_CASE(Threads)
+        }
+
+        void HitsAndMisses(void)
+        {
+            simple_tokenize_cache<CIsComma> cache;
+            std::vector<std::string> strResult;
+            cache.Tokenize(strResult, "GET,/health,,200");
+            cache.Tokenize(strResult, "GET,/health,,200");
+            ASSERT_EQUALS_SIZE_T(3, strResult.size());
+            ASSERT_EQUALS("GET",     strResult[0]);
+            ASSERT_EQUALS("/health", strResult[1]);
+            ASSERT_EQUALS("200",     strResult[2]);
+            strResult = cache.Tokenize("POST,/login");
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS("/login", strResult[1]);
+            ASSERT_EQUALS_UINT64(1, cache.GetHits());
+            ASSERT_EQUALS_UINT64(2, cache.GetMisses());
+
+            // empty inputs are cached as well
+            cache.Tokenize(strResult, "");
+            cache.Tokenize(strResult, "");
+            ASSERT_EQUALS_SIZE_T(0, strResult.size());
+            ASSERT_EQUALS_UINT64(2, cache.GetHits());
+
+            cache.Clear();
+            ASSERT_EQUALS_SIZE_T(0, cache.GetBytes());
+            cache.Tokenize(strResult, "GET,/health,,200");
+            ASSERT_EQUALS_UINT64(4, cache.GetMisses());
+        }
+
+        void ByteBudget(void)
+        {
+            // a single shard, with room for a few entries only
+            simple_tokenize_cache<> cache(1024, 1);
+            std::vector<std::string> strResult;
+            for(int i = 0; i < 100; ++i)
+            {
+                cache.Tokenize(strResult, "heartbeat from node " + std::to_string(i));
+                ASSERT_EQUALS(std::to_string(i), strResult[3]);
+            }
+            ASSERT_EQUALS_BOOL(true, cache.GetBytes() <= cache.GetByteBudget());
+            ASSERT_EQUALS_BOOL(true, cache.GetEvictions() > 0);
+            ASSERT_EQUALS_UINT64(0, cache.GetHits());
+            // the most recent entry is still there
+            cache.Tokenize(strResult, "heartbeat from node 99");
+            ASSERT_EQUALS_UINT64(1, cache.GetHits());
+
+            // inputs larger than the budget are not cached
+            const std::string strLarge(2048, 'x');
+            cache.Tokenize(strResult, strLarge);
+            cache.Tokenize(strResult, strLarge);
+            ASSERT_EQUALS_UINT64(1, cache.GetHits());
+            ASSERT_EQUALS_SIZE_T(1, strResult.size());
+        }
+
+        void Predicates(void)
+        {
+            simple_tokenize_cache<CIsFromString> cache(4096, 4, CIsFromString("$"));
+            std::vector<std::string> strResult(cache.Tokenize("sum$sum$goes$home$now!!!"));
+            ASSERT_EQUALS_SIZE_T(5, strResult.size());
+            ASSERT_EQUALS("now!!!", strResult[4]);
+
+            simple_tokenize_cache<CIsRegex> regexCache(4096, 4, CIsRegex(" *; *"));
+            regexCache.Tokenize(strResult, "a ; b;c");
+            regexCache.Tokenize(strResult, "a ; b;c");
+            ASSERT_EQUALS_SIZE_T(3, strResult.size());
+            ASSERT_EQUALS("b", strResult[1]);
+            ASSERT_EQUALS_UINT64(1, regexCache.GetHits());
+        }
+
+        void Threads(void)
+        {
+            simple_tokenize_cache<> cache(64 * 1024, 8);
+            std::vector<std::thread> threads;
+            std::vector<int> errors(4, 0);
+            for(int t = 0; t < 4; ++t)
+            {
+                threads.push_back(std::thread([&cache, &errors, t]()
+                {
+                    std::vector<std::string> strResult;
+                    for(int i = 0; i < 2000; ++i)
+                    {
+                        cache.Tokenize(strResult, "msg id " + std::to_string(i % 50));
+                        if(strResult.size() != 3 || strResult[2] != std::to_string(i % 50))
+                        {
+                            ++errors[t];
+                        }
+                    }
+                }));
+            }
+            for(std::size_t t = 0; t < threads.size(); ++t)
+            {
+                threads[t].join();
+            }
+            ASSERT_EQUALS_INT(0, errors[0] + errors[1] + errors[2] + errors[3]);
+            ASSERT_EQUALS_UINT64(8000, cache.GetHits() + cache.GetMisses());
+            ASSERT_EQUALS_BOOL(true, cache.GetHits() >= 8000 - 4 * 50);
+        }
+};
+
+REGISTER_TEST(TestSimpleTokenizeCache)
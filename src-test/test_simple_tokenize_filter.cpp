@@ -0,0 +1,108 @@
+// -------------------------------------------------
+/// A class to unit test simple_tokenize_filter
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <vector>
+
+#include "simple_tokenize_filter.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleTokenizeFilter : public TestFixture
+{
+    public:
+
+        TestSimpleTokenizeFilter(void) : TestFixture("TestSimpleTokenizeFilter")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(FindSubstring)
+            TEST_CASE(SingleLiteral)
+            TEST_CASE(AllLiterals)
+            TEST_CASE(AnyLiteral)
+        }
+
+        void FindSubstring(void)
+        {
+            const std::string strHay("0123456789abcdefghijklmnopqrstuvwxyz-ERROR-0123456789abcdefghijERR");
+            const char *beg = strHay.data();
+            const char *end = beg + strHay.size();
+            ASSERT_EQUALS_SIZE_T(37, static_cast<std::size_t>(simple_simd::FindSubstring(beg, end, "ERROR", 5) - beg));
+            ASSERT_EQUALS_SIZE_T(63, static_cast<std::size_t>(simple_simd::FindSubstring(beg + 38, end, "ERR", 3) - beg));
+            ASSERT_EQUALS_BOOL(true, simple_simd::FindSubstring(beg, end, "ERRORS", 6) == end);
+            // the needle at the very end
+            ASSERT_EQUALS_BOOL(true, simple_simd::FindSubstring(beg + 40, end, "jERR", 4) == end - 4);
+            ASSERT_EQUALS_BOOL(true, simple_simd::FindSubstring(beg, end, "z", 1) == beg + 35);
+
+            // compare with std::string::find at every position
+            std::size_t mismatches = 0;
+            for(std::size_t ui = 0; ui < strHay.size(); ++ui)
+            {
+                const std::string strNeedle(strHay.substr(ui, 7));
+                const std::size_t expected = strHay.find(strNeedle);
+                const std::size_t found = static_cast<std::size_t>(simple_simd::FindSubstring(beg, end, strNeedle.data(), strNeedle.size()) - beg);
+                mismatches += (expected != found) ? 1 : 0;
+            }
+            ASSERT_EQUALS_SIZE_T(0, mismatches);
+        }
+
+        void SingleLiteral(void)
+        {
+            simple_tokenize_filter<> filter(std::vector<std::string>(1, "ERROR"));
+            std::vector<std::string> strResult;
+            ASSERT_EQUALS_BOOL(false, filter.Tokenize(strResult, "10:00 INFO started"));
+            ASSERT_EQUALS_SIZE_T(0, strResult.size());
+            ASSERT_EQUALS_BOOL(true, filter.Tokenize(strResult, "10:01 ERROR disk full"));
+            ASSERT_EQUALS_SIZE_T(4, strResult.size());
+            ASSERT_EQUALS("ERROR", strResult[1]);
+
+            ASSERT_EQUALS_UINT64(2,  filter.GetLinesSeen());
+            ASSERT_EQUALS_UINT64(1,  filter.GetLinesRejected());
+            ASSERT_EQUALS_UINT64(0,  filter.GetLinesRejectedByFingerprint());
+            ASSERT_EQUALS_UINT64(18, filter.GetBytesSkipped());
+        }
+
+        void AllLiterals(void)
+        {
+            std::vector<std::string> literals;
+            literals.push_back("ERROR");
+            literals.push_back("disk");
+            simple_tokenize_filter<CIsComma> filter(literals);
+            ASSERT_EQUALS_BOOL(true,  filter.Accept("ERROR,disk,full"));
+            ASSERT_EQUALS_BOOL(false, filter.Accept("ERROR,net,down"));
+            ASSERT_EQUALS_BOOL(false, filter.Accept("x"));
+            // a short line lacks the bigrams of the literals
+            ASSERT_EQUALS_BOOL(true, filter.GetLinesRejectedByFingerprint() >= 1);
+            ASSERT_EQUALS_UINT64(2, filter.GetLinesRejected());
+
+            // the result is the same without the fingerprint stage
+            filter.SetUseFingerprint(false);
+            ASSERT_EQUALS_BOOL(false, filter.Accept("ERROR,net,down"));
+            ASSERT_EQUALS_BOOL(true,  filter.Accept("disk,ERROR"));
+
+            // without literals every line is accepted
+            simple_tokenize_filter<> all((std::vector<std::string>()));
+            ASSERT_EQUALS_BOOL(true, all.Accept("anything"));
+        }
+
+        void AnyLiteral(void)
+        {
+            std::vector<std::string> literals;
+            literals.push_back("WARN");
+            literals.push_back("ERROR");
+            simple_tokenize_filter<> filter(literals, simple_tokenize_filter<>::MODE_ANY);
+            std::vector<std::string> strResult;
+            ASSERT_EQUALS_BOOL(true,  filter.Tokenize(strResult, "WARN low memory"));
+            ASSERT_EQUALS_BOOL(true,  filter.Tokenize(strResult, "ERROR out of memory"));
+            ASSERT_EQUALS_SIZE_T(4, strResult.size());
+            ASSERT_EQUALS_BOOL(false, filter.Tokenize(strResult, "INFO fine"));
+            ASSERT_EQUALS_UINT64(1, filter.GetLinesRejected());
+        }
+};
+
+REGISTER_TEST(TestSimpleTokenizeFilter)
@@ -0,0 +1,161 @@
+// -------------------------------------------------
+/// A class to unit test simple_tokenize_gzip
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+
+#include "simple_tokenize_gzip.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleTokenizeGzip : public TestFixture
+{
+    public:
+
+        TestSimpleTokenizeGzip(void) : TestFixture("TestSimpleTokenizeGzip")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(SmallBuffers)
+            TEST_CASE(Lines)
+            TEST_CASE(Errors)
+            TEST_CASE(ThrowingCallback)
+        }
+
+        static void WriteGzipFile(const std::string &strFileName, const std::string &strContent)
+        {
+            gzFile file = gzopen(strFileName.c_str(), "wb");
+            (void)gzwrite(file, strContent.data(), static_cast<unsigned int>(strContent.size()));
+            (void)gzclose(file);
+        }
+
+        static std::string Content(void)
+        {
+            std::string strContent;
+            for(unsigned int ui = 0; ui < 500; ++ui)
+            {
+                strContent += "token" + std::to_string(ui) + ((ui % 3 == 0) ? "  " : " ") + std::string(ui % 11, 'x') + "\n";
+            }
+            return strContent;
+        }
+
+        void SmallBuffers(void)
+        {
+            const std::string strFileName("test_simple_tokenize_gzip.txt.gz");
+            const std::string strContent(Content());
+            WriteGzipFile(strFileName, strContent);
+
+            // buffers of 7 bytes, so that many tokens cross a buffer
+            simple_tokenize_gzip<> reader(7, 3);
+            std::vector<std::string> strResult;
+            ASSERT_EQUALS_BOOL(true, reader.TokenizeFile(strFileName, [&strResult](std::string_view token)
+            {
+                strResult.push_back(std::string(token));
+            }));
+            ASSERT_EQUALS_BOOL(true, simple_tokenize<>::Tokenize(strContent) == strResult);
+            ASSERT_EQUALS_UINT64(strContent.size(), reader.GetBytes());
+            ASSERT_EQUALS_BOOL(true, reader.GetNumberOfCarriedTokens() > 100);
+            ASSERT_EQUALS_BOOL(true, reader.GetOverlap() >= 0.0 && reader.GetOverlap() <= 1.0);
+            (void)remove(strFileName.c_str());
+        }
+
+        void Lines(void)
+        {
+            // a file, that is not compressed, is read as it is
+            const std::string strFileName("test_simple_tokenize_gzip.txt");
+            {
+                std::ofstream ofs(strFileName.c_str(), std::ios::binary);
+                ofs << "first line\nsecond line\nlast";
+            }
+            simple_tokenize_gzip<CIsFromString> reader(4, 2, CIsFromString("\n"));
+            std::vector<std::string> strLines;
+            ASSERT_EQUALS_BOOL(true, reader.TokenizeFile(strFileName, [&strLines](std::string_view line)
+            {
+                strLines.push_back(std::string(line));
+            }));
+            ASSERT_EQUALS_SIZE_T(3, strLines.size());
+            ASSERT_EQUALS("second line", strLines[1]);
+            ASSERT_EQUALS("last",        strLines[2]);
+            (void)remove(strFileName.c_str());
+        }
+
+        void Errors(void)
+        {
+            simple_tokenize_gzip<> reader;
+            std::size_t tokens = 0;
+            ASSERT_EQUALS_BOOL(false, reader.TokenizeFile("test_simple_tokenize_gzip_missing.gz", [&tokens](std::string_view)
+            {
+                ++tokens;
+            }));
+            ASSERT_EQUALS_BOOL(false, reader.GetError().empty());
+
+            // a truncated file
+            const std::string strFileName("test_simple_tokenize_gzip_truncated.gz");
+            WriteGzipFile(strFileName, Content());
+            std::string strCompressed;
+            {
+                std::ifstream ifs(strFileName.c_str(), std::ios::binary);
+                strCompressed.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+            }
+            {
+                std::ofstream ofs(strFileName.c_str(), std::ios::binary);
+                ofs << strCompressed.substr(0, strCompressed.size() / 2);
+            }
+            ASSERT_EQUALS_BOOL(false, reader.TokenizeFile(strFileName, [&tokens](std::string_view)
+            {
+                ++tokens;
+            }));
+            ASSERT_EQUALS_BOOL(false, reader.GetError().empty());
+            (void)remove(strFileName.c_str());
+        }
+
+        void ThrowingCallback(void)
+        {
+            const std::string strFileName("test_simple_tokenize_gzip_throw.txt.gz");
+            WriteGzipFile(strFileName, Content());
+
+            // the decompression waits for a free buffer, while the callback throws
+            simple_tokenize_gzip<> reader(16, 2);
+            for(unsigned int ui = 0; ui < 2; ++ui)
+            {
+                std::size_t tokens = 0;
+                bool bThrown = false;
+                try
+                {
+                    (void)reader.TokenizeFile(strFileName, [&tokens](std::string_view)
+                    {
+                        if(++tokens == 10)
+                        {
+                            throw std::runtime_error("stop");
+                        }
+                    });
+                }
+                catch(const std::runtime_error &)
+                {
+                    bThrown = true;
+                }
+                ASSERT_EQUALS_BOOL(true, bThrown);
+                ASSERT_EQUALS_SIZE_T(10, tokens);
+            }
+
+            // the reader can be used again
+            std::size_t tokens = 0;
+            ASSERT_EQUALS_BOOL(true, reader.TokenizeFile(strFileName, [&tokens](std::string_view)
+            {
+                ++tokens;
+            }));
+            ASSERT_EQUALS_SIZE_T(simple_tokenize<>::Tokenize(Content()).size(), tokens);
+            (void)remove(strFileName.c_str());
+        }
+};
+
+REGISTER_TEST(TestSimpleTokenizeGzip)
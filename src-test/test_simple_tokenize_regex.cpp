@@ -0,0 +1,177 @@
+// -------------------------------------------------
+/// A class to unit test the regular expression separator of simple_tokenize
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <vector>
+
+#include "simple_tokenize_regex.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleTokenizeRegex : public TestFixture
+{
+    public:
+
+        TestSimpleTokenizeRegex(void) : TestFixture("TestSimpleTokenizeRegex")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Compile)
+            TEST_CASE(Tokenize)
+            TEST_CASE(LeftmostLongest)
+            TEST_CASE(Pathological)
+            TEST_CASE(Split)
+            TEST_CASE(Limits)
+        }
+
+        void Compile(void)
+        {
+            ASSERT_EQUALS_BOOL(true,  CIsRegex(" *[,;] *").IsValid());
+            ASSERT_EQUALS_BOOL(true,  CIsRegex("(ab|cd)+\\x2C?").IsValid());
+            ASSERT_EQUALS_BOOL(false, CIsRegex("").IsValid());
+            ASSERT_EQUALS_BOOL(false, CIsRegex("a*").IsValid());
+            ASSERT_EQUALS_BOOL(false, CIsRegex("(a").IsValid());
+            ASSERT_EQUALS_BOOL(false, CIsRegex("a)").IsValid());
+            ASSERT_EQUALS_BOOL(false, CIsRegex("[a").IsValid());
+            ASSERT_EQUALS_BOOL(false, CIsRegex("+a").IsValid());
+            ASSERT_EQUALS_BOOL(false, CIsRegex("[z-a]").IsValid());
+            ASSERT_EQUALS("expression matches the empty string", CIsRegex("x?").GetError());
+
+            // equivalent expressions result in the same minimal automaton
+            const CIsRegex separator1("(a|b)*abb");
+            const CIsRegex separator2("[ab]*abb");
+            ASSERT_EQUALS_SIZE_T(5, separator1.GetNumberOfStates());
+            ASSERT_EQUALS_SIZE_T(separator1.GetNumberOfStates(), separator2.GetNumberOfStates());
+            // 'a', 'b' and all other bytes
+            ASSERT_EQUALS_SIZE_T(3, separator1.GetNumberOfByteClasses());
+        }
+
+        void Tokenize(void)
+        {
+            std::vector<std::string> strResult;
+            simple_tokenize<CIsRegex>::Tokenize(strResult, "a , b;c ;d ;; e", CIsRegex(" *[,;] *"));
+            ASSERT_EQUALS_SIZE_T(5, strResult.size());
+            ASSERT_EQUALS("a", strResult[0]);
+            ASSERT_EQUALS("b", strResult[1]);
+            ASSERT_EQUALS("c", strResult[2]);
+            ASSERT_EQUALS("d", strResult[3]);
+            ASSERT_EQUALS("e", strResult[4]);
+
+            // the default separator are blanks, tabs are part of the tokens
+            strResult = simple_tokenize<CIsRegex>::Tokenize("  x\ty   z ");
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS("x\ty", strResult[0]);
+            ASSERT_EQUALS("z", strResult[1]);
+
+            // multi character separators
+            simple_tokenize<CIsRegex>::Tokenize(strResult, "key::value:::x", CIsRegex("::"));
+            ASSERT_EQUALS_SIZE_T(3, strResult.size());
+            ASSERT_EQUALS("key",   strResult[0]);
+            ASSERT_EQUALS("value", strResult[1]);
+            ASSERT_EQUALS(":x",    strResult[2]);
+
+            std::string strToken;
+            simple_tokenize<CIsRegex>::TokenizeAndGetNthToken(strToken, "GET\r\n/index\r\nHTTP", CIsRegex("\\r?\\n"), 1);
+            ASSERT_EQUALS("/index", strToken);
+
+            simple_tokenize<CIsRegex>::Tokenize(strResult, "", CIsRegex(","));
+            ASSERT_EQUALS_SIZE_T(0, strResult.size());
+        }
+
+        void LeftmostLongest(void)
+        {
+            const CIsRegex separator("ab|abcd|c");
+            const std::string str("xabcdy");
+            ASSERT_EQUALS_SIZE_T(4, separator.MatchLength(str.data() + 1, str.data() + str.size()));
+            ASSERT_EQUALS_SIZE_T(0, separator.MatchLength(str.data(), str.data() + str.size()));
+            std::vector<std::string> strResult;
+            simple_tokenize<CIsRegex>::Tokenize(strResult, str, separator);
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS("x", strResult[0]);
+            ASSERT_EQUALS("y", strResult[1]);
+        }
+
+        void Pathological(void)
+        {
+            // every 'a' is a separator, but each scan tries to find a 'b' at the end
+            const std::string str(20000, 'a');
+            std::vector<std::string> strResult;
+            simple_tokenize<CIsRegex>::Tokenize(strResult, str + "xa", CIsRegex("a|a+b"));
+            ASSERT_EQUALS_SIZE_T(1, strResult.size());
+            ASSERT_EQUALS("x", strResult[0]);
+            simple_tokenize<CIsRegex>::Tokenize(strResult, str + "bx", CIsRegex("a|a+b"));
+            ASSERT_EQUALS_SIZE_T(1, strResult.size());
+            ASSERT_EQUALS("x", strResult[0]);
+        }
+
+        void Split(void)
+        {
+            const CIsRegex separator(" *, *");
+            std::vector<std::string> strResult;
+            simple_tokenize<CIsRegex>::TokenizeFirstN(strResult, "a , b,c ,  d,e", 2, separator);
+            ASSERT_EQUALS_SIZE_T(3, strResult.size());
+            ASSERT_EQUALS("b",        strResult[1]);
+            ASSERT_EQUALS("c ,  d,e", strResult[2]);
+
+            simple_tokenize<CIsRegex>::TokenizeLastN(strResult, ", a , b,c ,  d,e , ", 2, separator);
+            ASSERT_EQUALS_SIZE_T(3, strResult.size());
+            ASSERT_EQUALS(", a , b,c", strResult[0]);
+            ASSERT_EQUALS("d",         strResult[1]);
+            ASSERT_EQUALS("e",         strResult[2]);
+            simple_tokenize<CIsRegex>::TokenizeLastN(strResult, "a , b", 5, separator);
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS("a", strResult[0]);
+
+            const std::string str("x ,, y");
+            std::size_t pos = 0;
+            ASSERT_EQUALS("x", std::string(simple_tokenize<CIsRegex>::NextToken(str, pos, separator)));
+            ASSERT_EQUALS("y", std::string(simple_tokenize<CIsRegex>::NextToken(str, pos, separator)));
+            ASSERT_EQUALS_SIZE_T(2, simple_tokenize<CIsRegex>::CountTokens(str, separator));
+        }
+
+        void Limits(void)
+        {
+            // the parser recurses once per group
+            const std::size_t depth = CIsRegex::MAX_DEPTH + 1;
+            const CIsRegex nested(std::string(depth, '(') + "a" + std::string(depth, ')'));
+            ASSERT_EQUALS_BOOL(false, nested.IsValid());
+            ASSERT_EQUALS_BOOL(true,  nested.GetError().find("nested too deeply") != std::string::npos);
+            ASSERT_EQUALS_BOOL(true,  CIsRegex(std::string(CIsRegex::MAX_DEPTH, '(') + "a" + std::string(CIsRegex::MAX_DEPTH, ')')).IsValid());
+
+            // a long expression is no deep syntax tree for the NFA construction
+            std::string strPattern("a");
+            for(unsigned int ui = 0; ui < 20000; ++ui)
+            {
+                strPattern += "|a";
+            }
+            ASSERT_EQUALS_BOOL(true, CIsRegex(strPattern).IsValid());
+
+            // the n-th byte from the end is an 'a': the DFA needs 2^n states
+            const CIsRegex exponential("[ab]*a[ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab][ab]");
+            ASSERT_EQUALS_BOOL(false, exponential.IsValid());
+            ASSERT_EQUALS("expression needs more than 10000 DFA states", exponential.GetError());
+            std::vector<std::string> strResult;
+            simple_tokenize<CIsRegex>::Tokenize(strResult, "ab ab", exponential);
+            ASSERT_EQUALS_SIZE_T(1, strResult.size());
+
+            // a separator, which is used inside of the callback of another scan
+            const CIsRegex outer("a|a+b");
+            const CIsRegex inner(",");
+            std::size_t innerTokens = 0;
+            simple_tokenize<CIsRegex>::ForEachToken(std::string(100, 'a') + "x,y" + std::string(100, 'a') + "z", [&](std::string_view token)
+            {
+                simple_tokenize<CIsRegex>::ForEachToken(token, [&innerTokens](std::string_view)
+                {
+                    ++innerTokens;
+                }, inner);
+            }, outer);
+            ASSERT_EQUALS_SIZE_T(3, innerTokens);
+        }
+};
+
+REGISTER_TEST(TestSimpleTokenizeRegex)
@@ -0,0 +1,221 @@
+// -------------------------------------------------
+/// A class to unit test simple_tokenize_stats
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+// The hooks in simple_tokenize are switched on for the whole build with 'make STATS=yes'.
+// The counters are checked in every build. They are process-global, so every case
+// compares them before and after and the fixture never runs in parallel to others.
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "simple_tokenize.hpp"
+#include "simple_tokenize_stats.hpp"
+#include "simple_testsuite.hpp"
+
+namespace
+{
+    class CIsSemicolon
+    {
+        public:
+            constexpr bool operator() (const char &c) const
+            {
+                return ';' == c;
+            }
+    };
+
+    /// \return <-- the counters, that were added between the snapshots before and after
+    simple_tokenize_counters Delta(const simple_tokenize_counters &roBefore, const simple_tokenize_counters &roAfter)
+    {
+        simple_tokenize_counters result;
+        result.calls        = roAfter.calls - roBefore.calls;
+        result.bytesScanned = roAfter.bytesScanned - roBefore.bytesScanned;
+        result.tokens       = roAfter.tokens - roBefore.tokens;
+        result.bytesCopied  = roAfter.bytesCopied - roBefore.bytesCopied;
+        result.allocations  = roAfter.allocations - roBefore.allocations;
+        result.nanoseconds  = roAfter.nanoseconds - roBefore.nanoseconds;
+        result.longestToken = roAfter.longestToken;
+        return result;
+    }
+}
+
+class TestSimpleTokenizeStats : public TestFixture
+{
+    public:
+
+        TestSimpleTokenizeStats(void) : TestFixture("TestSimpleTokenizeStats")
+        {
+            m_bSerial = true;
+        }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Counters)
+            TEST_CASE(Threads)
+            TEST_CASE(Prometheus)
+#ifdef SIMPLE_TOKENIZE_STATS
+            TEST_CASE(Tokenize)
+            TEST_CASE(Split)
+            TEST_CASE(TokenizeThreads)
+#else
+            TEST_CASE(Disabled)
+#endif
+        }
+
+        void Counters(void)
+        {
+            const simple_tokenize_counters before(simple_tokenize_stats::Snapshot());
+            {
+                const simple_tokenize_stats::CCall call(106);
+                simple_tokenize_stats::OnCopy(true, 1);
+                simple_tokenize_stats::OnCopy(false, 100);
+                simple_tokenize_stats::OnToken(2);
+            }
+            const simple_tokenize_counters counters(Delta(before, simple_tokenize_stats::Snapshot()));
+            ASSERT_EQUALS_UINT64(1,   counters.calls);
+            ASSERT_EQUALS_UINT64(106, counters.bytesScanned);
+            ASSERT_EQUALS_UINT64(3,   counters.tokens);
+            ASSERT_EQUALS_UINT64(101, counters.bytesCopied);
+            // the growing vector and the long token, that does not fit into the string
+            ASSERT_EQUALS_UINT64(2,   counters.allocations);
+            ASSERT_EQUALS_BOOL(true,  counters.longestToken >= 100);
+
+            simple_tokenize_stats::Reset();
+            ASSERT_EQUALS_UINT64(0, simple_tokenize_stats::Snapshot().calls);
+            ASSERT_EQUALS_UINT64(0, simple_tokenize_stats::Snapshot().longestToken);
+        }
+
+        void Threads(void)
+        {
+            const simple_tokenize_counters before(simple_tokenize_stats::Snapshot());
+            std::vector<std::thread> threads;
+            for(unsigned int ui = 0; ui < 4; ++ui)
+            {
+                threads.push_back(std::thread([]()
+                {
+                    for(unsigned int uj = 0; uj < 100; ++uj)
+                    {
+                        const simple_tokenize_stats::CCall call(3);
+                        simple_tokenize_stats::OnToken(1);
+                        simple_tokenize_stats::OnToken(1);
+                    }
+                }));
+            }
+            for(std::size_t ui = 0; ui < threads.size(); ++ui)
+            {
+                threads[ui].join();
+            }
+            // the counters of terminated threads are kept
+            const simple_tokenize_counters counters(Delta(before, simple_tokenize_stats::Snapshot()));
+            ASSERT_EQUALS_UINT64(400,  counters.calls);
+            ASSERT_EQUALS_UINT64(1200, counters.bytesScanned);
+            ASSERT_EQUALS_UINT64(800,  counters.tokens);
+        }
+
+        void Prometheus(void)
+        {
+            simple_tokenize_stats::Reset();
+            {
+                const simple_tokenize_stats::CCall call(3);
+                simple_tokenize_stats::OnToken(1);
+                simple_tokenize_stats::OnToken(1);
+            }
+            const std::string strText(simple_tokenize_stats::ToPrometheus("tok"));
+            ASSERT_EQUALS_BOOL(true, strText.find("# TYPE tok_calls_total counter\ntok_calls_total 1\n") != std::string::npos);
+            ASSERT_EQUALS_BOOL(true, strText.find("\ntok_tokens_total 2\n") != std::string::npos);
+            ASSERT_EQUALS_BOOL(true, strText.find("# TYPE tok_longest_token_bytes gauge\n") != std::string::npos);
+            ASSERT_EQUALS_BOOL(true, strText.find("\ntok_seconds_total ") != std::string::npos);
+        }
+
+#ifdef SIMPLE_TOKENIZE_STATS
+
+        void Tokenize(void)
+        {
+            simple_tokenize_counters before(simple_tokenize_stats::Snapshot());
+            std::vector<std::string> strResult;
+            const std::string strLong(100, 'x');
+            simple_tokenize<CIsSemicolon>::Tokenize(strResult, "a;;bc;" + strLong);
+            simple_tokenize_counters counters(Delta(before, simple_tokenize_stats::Snapshot()));
+            ASSERT_EQUALS_UINT64(1,   counters.calls);
+            ASSERT_EQUALS_UINT64(106, counters.bytesScanned);
+            ASSERT_EQUALS_UINT64(3,   counters.tokens);
+            ASSERT_EQUALS_UINT64(103, counters.bytesCopied);
+            ASSERT_EQUALS_BOOL(true,  counters.longestToken >= 100);
+            // the first token grows the vector, the long token does not fit into the string
+            ASSERT_EQUALS_BOOL(true, counters.allocations >= 2);
+
+            // views are not copied
+            before = simple_tokenize_stats::Snapshot();
+            std::size_t tokens = 0;
+            simple_tokenize<CIsSemicolon>::ForEachToken("x;y", [&tokens](std::string_view)
+            {
+                ++tokens;
+            });
+            counters = Delta(before, simple_tokenize_stats::Snapshot());
+            ASSERT_EQUALS_UINT64(1, counters.calls);
+            ASSERT_EQUALS_UINT64(2, counters.tokens);
+            ASSERT_EQUALS_UINT64(0, counters.bytesCopied);
+        }
+
+        void Split(void)
+        {
+            const simple_tokenize_counters before(simple_tokenize_stats::Snapshot());
+            std::vector<std::string> strResult;
+            simple_tokenize<CIsSemicolon>::TokenizeFirstN(strResult, "a;b;c;d", 2);
+            simple_tokenize<CIsSemicolon>::TokenizeLastN(strResult, "a;b;c;d", 1);
+            strResult.clear();
+            simple_tokenize<CIsSemicolon>::Tokenize(strResult, "a::bb::c", "::");
+            const simple_tokenize_counters counters(Delta(before, simple_tokenize_stats::Snapshot()));
+            ASSERT_EQUALS_UINT64(3,  counters.calls);
+            ASSERT_EQUALS_UINT64(22, counters.bytesScanned);
+            // "a", "b", "c;d" + "a;b;c", "d" + "a", "bb", "c"
+            ASSERT_EQUALS_UINT64(8,  counters.tokens);
+            ASSERT_EQUALS_UINT64(15, counters.bytesCopied);
+        }
+
+        void TokenizeThreads(void)
+        {
+            const simple_tokenize_counters before(simple_tokenize_stats::Snapshot());
+            std::vector<std::thread> threads;
+            for(unsigned int ui = 0; ui < 4; ++ui)
+            {
+                threads.push_back(std::thread([]()
+                {
+                    std::vector<std::string> strResult;
+                    for(unsigned int uj = 0; uj < 100; ++uj)
+                    {
+                        simple_tokenize<CIsSemicolon>::Tokenize(strResult, "a;b");
+                    }
+                }));
+            }
+            for(std::size_t ui = 0; ui < threads.size(); ++ui)
+            {
+                threads[ui].join();
+            }
+            const simple_tokenize_counters counters(Delta(before, simple_tokenize_stats::Snapshot()));
+            ASSERT_EQUALS_UINT64(400, counters.calls);
+            ASSERT_EQUALS_UINT64(800, counters.tokens);
+        }
+#else
+        void Disabled(void)
+        {
+            // the hooks expand to nothing, the tokenization does not count
+            const simple_tokenize_counters before(simple_tokenize_stats::Snapshot());
+            std::vector<std::string> strResult;
+            simple_tokenize<CIsSemicolon>::Tokenize(strResult, "a;b;c");
+            simple_tokenize<CIsSemicolon>::TokenizeFirstN(strResult, "a;b;c", 1);
+            ASSERT_EQUALS_SIZE_T(2, strResult.size());
+            ASSERT_EQUALS("b;c", strResult[1]);
+            const simple_tokenize_counters counters(Delta(before, simple_tokenize_stats::Snapshot()));
+            ASSERT_EQUALS_UINT64(0, counters.calls);
+            ASSERT_EQUALS_UINT64(0, counters.tokens);
+        }
+#endif
+};
+
+REGISTER_TEST(TestSimpleTokenizeStats)
@@ -0,0 +1,81 @@
+// -------------------------------------------------
+/// A class to unit test simple_tokenizer
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+
+#include <string>
+#include <vector>
+
+#include "simple_tokenizer.hpp"
+#include "simple_testsuite.hpp"
+
+class TestSimpleTokenizer : public TestFixture
+{
+    public:
+
+        TestSimpleTokenizer(void) : TestFixture("TestSimpleTokenizer")
+        { }
+
+    private:
+
+        void run(void)
+        {
+            TEST_CASE(Tokenize)
+            TEST_CASE(RecycleBuffers)
+            TEST_CASE(ThreadInstance)
+        }
+
+        void Tokenize(void)
+        {
+            simple_tokenizer<CIsFromString> tokenizer(CIsFromString("$"));
+            ASSERT_EQUALS_SIZE_T(5, tokenizer.Tokenize("sum$sum$goes$home$now!!!"));
+            ASSERT_EQUALS("goes", tokenizer[2]);
+            ASSERT_EQUALS_SIZE_T(2, tokenizer.Tokenize("$a$$b$"));
+            ASSERT_EQUALS_SIZE_T(2, tokenizer.size());
+            std::vector<std::string> tokens(tokenizer.GetTokens());
+            ASSERT_EQUALS_SIZE_T(2, tokens.size());
+            ASSERT_EQUALS("a", tokens[0]);
+            ASSERT_EQUALS("b", tokens[1]);
+            ASSERT_EQUALS_SIZE_T(0, tokenizer.Tokenize(""));
+            ASSERT_EQUALS_BOOL(true, tokenizer.begin() == tokenizer.end());
+        }
+
+        void RecycleBuffers(void)
+        {
+            simple_tokenizer<> tokenizer;
+            tokenizer.Tokenize("2026-10-19T10:00:00.000000Z host-0000000001 service-name-000001 request-accepted");
+            std::vector<const char *> buffers;
+            for(simple_tokenizer<>::const_iterator it = tokenizer.begin(); it != tokenizer.end(); ++it)
+            {
+                buffers.push_back(it->data());
+            }
+            // tokens of similar lines are written into the same memory
+            tokenizer.Tokenize("2026-10-19T10:00:01.000000Z host-0000000002 service-name-000002 request-rejected");
+            std::size_t reallocations = 0;
+            for(std::size_t ui = 0; ui < tokenizer.size(); ++ui)
+            {
+                reallocations += (tokenizer[ui].data() != buffers[ui]) ? 1 : 0;
+            }
+            ASSERT_EQUALS_SIZE_T(0, reallocations);
+            ASSERT_EQUALS("request-rejected", tokenizer[3]);
+
+            // a shorter line keeps the memory of the surplus tokens
+            tokenizer.Tokenize("short line");
+            tokenizer.Tokenize("2026-10-19T10:00:02.000000Z host-0000000003 service-name-000003 request-accepted");
+            ASSERT_EQUALS_BOOL(true, tokenizer[3].data() == buffers[3]);
+
+            tokenizer.ShrinkToFit();
+            ASSERT_EQUALS_SIZE_T(0, tokenizer.size());
+        }
+
+        void ThreadInstance(void)
+        {
+            simple_tokenizer<CIsComma> &tokenizer = simple_tokenizer<CIsComma>::GetThreadInstance();
+            tokenizer.Tokenize("a,b");
+            ASSERT_EQUALS_BOOL(true, &tokenizer == &simple_tokenizer<CIsComma>::GetThreadInstance());
+            ASSERT_EQUALS("b", simple_tokenizer<CIsComma>::GetThreadInstance()[1]);
+        }
+};
+
+REGISTER_TEST(TestSimpleTokenizer)
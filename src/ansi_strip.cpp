@@ -0,0 +1,248 @@
+// -------------------------------------------------
+/// Remove the escape sequences (e.g. colours) from captured terminal output,
+/// like sed 's/\x1b\[[0-9;]*m//g', but for every sequence type and at the
+/// speed of memchr.
+///
+/// usage: ansi_strip [-w | -s] [file ...]
+///
+///  - without option: print the text without the escape sequences
+///  - -w:             print the display width of every line in front of it,
+///                    separated by a tab
+///  - -s:             print the sequences instead of the text, one per line:
+///                    the line number, the type and the sequence, e.g. "3 CSI 22;31m"
+///  - files:          without a file or with -, the standard input is read
+///
+/// The input is read in blocks, a sequence may be cut by a block boundary.
+/// A string sequence (e.g. a window title) without terminator ends at the end
+/// of its line. A file, that ends within a sequence, is reported on stderr.
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "simple_ansi_escape.hpp"
+#include "simple_simd.hpp"
+
+enum EMode
+{
+    STRIP,
+    WIDTH,
+    SEQUENCES
+};
+
+static bool WriteAll(const std::string &strOutput)
+{
+    const char *p = strOutput.data();
+    std::size_t size = strOutput.size();
+    while(size > 0)
+    {
+        const ssize_t written = write(STDOUT_FILENO, p, size);
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        p    += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+/// Append a sequence in a readable form, e.g. "CSI ?25h" or "ESC (B".
+static void AppendSequence(std::string &roOutput, const simple_ansi_sequence &roSequence)
+{
+    switch(roSequence.type)
+    {
+        case simple_ansi_sequence::CSI:
+        {
+            roOutput += "CSI ";
+            if(roSequence.prefix != 0)
+            {
+                roOutput += roSequence.prefix;
+            }
+            for(unsigned int ui = 0; ui < roSequence.count; ++ui)
+            {
+                if(ui > 0)
+                {
+                    roOutput += ';';
+                }
+                if(roSequence.params[ui] >= 0)
+                {
+                    roOutput += std::to_string(roSequence.params[ui]);
+                }
+            }
+            break;
+        }
+        case simple_ansi_sequence::ESCAPE:
+        {
+            roOutput += "ESC ";
+            break;
+        }
+        case simple_ansi_sequence::STRING:
+        {
+            roOutput += "STRING ";
+            break;
+        }
+    }
+    if(roSequence.intermediate != 0)
+    {
+        roOutput += roSequence.intermediate;
+    }
+    roOutput += roSequence.final;
+    roOutput += '\n';
+}
+
+/// Print the complete lines in roPending with their display width, the incomplete last line is kept.
+static void AppendWidths(std::string &roOutput, std::string &roPending, bool bEnd)
+{
+    const char *it  = roPending.data();
+    const char *end = it + roPending.size();
+    while(it != end)
+    {
+        const char *lineEnd = simple_simd::FindByte(it, end, '\n');
+        if(lineEnd == end && !bEnd)
+        {
+            break;
+        }
+        simple_display_width width;
+        width.Add(it, static_cast<std::size_t>(lineEnd - it));
+        roOutput += std::to_string(width.Get());
+        roOutput += '\t';
+        roOutput.append(it, static_cast<std::size_t>(lineEnd - it));
+        roOutput += '\n';
+        it = (lineEnd != end) ? lineEnd + 1 : end;
+    }
+    roPending.erase(0, static_cast<std::size_t>(it - roPending.data()));
+}
+
+static bool Process(int fd, const std::string &strName, EMode mode)
+{
+    const std::size_t blockSize = 1 << 20;
+    std::vector<char> block(blockSize);
+    std::string strOutput;
+    std::string strPending;
+    std::size_t line = 1;
+    simple_ansi_parser parser;
+    for(;;)
+    {
+        const ssize_t bytes = read(fd, block.data(), block.size());
+        if(bytes < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if(bytes < 0)
+        {
+            return false;
+        }
+        const std::string_view input(block.data(), static_cast<std::size_t>(bytes));
+        strOutput.clear();
+        switch(mode)
+        {
+            case STRIP:
+            {
+                parser.Strip(strOutput, input);
+                break;
+            }
+            case WIDTH:
+            {
+                parser.Strip(strPending, input);
+                AppendWidths(strOutput, strPending, bytes == 0);
+                break;
+            }
+            case SEQUENCES:
+            {
+                parser.Parse(input, [&line](const char *p, std::size_t size)
+                {
+                    line += simple_simd::CountByte(p, p + size, '\n');
+                }, [&strOutput, &line](const simple_ansi_sequence &roSequence)
+                {
+                    strOutput += std::to_string(line);
+                    strOutput += ' ';
+                    AppendSequence(strOutput, roSequence);
+                });
+                break;
+            }
+        }
+        if(!WriteAll(strOutput))
+        {
+            return false;
+        }
+        if(bytes == 0)
+        {
+            if(parser.IsInSequence())
+            {
+                std::cerr << "ansi_strip: " << strName << " ends within an escape sequence\n";
+            }
+            return true;
+        }
+    }
+}
+
+static int Usage(void)
+{
+    std::cerr << "usage: ansi_strip [-w | -s] [file ...]\n";
+    return 2;
+}
+
+int main(int argc, char *argv[])
+{
+    EMode mode = STRIP;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(strcmp(argv[i], "-w") == 0)
+        {
+            mode = WIDTH;
+        }
+        else if(strcmp(argv[i], "-s") == 0)
+        {
+            mode = SEQUENCES;
+        }
+        else if(argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            return Usage();
+        }
+        else
+        {
+            files.push_back(argv[i]);
+        }
+    }
+    if(files.empty())
+    {
+        files.push_back("-");
+    }
+
+    int result = 0;
+    for(std::size_t ui = 0; ui < files.size(); ++ui)
+    {
+        const int fd = (files[ui] == "-") ? STDIN_FILENO : open(files[ui].c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            std::cerr << "ansi_strip: cannot read " << files[ui] << "\n";
+            result = 1;
+            continue;
+        }
+        const bool bSuccess = Process(fd, files[ui], mode);
+        if(fd != STDIN_FILENO)
+        {
+            close(fd);
+        }
+        if(!bSuccess)
+        {
+            std::cerr << "ansi_strip: cannot process " << files[ui] << "\n";
+            return 1;
+        }
+    }
+    return result;
+}
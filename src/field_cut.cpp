@@ -0,0 +1,561 @@
+// -------------------------------------------------
+/// Print selected fields of every line, like cut -f or awk '{print $3}'.
+///
+/// usage: field_cut -f list [-d separators [-s] | -p pattern] [-o delimiter] [-t threads] [file ...]
+///
+///  - -f list:       the fields to print (counted from 1), e.g. 1,3-5,7-
+///                   The fields are printed in the order of the line.
+///  - -d separators: every character of the string separates fields (default: white spaces)
+///  - -s:            with -d, lines without a separator are not printed
+///  - -p pattern:    a regular expression separates fields (see CIsRegex)
+///  - -o delimiter:  printed between the fields (default: the first separator or a blank)
+///  - -t threads:    the number of worker threads (default: one per core)
+///  - files:         without a file or with -, the standard input is read
+///
+/// Without -d, the fields are the tokens of simple_tokenize, hence runs of white
+/// spaces (or matches of -p) are one separator and leading ones are ignored, like
+/// awk '{print $3}'. With -d, every separator ends a field, so empty fields count,
+/// like cut -d, -f3 and awk -F, '{print $3}'. Like cut, a line without any separator
+/// is printed unchanged, unless -s is given.
+/// Files are memory mapped and split into chunks at line boundaries, which are
+/// processed in parallel. The output of a chunk is written by one write(2) call,
+/// in the order of the input.
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+#include <algorithm>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "simple_mapped_file.hpp"
+#include "simple_simd.hpp"
+#include "simple_tokenize.hpp"
+#include "simple_tokenize_regex.hpp"
+
+/// Separator from a set of characters, which is looked up in a table
+/// instead of searching the set (CIsFromString) for every character.
+class CIsFromSet
+{
+    public:
+        explicit CIsFromSet(const std::string &rostr)
+        {
+            memset(m_table, 0, sizeof(m_table));
+            for(std::size_t ui = 0; ui < rostr.size(); ++ui)
+            {
+                m_table[static_cast<unsigned char>(rostr[ui])] = true;
+            }
+        }
+        bool operator()(const char &c) const
+        {
+            return m_table[static_cast<unsigned char>(c)];
+        }
+
+    private:
+        bool m_table[256];
+};
+
+/// The selected fields (counted from 1)
+class CFieldList
+{
+    public:
+        CFieldList(void) : m_selected(), m_openFrom(0), m_bOnlyDelimited(false) {}
+
+        /// \param strList --> e.g. 1,3-5,7- or -2
+        /// \return <-- false, in case the list is invalid
+        bool Parse(const std::string &strList)
+        {
+            std::size_t pos = 0;
+            while(pos <= strList.size())
+            {
+                std::size_t next = strList.find(',', pos);
+                if(next == std::string::npos)
+                {
+                    next = strList.size();
+                }
+                const std::string strRange(strList.substr(pos, next - pos));
+                const std::size_t dash = strRange.find('-');
+                std::size_t first = 0;
+                std::size_t last  = 0;
+                if(dash == std::string::npos)
+                {
+                    first = last = ToNumber(strRange);
+                }
+                else
+                {
+                    first = (dash == 0) ? 1 : ToNumber(strRange.substr(0, dash));
+                    last  = (dash + 1 == strRange.size()) ? SIZE_MAX : ToNumber(strRange.substr(dash + 1));
+                }
+                if(first == 0 || last == 0 || first > last || (dash == 0 && dash + 1 == strRange.size()))
+                {
+                    return false;
+                }
+                if(last == SIZE_MAX)
+                {
+                    m_openFrom = (m_openFrom == 0) ? first : std::min(m_openFrom, first);
+                }
+                else
+                {
+                    if(m_selected.size() <= last)
+                    {
+                        m_selected.resize(last + 1, false);
+                    }
+                    std::fill(m_selected.begin() + static_cast<std::ptrdiff_t>(first), m_selected.begin() + static_cast<std::ptrdiff_t>(last + 1), true);
+                }
+                pos = next + 1;
+            }
+            return true;
+        }
+
+        bool IsSelected(std::size_t field) const
+        {
+            return (m_openFrom != 0 && field >= m_openFrom) || (field < m_selected.size() && m_selected[field]);
+        }
+
+        /// \return the last field, that can be selected
+        std::size_t GetLast(void) const
+        {
+            return (m_openFrom != 0) ? SIZE_MAX : m_selected.size() - 1;
+        }
+
+        /// Drop the lines, which contain no separator (-s), instead of printing them unchanged.
+        void SetOnlyDelimited(bool bOnlyDelimited)
+        {
+            m_bOnlyDelimited = bOnlyDelimited;
+        }
+
+        bool IsOnlyDelimited(void) const
+        {
+            return m_bOnlyDelimited;
+        }
+
+    private:
+        static std::size_t ToNumber(const std::string &str)
+        {
+            if(str.empty() || str.find_first_not_of("0123456789") != std::string::npos)
+            {
+                return 0;
+            }
+            return static_cast<std::size_t>(strtoull(str.c_str(), NULL, 10));
+        }
+
+        std::vector<bool> m_selected;
+        std::size_t       m_openFrom;
+        bool              m_bOnlyDelimited;
+};
+
+/// Append the selected fields of the lines in [beg, end) to roOutput.
+template <class Pred> static void ExtractFields(const char *beg, const char *end, const CFieldList &roFields
+        , std::string_view delimiter, std::string &roOutput, const Pred &roPred)
+{
+    const std::size_t last = roFields.GetLast();
+    while(beg != end)
+    {
+        const char *lineEnd = simple_simd::FindByte(beg, end, '\n');
+        const std::string_view line(beg, static_cast<std::size_t>(lineEnd - beg));
+        std::size_t field = 0;
+        bool bFirst = true;
+        if constexpr (simple_tokenize_is_multichar<Pred>::value)
+        {
+            simple_tokenize<Pred>::ForEachToken(line, [&](std::string_view token)
+            {
+                if(roFields.IsSelected(++field))
+                {
+                    if(!bFirst)
+                    {
+                        roOutput.append(delimiter.data(), delimiter.size());
+                    }
+                    roOutput.append(token.data(), token.size());
+                    bFirst = false;
+                }
+            }, roPred);
+        }
+        else
+        {
+            // the remaining fields of the line are not scanned, once the last selected one is found
+            std::size_t pos = 0;
+            while(field < last)
+            {
+                const std::string_view token = simple_tokenize<Pred>::NextToken(line, pos, roPred);
+                if(token.empty())
+                {
+                    break;
+                }
+                if(roFields.IsSelected(++field))
+                {
+                    if(!bFirst)
+                    {
+                        roOutput.append(delimiter.data(), delimiter.size());
+                    }
+                    roOutput.append(token.data(), token.size());
+                    bFirst = false;
+                }
+            }
+        }
+        roOutput.push_back('\n');
+        beg = (lineEnd != end) ? lineEnd + 1 : end;
+    }
+}
+
+/// Append the selected fields of the lines in [beg, end) to roOutput, every separator ends a field.
+static void ExtractFields(const char *beg, const char *end, const CFieldList &roFields
+                          , std::string_view delimiter, std::string &roOutput, const CIsFromSet &roPred)
+{
+    const std::size_t last = roFields.GetLast();
+    while(beg != end)
+    {
+        const char *lineEnd = simple_simd::FindByte(beg, end, '\n');
+        std::size_t field = 1;
+        bool bFirst = true;
+        bool bLine  = true;
+        const char *fieldBeg = beg;
+        for(const char *p = beg; ; ++p)
+        {
+            if(p != lineEnd && !roPred(*p))
+            {
+                continue;
+            }
+            // like cut, a line without a separator is printed unchanged or dropped (-s)
+            if(p == lineEnd && field == 1)
+            {
+                bLine = !roFields.IsOnlyDelimited();
+                if(bLine)
+                {
+                    roOutput.append(beg, static_cast<std::size_t>(lineEnd - beg));
+                }
+                break;
+            }
+            if(roFields.IsSelected(field))
+            {
+                if(!bFirst)
+                {
+                    roOutput.append(delimiter.data(), delimiter.size());
+                }
+                roOutput.append(fieldBeg, static_cast<std::size_t>(p - fieldBeg));
+                bFirst = false;
+            }
+            // the remaining fields of the line are not scanned, once the last selected one is found
+            if(p == lineEnd || field >= last)
+            {
+                break;
+            }
+            ++field;
+            fieldBeg = p + 1;
+        }
+        if(bLine)
+        {
+            roOutput.push_back('\n');
+        }
+        beg = (lineEnd != end) ? lineEnd + 1 : end;
+    }
+}
+
+static bool WriteAll(const std::string &strOutput)
+{
+    const char *p = strOutput.data();
+    std::size_t size = strOutput.size();
+    while(size > 0)
+    {
+        const ssize_t written = write(STDOUT_FILENO, p, size);
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+        p    += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+/// Extract the fields of complete lines in [beg, end) with several threads.
+/// The chunks are written in order, a worker does not run further ahead of
+/// the writer than the number of output buffers.
+template <class Pred> static bool ProcessLines(const char *beg, const char *end, unsigned int numberOfThreads
+        , const CFieldList &roFields, std::string_view delimiter, const Pred &roPred)
+{
+    const std::size_t chunkSize = 4 << 20;
+    std::vector<const char*> bounds(1, beg);
+    while(bounds.back() != end)
+    {
+        const char *pBound = bounds.back() + std::min<std::size_t>(chunkSize, static_cast<std::size_t>(end - bounds.back()));
+        pBound = simple_simd::FindByte(pBound, end, '\n');
+        bounds.push_back((pBound != end) ? pBound + 1 : end);
+    }
+    const std::size_t numberOfChunks = bounds.size() - 1;
+    numberOfThreads = static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(numberOfThreads, numberOfChunks)));
+    if(numberOfThreads == 1)
+    {
+        std::string strOutput;
+        for(std::size_t ui = 0; ui < numberOfChunks; ++ui)
+        {
+            strOutput.clear();
+            ExtractFields(bounds[ui], bounds[ui + 1], roFields, delimiter, strOutput, roPred);
+            if(!WriteAll(strOutput))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const std::size_t numberOfBuffers = 2 * numberOfThreads;
+    std::vector<std::string> buffers(numberOfBuffers);
+    std::vector<char> done(numberOfBuffers, 0);
+    std::size_t nextChunk = 0;
+    std::size_t written   = 0;
+    bool bFailed = false;
+    std::mutex mutex;
+    std::condition_variable changed;
+
+    std::vector<std::thread> threads;
+    for(unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+        threads.push_back(std::thread([&]()
+        {
+            for(;;)
+            {
+                std::size_t chunk = 0;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&]()
+                    {
+                        return bFailed || nextChunk >= numberOfChunks || nextChunk < written + numberOfBuffers;
+                    });
+                    if(bFailed || nextChunk >= numberOfChunks)
+                    {
+                        return;
+                    }
+                    chunk = nextChunk++;
+                }
+                std::string &strOutput = buffers[chunk % numberOfBuffers];
+                strOutput.clear();
+                ExtractFields(bounds[chunk], bounds[chunk + 1], roFields, delimiter, strOutput, roPred);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    done[chunk % numberOfBuffers] = 1;
+                }
+                changed.notify_all();
+            }
+        }));
+    }
+
+    for(std::size_t chunk = 0; chunk < numberOfChunks && !bFailed; ++chunk)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [&]()
+            {
+                return done[chunk % numberOfBuffers] != 0;
+            });
+        }
+        const bool bWritten = WriteAll(buffers[chunk % numberOfBuffers]);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done[chunk % numberOfBuffers] = 0;
+            written = chunk + 1;
+            bFailed = !bWritten;
+        }
+        changed.notify_all();
+    }
+    for(std::size_t t = 0; t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+    return !bFailed;
+}
+
+/// Process the standard input in blocks of complete lines.
+template <class Pred> static bool ProcessStream(int fd, unsigned int numberOfThreads
+        , const CFieldList &roFields, std::string_view delimiter, const Pred &roPred)
+{
+    const std::size_t blockSize = 64 << 20;
+    std::vector<char> block(blockSize);
+    std::size_t filled = 0;
+    for(;;)
+    {
+        // fill the block, so that the threads get enough work
+        bool bEnd = false;
+        while(filled < block.size() && !bEnd)
+        {
+            const ssize_t bytes = read(fd, block.data() + filled, block.size() - filled);
+            if(bytes < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if(bytes < 0)
+            {
+                return false;
+            }
+            filled += static_cast<std::size_t>(bytes);
+            bEnd = (bytes == 0);
+        }
+        // the incomplete last line is kept for the next block
+        const char *pEnd = block.data() + filled;
+        if(!bEnd)
+        {
+            while(pEnd != block.data() && *(pEnd - 1) != '\n')
+            {
+                --pEnd;
+            }
+            if(pEnd == block.data())
+            {
+                block.resize(2 * block.size());
+                continue;
+            }
+        }
+        if(!ProcessLines(block.data(), pEnd, numberOfThreads, roFields, delimiter, roPred))
+        {
+            return false;
+        }
+        if(bEnd)
+        {
+            return true;
+        }
+        filled = static_cast<std::size_t>(block.data() + filled - pEnd);
+        memmove(block.data(), pEnd, filled);
+    }
+}
+
+template <class Pred> static int Run(const std::vector<std::string> &roFiles, unsigned int numberOfThreads
+                                     , const CFieldList &roFields, std::string_view delimiter, const Pred &roPred)
+{
+    int result = 0;
+    for(std::size_t ui = 0; ui < roFiles.size(); ++ui)
+    {
+        if(roFiles[ui] == "-")
+        {
+            if(!ProcessStream(STDIN_FILENO, numberOfThreads, roFields, delimiter, roPred))
+            {
+                std::cerr << "field_cut: cannot process the standard input\n";
+                return 1;
+            }
+            continue;
+        }
+        const char *pData = NULL;
+        std::size_t size  = 0;
+        struct stat status;
+        if(!simple_mapped_file::Map(roFiles[ui], pData, size, status))
+        {
+            std::cerr << "field_cut: cannot read " << roFiles[ui] << "\n";
+            result = 1;
+            continue;
+        }
+        if(pData != NULL)
+        {
+            (void)madvise(const_cast<char*>(pData), size, MADV_SEQUENTIAL);
+        }
+        const bool bSuccess = ProcessLines(pData, pData + size, numberOfThreads, roFields, delimiter, roPred);
+        simple_mapped_file::Unmap(pData, size);
+        if(!bSuccess)
+        {
+            std::cerr << "field_cut: cannot write the output\n";
+            return 1;
+        }
+    }
+    return result;
+}
+
+static int Usage(void)
+{
+    std::cerr << "usage: field_cut -f list [-d separators [-s] | -p pattern] [-o delimiter] [-t threads] [file ...]\n";
+    return 2;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int numberOfThreads = 0;
+    std::string strSeparators;
+    std::string strPattern;
+    std::string strDelimiter;
+    bool bDelimiter = false;
+    CFieldList fields;
+    bool bFields = false;
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+        {
+            if(!fields.Parse(argv[++i]))
+            {
+                std::cerr << "field_cut: invalid field list " << argv[i] << "\n";
+                return 2;
+            }
+            bFields = true;
+        }
+        else if(strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+        {
+            strSeparators = argv[++i];
+        }
+        else if(strcmp(argv[i], "-s") == 0)
+        {
+            fields.SetOnlyDelimited(true);
+        }
+        else if(strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+        {
+            strPattern = argv[++i];
+        }
+        else if(strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            strDelimiter = argv[++i];
+            bDelimiter = true;
+        }
+        else if(strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            numberOfThreads = static_cast<unsigned int>(strtoul(argv[++i], NULL, 10));
+        }
+        else if(argv[i][0] == '-' && argv[i][1] != '\0')
+        {
+            return Usage();
+        }
+        else
+        {
+            files.push_back(argv[i]);
+        }
+    }
+    if(!bFields || (!strSeparators.empty() && !strPattern.empty()) || (fields.IsOnlyDelimited() && strSeparators.empty()))
+    {
+        return Usage();
+    }
+    if(files.empty())
+    {
+        files.push_back("-");
+    }
+    if(numberOfThreads == 0)
+    {
+        numberOfThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    if(!bDelimiter)
+    {
+        strDelimiter = strSeparators.empty() ? std::string(" ") : strSeparators.substr(0, 1);
+    }
+
+    if(!strPattern.empty())
+    {
+        const CIsRegex separator(strPattern);
+        if(!separator.IsValid())
+        {
+            std::cerr << "field_cut: invalid pattern: " << separator.GetError() << "\n";
+            return 2;
+        }
+        return Run(files, numberOfThreads, fields, strDelimiter, separator);
+    }
+    if(!strSeparators.empty())
+    {
+        return Run(files, numberOfThreads, fields, strDelimiter, CIsFromSet(strSeparators));
+    }
+    return Run(files, numberOfThreads, fields, strDelimiter, CIsSpace());
+}
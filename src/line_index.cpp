@@ -0,0 +1,93 @@
+// -------------------------------------------------
+/// Random access to the records (lines) of large files.
+/// The line offset index of a file is built on the first call and reused afterwards.
+///
+/// usage: line_index [-t threads] [-d separators] <file> [record [field]]
+///
+///  - without record:   print the number of records
+///  - with record:      print the record (counted from 0)
+///  - with field:       print the field of the record (counted from 0), split at the separators
+///                      (default: white spaces)
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+
+#include "simple_line_index.hpp"
+
+static int Usage(void)
+{
+    std::cerr << "usage: line_index [-t threads] [-d separators] <file> [record [field]]\n";
+    return 2;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int numberOfThreads = 0;
+    std::string strSeparators;
+    std::vector<std::string> arguments;
+    for(int i = 1; i < argc; ++i)
+    {
+        if(strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+        {
+            numberOfThreads = static_cast<unsigned int>(strtoul(argv[++i], NULL, 10));
+        }
+        else if(strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+        {
+            strSeparators = argv[++i];
+        }
+        else
+        {
+            arguments.push_back(argv[i]);
+        }
+    }
+    if(arguments.empty() || arguments.size() > 3)
+    {
+        return Usage();
+    }
+
+    simple_line_index index;
+    if(!index.Open(arguments[0], numberOfThreads))
+    {
+        std::cerr << "line_index: cannot index " << arguments[0] << "\n";
+        return 1;
+    }
+    if(arguments.size() == 1)
+    {
+        std::cout << index.GetNumberOfRecords() << "\n";
+        return 0;
+    }
+
+    const std::size_t record = static_cast<std::size_t>(strtoull(arguments[1].c_str(), NULL, 10));
+    if(record >= index.GetNumberOfRecords())
+    {
+        std::cerr << "line_index: the file has " << index.GetNumberOfRecords() << " records\n";
+        return 1;
+    }
+    if(arguments.size() == 2)
+    {
+        std::cout << index.GetRecord(record) << "\n";
+        return 0;
+    }
+
+    std::vector<std::string> fields;
+    if(strSeparators.empty())
+    {
+        index.TokenizeRecord<CIsSpace>(fields, record);
+    }
+    else
+    {
+        index.TokenizeRecord(fields, record, CIsFromString(strSeparators));
+    }
+    const std::size_t field = static_cast<std::size_t>(strtoull(arguments[2].c_str(), NULL, 10));
+    if(field < fields.size())
+    {
+        std::cout << fields[field];
+    }
+    std::cout << "\n";
+    return 0;
+}
@@ -1,6 +1,687 @@
+// -------------------------------------------------
+/// A log processing pipeline, which serves as reference workload to profile
+/// and tune the library:
+///
+///  reader -> tokenizer -> filter -> aggregator -> writer
+///
+/// The stages are connected by bounded lock-free queues (simple_queue.hpp),
+/// which pass batches of complete lines. The batches are recycled through a
+/// pool of fixed size, so that the reader cannot run ahead of the slowest
+/// stage (backpressure).
+///
+/// usage: sample_demo [-t tokenizers] [-f filters] [-a aggregators] [-b batch KiB]
+///                    [-q queue capacity] [-g token] [-k top] [-n lines] [-o output] [file]
+///
+///  - file:   the log to be processed, without a file -n synthetic lines are generated
+///  - -g:     only lines, that contain the token, pass the filter
+///  - -o:     the lines, that passed the filter, are written to this file in the order of the input
+///  - -k:     the number of most frequent tokens, that are reported
+///
+/// At the end, the throughput of every stage, the occupancy of every queue,
+/// the latency of the batches from reader to writer and the most frequent
+/// tokens are printed.
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
-int main(void)
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "simple_queue.hpp"
+#include "simple_simd.hpp"
+#include "simple_token_frequency.hpp"
+#include "simple_tokenize.hpp"
+
+typedef std::chrono::steady_clock clock_type;
+
+/// The unit of work, which is passed between the stages
+struct SBatch
+{
+    uint64_t                      sequence;
+    clock_type::time_point        created;
+    std::string                   data;
+    std::vector<std::string_view> lines;
+    std::vector<std::string_view> tokens;
+    /// the end of the tokens of every line in tokens
+    std::vector<std::size_t>      lineTokens;
+    /// whether a line passed the filter
+    std::vector<char>             keep;
+
+    void Clear(void)
+    {
+        data.clear();
+        lines.clear();
+        tokens.clear();
+        lineTokens.clear();
+        keep.clear();
+    }
+};
+
+/// A queue between two stages. A single producer and consumer use the SPSC queue,
+/// otherwise the MPMC queue is used. The occupancy is sampled at every push.
+class CBatchQueue
+{
+    public:
+        CBatchQueue(const std::string &strName, std::size_t capacity, unsigned int producers, unsigned int consumers)
+            : m_strName(strName)
+            , m_pSpsc((producers == 1 && consumers == 1) ? new simple_spsc_queue<SBatch*>(capacity) : NULL)
+            , m_pMpmc((producers == 1 && consumers == 1) ? NULL : new simple_mpmc_queue<SBatch*>(capacity))
+            , m_samples(0)
+            , m_occupancy(0)
+            , m_maxOccupancy(0)
+        {}
+
+        /// \param pBatch --> the batch, NULL marks the end of the input
+        void Push(SBatch *pBatch)
+        {
+            const std::size_t size = Size();
+            m_samples.fetch_add(1, std::memory_order_relaxed);
+            m_occupancy.fetch_add(size, std::memory_order_relaxed);
+            std::size_t maximum = m_maxOccupancy.load(std::memory_order_relaxed);
+            while(size > maximum && !m_maxOccupancy.compare_exchange_weak(maximum, size, std::memory_order_relaxed)) {}
+            if(m_pSpsc)
+            {
+                m_pSpsc->Push(pBatch);
+            }
+            else
+            {
+                m_pMpmc->Push(pBatch);
+            }
+        }
+
+        SBatch *Pop(void)
+        {
+            SBatch *pBatch = NULL;
+            if(m_pSpsc)
+            {
+                m_pSpsc->Pop(pBatch);
+            }
+            else
+            {
+                m_pMpmc->Pop(pBatch);
+            }
+            return pBatch;
+        }
+
+        std::size_t Size(void) const
+        {
+            return m_pSpsc ? m_pSpsc->Size() : m_pMpmc->Size();
+        }
+
+        std::size_t Capacity(void) const
+        {
+            return m_pSpsc ? m_pSpsc->Capacity() : m_pMpmc->Capacity();
+        }
+
+        void Print(std::ostream &os) const
+        {
+            const uint64_t samples = m_samples.load();
+            os << "  " << std::left << std::setw(22) << m_strName << std::right
+               << (m_pSpsc ? " spsc" : " mpmc")
+               << "  capacity " << std::setw(5) << Capacity()
+               << "  mean occupancy " << std::setw(7) << std::fixed << std::setprecision(2)
+               << ((samples != 0) ? static_cast<double>(m_occupancy.load()) / static_cast<double>(samples) : 0.0)
+               << "  max " << m_maxOccupancy.load() << "\n";
+        }
+
+    private:
+        std::string m_strName;
+        std::unique_ptr< simple_spsc_queue<SBatch*> > m_pSpsc;
+        std::unique_ptr< simple_mpmc_queue<SBatch*> > m_pMpmc;
+        std::atomic<uint64_t>    m_samples;
+        std::atomic<uint64_t>    m_occupancy;
+        std::atomic<std::size_t> m_maxOccupancy;
+};
+
+/// The work of the threads of a stage
+struct SStageStats
 {
+    std::string           strName;
+    unsigned int          workers;
+    std::atomic<uint64_t> batches;
+    std::atomic<uint64_t> lines;
+    std::atomic<uint64_t> bytes;
+    std::atomic<uint64_t> busyNanoseconds;
+
+    SStageStats(const std::string &strStageName, unsigned int numberOfWorkers)
+        : strName(strStageName), workers(numberOfWorkers), batches(0), lines(0), bytes(0), busyNanoseconds(0) {}
+
+    void Print(std::ostream &os, double wallSeconds) const
+    {
+        const double busySeconds = static_cast<double>(busyNanoseconds.load()) * 1e-9;
+        const double megaBytes   = static_cast<double>(bytes.load()) / (1024.0 * 1024.0);
+        os << "  " << std::left << std::setw(11) << strName << std::right
+           << " workers " << std::setw(2) << workers
+           << "  batches " << std::setw(8) << batches.load()
+           << "  lines " << std::setw(10) << lines.load()
+           << std::fixed << std::setprecision(1)
+           << "  " << std::setw(8) << megaBytes / wallSeconds << " MiB/s"
+           << "  busy " << std::setw(5) << 100.0 * busySeconds / (wallSeconds * workers) << " %\n";
+    }
+};
+
+/// Run a worker of a stage: process the batches of the input queue and pass them on.
+/// The last worker of a stage, that sees the end of the input, forwards it to every
+/// worker of the next stage.
+template <class F> static void RunWorker(CBatchQueue &roInput, CBatchQueue &roOutput, std::atomic<unsigned int> &roActive
+        , unsigned int nextWorkers, SStageStats &roStats, F process)
+{
+    uint64_t batches = 0;
+    uint64_t lines   = 0;
+    uint64_t bytes   = 0;
+    uint64_t busy    = 0;
+    for(;;)
+    {
+        SBatch *pBatch = roInput.Pop();
+        if(pBatch == NULL)
+        {
+            break;
+        }
+        const clock_type::time_point start = clock_type::now();
+        process(*pBatch);
+        busy += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - start).count());
+        ++batches;
+        lines += pBatch->lines.size();
+        bytes += pBatch->data.size();
+        roOutput.Push(pBatch);
+    }
+    roStats.batches         += batches;
+    roStats.lines           += lines;
+    roStats.bytes           += bytes;
+    roStats.busyNanoseconds += busy;
+    if(roActive.fetch_sub(1) == 1)
+    {
+        for(unsigned int ui = 0; ui < nextWorkers; ++ui)
+        {
+            roOutput.Push(NULL);
+        }
+    }
+}
+
+/// The source of the lines: a file or a generator of synthetic log lines
+class CLineSource
+{
+    public:
+        CLineSource(int fd, uint64_t numberOfLines) : m_fd(fd), m_remainingLines(numberOfLines), m_random(42), m_strCarry(), m_error(0) {}
+
+        /// Fill the batch with complete lines of about batchSize bytes.
+        /// \return <-- false, in case there are no more lines or the file cannot be read (see GetError())
+        bool Fill(std::string &roData, std::size_t batchSize)
+        {
+            roData.swap(m_strCarry);
+            m_strCarry.clear();
+            if(m_fd < 0)
+            {
+                while(roData.size() < batchSize && m_remainingLines > 0)
+                {
+                    Generate(roData);
+                    --m_remainingLines;
+                }
+                return !roData.empty();
+            }
+            bool bEnd = false;
+            while(roData.size() < batchSize && !bEnd)
+            {
+                const std::size_t size = roData.size();
+                roData.resize(batchSize);
+                const ssize_t bytes = read(m_fd, &roData[size], batchSize - size);
+                roData.resize(size + static_cast<std::size_t>(std::max<ssize_t>(bytes, 0)));
+                if(bytes < 0 && errno != EINTR)
+                {
+                    m_error = errno;
+                    return false;
+                }
+                bEnd = (bytes == 0);
+            }
+            if(!bEnd)
+            {
+                // the incomplete last line belongs to the next batch
+                const std::size_t pos = roData.rfind('\n');
+                if(pos != std::string::npos)
+                {
+                    m_strCarry.assign(roData, pos + 1, std::string::npos);
+                    roData.resize(pos + 1);
+                }
+            }
+            return !roData.empty();
+        }
+
+        /// \return the errno of the failed read or 0
+        int GetError(void) const
+        {
+            return m_error;
+        }
+
+    private:
+        uint32_t Next(void)
+        {
+            m_random = m_random * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<uint32_t>(m_random >> 33);
+        }
+
+        void Generate(std::string &roData)
+        {
+            static const char *levels[]   = { "INFO", "INFO", "INFO", "DEBUG", "WARN", "ERROR" };
+            static const char *services[] = { "auth", "billing", "search", "gateway", "storage" };
+            static const char *messages[] = { "request served", "cache miss", "retrying upstream", "connection reset by peer", "slow query" };
+            const uint32_t r = Next();
+            roData += "2026-10-19T12:";
+            roData += std::to_string(10 + r % 50);
+            roData += ":";
+            roData += std::to_string(10 + (r >> 8) % 50);
+            roData += " host";
+            roData += std::to_string((r >> 4) % 64);
+            roData += " ";
+            roData += levels[(r >> 12) % 6];
+            roData += " service=";
+            roData += services[(r >> 16) % 5];
+            roData += " user=u";
+            roData += std::to_string(Next() % 100000);
+            roData += " latency_ms=";
+            roData += std::to_string(Next() % 2000);
+            roData += " msg=";
+            roData += messages[(r >> 20) % 5];
+            roData += "\n";
+        }
+
+        int         m_fd;
+        uint64_t    m_remainingLines;
+        uint64_t    m_random;
+        std::string m_strCarry;
+        int         m_error;
+};
+
+static double Percentile(const std::vector<double> &roSorted, double percent)
+{
+    if(roSorted.empty())
+    {
+        return 0.0;
+    }
+    const std::size_t index = static_cast<std::size_t>(percent / 100.0 * static_cast<double>(roSorted.size() - 1) + 0.5);
+    return roSorted[index];
+}
+
+static bool WriteAll(int fd, const std::string &strData)
+{
+    std::size_t pos = 0;
+    while(pos < strData.size())
+    {
+        const ssize_t written = write(fd, strData.data() + pos, strData.size() - pos);
+        if(written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if(written < 0)
+        {
+            return false;
+        }
+        pos += static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+static int Usage(void)
+{
+    std::cerr << "usage: sample_demo [-t tokenizers] [-f filters] [-a aggregators] [-b batch KiB]\n"
+              << "                   [-q queue capacity] [-g token] [-k top] [-n lines] [-o output] [file]\n";
+    return 2;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int tokenizers  = 2;
+    unsigned int filters     = 1;
+    unsigned int aggregators = 1;
+    std::size_t  batchSize   = 256 * 1024;
+    std::size_t  capacity    = 64;
+    std::size_t  top         = 10;
+    uint64_t     syntheticLines = 1000000;
+    std::string  strToken;
+    std::string  strOutput;
+    std::string  strInput;
+    for(int i = 1; i < argc; ++i)
+    {
+        const bool bValue = (i + 1 < argc);
+        if(strcmp(argv[i], "-t") == 0 && bValue)
+        {
+            tokenizers = static_cast<unsigned int>(strtoul(argv[++i], NULL, 10));
+        }
+        else if(strcmp(argv[i], "-f") == 0 && bValue)
+        {
+            filters = static_cast<unsigned int>(strtoul(argv[++i], NULL, 10));
+        }
+        else if(strcmp(argv[i], "-a") == 0 && bValue)
+        {
+            aggregators = static_cast<unsigned int>(strtoul(argv[++i], NULL, 10));
+        }
+        else if(strcmp(argv[i], "-b") == 0 && bValue)
+        {
+            batchSize = static_cast<std::size_t>(strtoull(argv[++i], NULL, 10)) * 1024;
+        }
+        else if(strcmp(argv[i], "-q") == 0 && bValue)
+        {
+            capacity = static_cast<std::size_t>(strtoull(argv[++i], NULL, 10));
+        }
+        else if(strcmp(argv[i], "-k") == 0 && bValue)
+        {
+            top = static_cast<std::size_t>(strtoull(argv[++i], NULL, 10));
+        }
+        else if(strcmp(argv[i], "-n") == 0 && bValue)
+        {
+            syntheticLines = static_cast<uint64_t>(strtoull(argv[++i], NULL, 10));
+        }
+        else if(strcmp(argv[i], "-g") == 0 && bValue)
+        {
+            strToken = argv[++i];
+        }
+        else if(strcmp(argv[i], "-o") == 0 && bValue)
+        {
+            strOutput = argv[++i];
+        }
+        else if(argv[i][0] == '-' || !strInput.empty())
+        {
+            return Usage();
+        }
+        else
+        {
+            strInput = argv[i];
+        }
+    }
+    if(tokenizers == 0 || filters == 0 || aggregators == 0 || batchSize == 0 || capacity == 0)
+    {
+        return Usage();
+    }
+
+    int inputFd = -1;
+    if(!strInput.empty())
+    {
+        inputFd = open(strInput.c_str(), O_RDONLY);
+        if(inputFd < 0)
+        {
+            std::cerr << "sample_demo: cannot open " << strInput << "\n";
+            return 1;
+        }
+    }
+    int outputFd = -1;
+    if(!strOutput.empty())
+    {
+        outputFd = open(strOutput.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if(outputFd < 0)
+        {
+            std::cerr << "sample_demo: cannot create " << strOutput << "\n";
+            return 1;
+        }
+    }
+
+    // the pool holds the batches, that are not in the pipeline
+    const std::size_t numberOfBatches = 4 * capacity;
+    std::vector< std::unique_ptr<SBatch> > batches;
+    CBatchQueue pool("writer -> reader", numberOfBatches, 1, 1);
+    for(std::size_t ui = 0; ui < numberOfBatches; ++ui)
+    {
+        batches.push_back(std::unique_ptr<SBatch>(new SBatch()));
+        pool.Push(batches.back().get());
+    }
+    CBatchQueue toTokenizer("reader -> tokenizer", capacity, 1, tokenizers);
+    CBatchQueue toFilter("tokenizer -> filter", capacity, tokenizers, filters);
+    CBatchQueue toAggregator("filter -> aggregator", capacity, filters, aggregators);
+    CBatchQueue toWriter("aggregator -> writer", capacity, aggregators, 1);
+
+    SStageStats readerStats("reader", 1);
+    SStageStats tokenizerStats("tokenizer", tokenizers);
+    SStageStats filterStats("filter", filters);
+    SStageStats aggregatorStats("aggregator", aggregators);
+    SStageStats writerStats("writer", 1);
+    std::atomic<unsigned int> activeTokenizers(tokenizers);
+    std::atomic<unsigned int> activeFilters(filters);
+    std::atomic<unsigned int> activeAggregators(aggregators);
+
+    // every aggregator counts into its own sketch, they are merged at the end
+    std::vector< std::unique_ptr< simple_token_frequency<> > > frequencies;
+    for(unsigned int ui = 0; ui < aggregators; ++ui)
+    {
+        frequencies.push_back(std::unique_ptr< simple_token_frequency<> >(new simple_token_frequency<>(0.0001, 0.001, top)));
+    }
+
+    std::vector<double> latencies;
+    uint64_t keptLines = 0;
+    bool bWriteFailed  = false;
+    int readError      = 0;
+    const clock_type::time_point start = clock_type::now();
+    std::vector<std::thread> threads;
+
+    // reader
+    threads.push_back(std::thread([&]()
+    {
+        CLineSource source(inputFd, syntheticLines);
+        uint64_t sequence = 0;
+        uint64_t busy     = 0;
+        for(;;)
+        {
+            SBatch *pBatch = pool.Pop();
+            const clock_type::time_point begin = clock_type::now();
+            if(!source.Fill(pBatch->data, batchSize))
+            {
+                break;
+            }
+            pBatch->sequence = sequence++;
+            pBatch->created  = clock_type::now();
+            busy += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(pBatch->created - begin).count());
+            readerStats.bytes += pBatch->data.size();
+            toTokenizer.Push(pBatch);
+        }
+        readerStats.batches = sequence;
+        readerStats.busyNanoseconds = busy;
+        readError = source.GetError();
+        for(unsigned int ui = 0; ui < tokenizers; ++ui)
+        {
+            toTokenizer.Push(NULL);
+        }
+    }));
+
+    // tokenizers: split the batch into lines and the lines into tokens
+    for(unsigned int t = 0; t < tokenizers; ++t)
+    {
+        threads.push_back(std::thread([&]()
+        {
+            RunWorker(toTokenizer, toFilter, activeTokenizers, filters, tokenizerStats, [](SBatch &roBatch)
+            {
+                const char *it  = roBatch.data.data();
+                const char *end = it + roBatch.data.size();
+                while(it != end)
+                {
+                    const char *lineEnd = simple_simd::FindByte(it, end, '\n');
+                    const std::string_view line(it, static_cast<std::size_t>(lineEnd - it));
+                    roBatch.lines.push_back(line);
+                    simple_tokenize<CIsSpace>::ForEachToken(line, [&roBatch](std::string_view token)
+                    {
+                        roBatch.tokens.push_back(token);
+                    });
+                    roBatch.lineTokens.push_back(roBatch.tokens.size());
+                    it = (lineEnd != end) ? lineEnd + 1 : end;
+                }
+            });
+        }));
+    }
+
+    // filters: keep the lines, that contain the token
+    for(unsigned int t = 0; t < filters; ++t)
+    {
+        threads.push_back(std::thread([&]()
+        {
+            RunWorker(toFilter, toAggregator, activeFilters, aggregators, filterStats, [&strToken](SBatch &roBatch)
+            {
+                roBatch.keep.assign(roBatch.lines.size(), 0);
+                std::size_t first = 0;
+                for(std::size_t ui = 0; ui < roBatch.lines.size(); ++ui)
+                {
+                    const std::size_t last = roBatch.lineTokens[ui];
+                    bool bKeep = (last != first);
+                    if(bKeep && !strToken.empty())
+                    {
+                        bKeep = (std::find(roBatch.tokens.begin() + static_cast<std::ptrdiff_t>(first)
+                                           , roBatch.tokens.begin() + static_cast<std::ptrdiff_t>(last)
+                                           , std::string_view(strToken)) != roBatch.tokens.begin() + static_cast<std::ptrdiff_t>(last));
+                    }
+                    roBatch.keep[ui] = bKeep ? 1 : 0;
+                    first = last;
+                }
+            });
+        }));
+    }
+
+    // aggregators: count the tokens of the kept lines
+    for(unsigned int t = 0; t < aggregators; ++t)
+    {
+        simple_token_frequency<> *pFrequency = frequencies[t].get();
+        threads.push_back(std::thread([&, pFrequency]()
+        {
+            RunWorker(toAggregator, toWriter, activeAggregators, 1, aggregatorStats, [pFrequency](SBatch &roBatch)
+            {
+                std::size_t first = 0;
+                for(std::size_t ui = 0; ui < roBatch.lines.size(); ++ui)
+                {
+                    const std::size_t last = roBatch.lineTokens[ui];
+                    if(roBatch.keep[ui])
+                    {
+                        for(std::size_t uj = first; uj < last; ++uj)
+                        {
+                            pFrequency->Add(roBatch.tokens[uj]);
+                        }
+                    }
+                    first = last;
+                }
+            });
+        }));
+    }
+
+    // writer: write the kept lines in the order of the input, measure the latency and return the batch to the pool
+    threads.push_back(std::thread([&]()
+    {
+        std::string strBuffer;
+        uint64_t busy = 0;
+        // the batches, which overtook an earlier one. At most numberOfBatches are in the pipeline,
+        // so the sequences waiting here are less than numberOfBatches apart.
+        std::vector<SBatch*> pending(numberOfBatches, NULL);
+        uint64_t nextSequence = 0;
+        for(;;)
+        {
+            SBatch *pBatch = toWriter.Pop();
+            if(pBatch == NULL)
+            {
+                break;
+            }
+            pending[pBatch->sequence % numberOfBatches] = pBatch;
+            while((pBatch = pending[nextSequence % numberOfBatches]) != NULL)
+            {
+                pending[nextSequence % numberOfBatches] = NULL;
+                ++nextSequence;
+                const clock_type::time_point begin = clock_type::now();
+                for(std::size_t ui = 0; ui < pBatch->lines.size(); ++ui)
+                {
+                    if(pBatch->keep[ui])
+                    {
+                        ++keptLines;
+                        if(outputFd >= 0)
+                        {
+                            strBuffer.append(pBatch->lines[ui].data(), pBatch->lines[ui].size());
+                            strBuffer.push_back('\n');
+                        }
+                    }
+                }
+                if(strBuffer.size() >= (1 << 20))
+                {
+                    bWriteFailed = !WriteAll(outputFd, strBuffer) || bWriteFailed;
+                    strBuffer.clear();
+                }
+                const clock_type::time_point end = clock_type::now();
+                busy += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count());
+                latencies.push_back(std::chrono::duration<double, std::milli>(end - pBatch->created).count());
+                ++writerStats.batches;
+                writerStats.lines += pBatch->lines.size();
+                writerStats.bytes += pBatch->data.size();
+                pBatch->Clear();
+                pool.Push(pBatch);
+            }
+        }
+        if(outputFd >= 0)
+        {
+            bWriteFailed = !WriteAll(outputFd, strBuffer) || bWriteFailed;
+        }
+        writerStats.busyNanoseconds = busy;
+    }));
+
+    for(std::size_t ui = 0; ui < threads.size(); ++ui)
+    {
+        threads[ui].join();
+    }
+    const double wallSeconds = std::max(1e-9, std::chrono::duration<double>(clock_type::now() - start).count());
+    readerStats.lines = writerStats.lines.load();
+    if(inputFd >= 0)
+    {
+        close(inputFd);
+    }
+    if(outputFd >= 0 && close(outputFd) != 0)
+    {
+        bWriteFailed = true;
+    }
+
+    for(unsigned int ui = 1; ui < aggregators; ++ui)
+    {
+        frequencies[0]->Merge(*frequencies[ui]);
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << "pipeline: " << writerStats.lines.load() << " lines, " << keptLines << " kept, "
+              << std::fixed << std::setprecision(3) << wallSeconds << " s\n";
+    std::cout << "stages:\n";
+    readerStats.Print(std::cout, wallSeconds);
+    tokenizerStats.Print(std::cout, wallSeconds);
+    filterStats.Print(std::cout, wallSeconds);
+    aggregatorStats.Print(std::cout, wallSeconds);
+    writerStats.Print(std::cout, wallSeconds);
+    std::cout << "queues:\n";
+    toTokenizer.Print(std::cout);
+    toFilter.Print(std::cout);
+    toAggregator.Print(std::cout);
+    toWriter.Print(std::cout);
+    pool.Print(std::cout);
+    std::cout << "batch latency (ms): p50 " << std::setprecision(3) << Percentile(latencies, 50.0)
+              << "  p90 " << Percentile(latencies, 90.0)
+              << "  p99 " << Percentile(latencies, 99.0)
+              << "  max " << (latencies.empty() ? 0.0 : latencies.back()) << "\n";
+
+    std::vector< std::pair<std::string, uint64_t> > topTokens;
+    frequencies[0]->GetTopK(topTokens);
+    std::cout << "top tokens (error bound " << frequencies[0]->GetErrorBound() << "):\n";
+    for(std::size_t ui = 0; ui < topTokens.size(); ++ui)
+    {
+        std::cout << "  " << std::setw(10) << topTokens[ui].second << "  " << topTokens[ui].first << "\n";
+    }
+    if(readError != 0)
+    {
+        std::cerr << "sample_demo: cannot read " << strInput << ": " << strerror(readError) << "\n";
+        return 1;
+    }
+    if(bWriteFailed)
+    {
+        std::cerr << "sample_demo: cannot write " << strOutput << "\n";
+        return 1;
+    }
     return 0;
 }
@@ -0,0 +1,252 @@
+// -------------------------------------------------
+/// Measure the optimizations of simple_tokenize against the plain way
+/// of doing the same work. Every benchmark prints both timings and checks,
+/// that both ways give the same result.
+///
+/// usage: tokenize_bench [benchmark ...]
+///
+///  - radix: simple_radix_sort::SortUnique against std::sort and std::unique
+///  - cache: simple_tokenize_cache against tokenizing every line again, for short
+///           and long repeating lines and for a cheap and an expensive separator
+///  - template: the lines per second of simple_log_template_miner on a synthetic log
+///           of six line types, against only tokenizing the lines
+///
+/// Without an argument, every benchmark is run.
+/// @author Dr. Martin Ettl
+/// @date   2026-10-19
+// -------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "simple_log_template.hpp"
+#include "simple_radix_sort.hpp"
+#include "simple_tokenize_cache.hpp"
+#include "simple_tokenize_regex.hpp"
+
+/// \return <-- the seconds of the fastest of three runs of f
+template <class F> static double Measure(F f)
+{
+    double best = 0.0;
+    for(unsigned int run = 0; run < 3; ++run)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        f();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if(run == 0 || seconds < best)
+        {
+            best = seconds;
+        }
+    }
+    return best;
+}
+
+static void Report(const char *name, double seconds, double baseline, bool bSame)
+{
+    printf("%-28s %8.3f s  baseline %8.3f s  speed-up %5.2fx  %s\n"
+           , name, seconds, baseline, baseline / seconds, bSame ? "same result" : "DIFFERENT RESULT");
+}
+
+/// Pseudo random words of a log like vocabulary: many duplicates and common prefixes.
+static std::vector<std::string> GetWords(std::size_t count, std::size_t distinct)
+{
+    static const char *prefixes[] = {"request", "response", "user", "session", "error", "host", "GET /api/v1/"};
+    std::vector<std::string> strWords;
+    strWords.reserve(count);
+    uint64_t seed = 88172645463325252ULL;
+    for(std::size_t ui = 0; ui < count; ++ui)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        strWords.push_back(prefixes[seed % 7] + std::to_string((seed >> 8) % distinct));
+    }
+    return strWords;
+}
+
+static bool BenchmarkRadix(void)
+{
+    const std::vector<std::string> strWords(GetWords(2000000, 900000));
+    const std::vector<std::string_view> words(strWords.begin(), strWords.end());
+    std::vector<std::string_view> radix;
+    std::vector<std::string_view> sorted;
+    const double seconds = Measure([&]()
+    {
+        radix = words;
+        simple_radix_sort::SortUnique(radix);
+    });
+    const double baseline = Measure([&]()
+    {
+        sorted = words;
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    });
+    Report("radix (2M string_view)", seconds, baseline, radix == sorted);
+    return radix == sorted;
+}
+
+/// \return <-- lines, of which only distinct ones are different, in a pseudo random order
+static std::vector<std::string> GetRepeatingLines(std::size_t count, std::size_t distinct, std::size_t wordsPerLine)
+{
+    const std::vector<std::string> strWords(GetWords(distinct * wordsPerLine, 1000));
+    std::vector<std::string> strTemplates(distinct);
+    for(std::size_t ui = 0; ui < strWords.size(); ++ui)
+    {
+        std::string &strTemplate = strTemplates[ui / wordsPerLine];
+        strTemplate += strTemplate.empty() ? "" : ((ui % 3 == 0) ? ",  " : " ");
+        strTemplate += strWords[ui];
+    }
+    std::vector<std::string> strLines;
+    strLines.reserve(count);
+    uint64_t seed = 2463534242ULL;
+    for(std::size_t ui = 0; ui < count; ++ui)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        strLines.push_back(strTemplates[seed % distinct]);
+    }
+    return strLines;
+}
+
+/// Tokenize the lines with a warm cache and without a cache.
+template <class Pred> static bool BenchmarkCacheCase(const char *name, const std::vector<std::string> &strLines, const Pred &roPred)
+{
+    simple_tokenize_cache<Pred> cache(64 * 1024 * 1024, 16, roPred);
+    std::vector<std::string> strResult;
+    uint64_t cachedTokens = 0;
+    uint64_t tokens = 0;
+    const double seconds = Measure([&]()
+    {
+        cachedTokens = 0;
+        for(std::size_t ui = 0; ui < strLines.size(); ++ui)
+        {
+            cache.Tokenize(strResult, strLines[ui]);
+            cachedTokens += strResult.size();
+        }
+    });
+    const double baseline = Measure([&]()
+    {
+        tokens = 0;
+        for(std::size_t ui = 0; ui < strLines.size(); ++ui)
+        {
+            simple_tokenize<Pred>::Tokenize(strResult, strLines[ui], roPred);
+            tokens += strResult.size();
+        }
+    });
+    Report(name, seconds, baseline, cachedTokens == tokens);
+    return cachedTokens == tokens;
+}
+
+static bool BenchmarkCache(void)
+{
+    // 1M lines of 500 distinct templates, only the first run of the cached loop misses
+    const std::vector<std::string> strShort(GetRepeatingLines(1000000, 500, 6));
+    const std::vector<std::string> strLong(GetRepeatingLines(200000, 500, 60));
+    bool bSame = BenchmarkCacheCase("cache (short, CIsSpace)", strShort, CIsSpace());
+    bSame = BenchmarkCacheCase("cache (long, CIsSpace)", strLong, CIsSpace()) && bSame;
+    bSame = BenchmarkCacheCase("cache (short, regex)", strShort, CIsRegex("[ ,]+")) && bSame;
+    bSame = BenchmarkCacheCase("cache (long, regex)", strLong, CIsRegex("[ ,]+")) && bSame;
+    return bSame;
+}
+
+/// \return <-- a log of six line types, whose parameters are pseudo random
+static std::vector<std::string> GetLogLines(std::size_t count)
+{
+    std::vector<std::string> strLines;
+    strLines.reserve(count);
+    uint64_t seed = 88172645463325252ULL;
+    for(std::size_t ui = 0; ui < count; ++ui)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        const std::string strIp = "10.0." + std::to_string((seed >> 8) % 256) + "." + std::to_string((seed >> 16) % 256);
+        const std::string strNumber = std::to_string((seed >> 24) % 100000);
+        switch(seed % 6)
+        {
+            case 0:
+                strLines.push_back("Connection from " + strIp + " closed after " + strNumber + " ms");
+                break;
+            case 1:
+                strLines.push_back("Accepted password for user" + std::to_string((seed >> 32) % 50) + " from " + strIp + " port " + strNumber + " ssh2");
+                break;
+            case 2:
+                strLines.push_back("GET /api/v1/items/" + strNumber + " HTTP/1.1 200 " + std::to_string((seed >> 40) % 5000));
+                break;
+            case 3:
+                strLines.push_back("Worker " + std::to_string((seed >> 32) % 16) + " finished job " + strNumber + " in " + std::to_string((seed >> 40) % 900) + " ms");
+                break;
+            case 4:
+                strLines.push_back("Disk usage of /dev/sda" + std::to_string((seed >> 32) % 4) + " is " + std::to_string((seed >> 40) % 100) + " percent");
+                break;
+            default:
+                strLines.push_back("Session " + strNumber + " opened for user root by uid=0");
+                break;
+        }
+    }
+    return strLines;
+}
+
+static bool BenchmarkTemplate(void)
+{
+    const std::vector<std::string> strLines(GetLogLines(1000000));
+    std::size_t templates = 0;
+    const double seconds = Measure([&]()
+    {
+        simple_log_template_miner<> miner;
+        for(std::size_t ui = 0; ui < strLines.size(); ++ui)
+        {
+            miner.Add(strLines[ui]);
+        }
+        templates = miner.GetNumberOfTemplates();
+    });
+    uint64_t tokens = 0;
+    const double baseline = Measure([&]()
+    {
+        tokens = 0;
+        for(std::size_t ui = 0; ui < strLines.size(); ++ui)
+        {
+            simple_tokenize<>::ForEachToken(strLines[ui], [&tokens](std::string_view)
+            {
+                ++tokens;
+            });
+        }
+    });
+    printf("%-28s %8.3f s  %5.2f M lines/s  tokenizing only %8.3f s  %zu templates\n"
+           , "template (1M lines)", seconds, static_cast<double>(strLines.size()) / seconds * 1e-6, baseline, templates);
+    return templates == 6;
+}
+
+int main(int argc, char *argv[])
+{
+    struct SBenchmark
+    {
+        const char *name;
+        bool (*run)(void);
+    };
+    static const SBenchmark benchmarks[] =
+    {
+        {"radix", BenchmarkRadix},
+        {"cache", BenchmarkCache},
+        {"template", BenchmarkTemplate}
+    };
+    bool bSuccess = true;
+    for(const SBenchmark &roBenchmark : benchmarks)
+    {
+        bool bSelected = (argc < 2);
+        for(int i = 1; i < argc; ++i)
+        {
+            bSelected = bSelected || strcmp(argv[i], roBenchmark.name) == 0;
+        }
+        if(bSelected)
+        {
+            bSuccess = roBenchmark.run() && bSuccess;
+        }
+    }
+    return bSuccess ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+/*!
+ * \file simple_queue.hpp
+ * \brief Bounded lock-free queues to connect the threads of a pipeline.
+ *  - simple_spsc_queue: one producer and one consumer thread
+ *  - simple_mpmc_queue: any number of producer and consumer threads
+ *
+ *  Both queues have a fixed capacity (rounded up to a power of two). A full queue
+ *  rejects TryPush(), so that a fast stage is slowed down to the pace of the next
+ *  one (backpressure). Push() and Pop() spin and yield until they succeed.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_QUEUE_HPP
+#define SIMPLE_QUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+/** \addtogroup simple_queue simple_queue
+ *  @{
+ */
+
+/// \brief Waiting strategy of the blocking queue operations:
+///  spin a few times, then give the core to other threads.
+class simple_queue_backoff
+{
+    public:
+        simple_queue_backoff(void) : m_spins(0) {}
+
+        void Wait(void)
+        {
+            if(++m_spins > 64)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        unsigned int m_spins;
+};
+
+/// \return the smallest power of two, which is not less than value (at least 2)
+inline std::size_t simple_queue_capacity(std::size_t value)
+{
+    std::size_t capacity = 2;
+    while(capacity < value)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+/// \brief Bounded queue for exactly one producer and one consumer thread.
+///  Each side keeps a copy of the index of the other side and reads the shared
+///  index only, in case the copy says that the queue is full or empty.
+template <class T> class simple_spsc_queue
+{
+    public:
+        explicit simple_spsc_queue(std::size_t capacity)
+            : m_items(simple_queue_capacity(capacity))
+            , m_mask(m_items.size() - 1)
+            , m_head(0)
+            , m_cachedTail(0)
+            , m_tail(0)
+            , m_cachedHead(0)
+        {}
+
+        simple_spsc_queue(const simple_spsc_queue &) = delete;
+        simple_spsc_queue& operator=(const simple_spsc_queue &) = delete;
+
+        /// \return false, in case the queue is full (producer only)
+        bool TryPush(const T &roItem)
+        {
+            const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+            if(tail - m_cachedHead == m_items.size())
+            {
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+                if(tail - m_cachedHead == m_items.size())
+                {
+                    return false;
+                }
+            }
+            m_items[tail & m_mask] = roItem;
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// \return false, in case the queue is empty (consumer only)
+        bool TryPop(T &roItem)
+        {
+            const std::size_t head = m_head.load(std::memory_order_relaxed);
+            if(head == m_cachedTail)
+            {
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+                if(head == m_cachedTail)
+                {
+                    return false;
+                }
+            }
+            roItem = m_items[head & m_mask];
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        void Push(const T &roItem)
+        {
+            simple_queue_backoff backoff;
+            while(!TryPush(roItem))
+            {
+                backoff.Wait();
+            }
+        }
+
+        void Pop(T &roItem)
+        {
+            simple_queue_backoff backoff;
+            while(!TryPop(roItem))
+            {
+                backoff.Wait();
+            }
+        }
+
+        /// \return the number of items, only a snapshot in case the queue is in use
+        std::size_t Size(void) const
+        {
+            // called from a third thread, the head may pass a tail, that was read before it
+            const std::size_t tail = m_tail.load(std::memory_order_acquire);
+            const std::size_t head = m_head.load(std::memory_order_acquire);
+            return (tail > head) ? std::min(tail - head, m_items.size()) : 0;
+        }
+
+        std::size_t Capacity(void) const
+        {
+            return m_items.size();
+        }
+
+    private:
+        std::vector<T>  m_items;
+        std::size_t     m_mask;
+        // consumer side
+        alignas(64) std::atomic<std::size_t> m_head;
+        std::size_t     m_cachedTail;
+        // producer side
+        alignas(64) std::atomic<std::size_t> m_tail;
+        std::size_t     m_cachedHead;
+};
+
+/// \brief Bounded queue for any number of producer and consumer threads.
+///  Every cell carries a sequence number, that tells whether it is free for the
+///  producer or filled for the consumer of a position (D. Vyukov's design).
+template <class T> class simple_mpmc_queue
+{
+    public:
+        explicit simple_mpmc_queue(std::size_t capacity)
+            : m_cells(simple_queue_capacity(capacity))
+            , m_mask(m_cells.size() - 1)
+            , m_head(0)
+            , m_tail(0)
+        {
+            for(std::size_t ui = 0; ui < m_cells.size(); ++ui)
+            {
+                m_cells[ui].sequence.store(ui, std::memory_order_relaxed);
+            }
+        }
+
+        simple_mpmc_queue(const simple_mpmc_queue &) = delete;
+        simple_mpmc_queue& operator=(const simple_mpmc_queue &) = delete;
+
+        /// \return false, in case the queue is full
+        bool TryPush(const T &roItem)
+        {
+            std::size_t pos = m_tail.load(std::memory_order_relaxed);
+            for(;;)
+            {
+                SCell &cell = m_cells[pos & m_mask];
+                const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+                if(difference == 0)
+                {
+                    if(m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.item = roItem;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if(difference < 0)
+                {
+                    // the consumer of the previous round did not free the cell yet
+                    return false;
+                }
+                else
+                {
+                    pos = m_tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /// \return false, in case the queue is empty
+        bool TryPop(T &roItem)
+        {
+            std::size_t pos = m_head.load(std::memory_order_relaxed);
+            for(;;)
+            {
+                SCell &cell = m_cells[pos & m_mask];
+                const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                const std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+                if(difference == 0)
+                {
+                    if(m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        roItem = cell.item;
+                        cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if(difference < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_head.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void Push(const T &roItem)
+        {
+            simple_queue_backoff backoff;
+            while(!TryPush(roItem))
+            {
+                backoff.Wait();
+            }
+        }
+
+        void Pop(T &roItem)
+        {
+            simple_queue_backoff backoff;
+            while(!TryPop(roItem))
+            {
+                backoff.Wait();
+            }
+        }
+
+        /// \return the number of items, only a snapshot in case the queue is in use
+        std::size_t Size(void) const
+        {
+            const std::size_t tail = m_tail.load(std::memory_order_acquire);
+            const std::size_t head = m_head.load(std::memory_order_acquire);
+            return (tail > head) ? tail - head : 0;
+        }
+
+        std::size_t Capacity(void) const
+        {
+            return m_cells.size();
+        }
+
+    private:
+        struct SCell
+        {
+            std::atomic<std::size_t> sequence;
+            T                        item;
+        };
+
+        std::vector<SCell> m_cells;
+        std::size_t        m_mask;
+        alignas(64) std::atomic<std::size_t> m_head;
+        alignas(64) std::atomic<std::size_t> m_tail;
+};
+
+/** @}*/
+
+#endif // SIMPLE_QUEUE_HPP
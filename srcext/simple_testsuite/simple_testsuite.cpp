@@ -9,15 +9,31 @@
 #include <functional>
 #include <vector>
 #include <iterator>
+#include <mutex>
 #include <sys/types.h>
 #include <cctype> // isalnum
 
 #include "simple_testsuite.hpp"
 #include "simple_shell_macros.hpp"
+#include "simple_thread_pool.hpp"
 
 std::ostringstream errout;
 std::ostringstream output;
 
+/// guards TestFixture::errmsg and the assert result recorder
+static std::mutex g_ResultMutex;
+
+/// \brief A stream buffer, which drops everything. std::cout and std::cerr write
+///  into it, while the fixtures run in parallel.
+class CNullStreamBuffer : public std::streambuf
+{
+    protected:
+        int overflow(int c)
+        {
+            return traits_type::not_eof(c);
+        }
+};
+
 simple_testsuite_settings::simple_testsuite_settings()
     : m_OutputMode(COLORED_OUTPUT)
 {}
@@ -214,13 +230,13 @@ const std::list<TestFixture *> & TestRegistry::tests(void) const
 
 std::ostringstream TestFixture::errmsg;
 simple_testsuite_assert_results TestFixture::m_SCAssertResultRecorder;
-size_t       TestFixture::countTests;
+std::atomic<size_t> TestFixture::countTests(0);
 bool               TestFixture::bRevertOrder = false;
-size_t TestFixture::fails_counter = 0;
-size_t TestFixture::assert_counter = 0;
-size_t TestFixture::todos_counter = 0;
-size_t TestFixture::m_assertCount = 0;
-size_t TestFixture::fails_counter_backup = 0;
+bool               TestFixture::bRunParallel = false;
+std::atomic<size_t> TestFixture::fails_counter(0);
+std::atomic<size_t> TestFixture::assert_counter(0);
+std::atomic<size_t> TestFixture::todos_counter(0);
+std::atomic<size_t> TestFixture::m_assertCount(0);
 simple_testsuite_settings TestFixture::m_Settings;
 
 
@@ -242,10 +258,14 @@ std::string simple_testsuite_settings::strGetOptionInformationString(void)
 }
 
 TestFixture::TestFixture(const std::string &_name)
-    : classname(_name)
+    : m_failsCount(0)
+    , m_failsReported(0)
+    , classname(_name)
     , bIsActivated(true)
     , m_LengthOfLinePtr(0)
+    , m_bBuffered(false)
     , m_bStopOnError(false)
+    , m_bSerial(false)
 {
     m_uiRandomSeed = static_cast<unsigned int>(time(NULL));
 #ifdef _WIN32
@@ -291,18 +311,18 @@ bool TestFixture::runTest(const char testname[])
     {
         if (m_Settings.bIsTXT2TagsOutputSet())
         {
-            std::cout << "| " << classname << "::" << testname << " | ";
+            Report() << "| " << classname << "::" << testname << " | ";
         }
         else
         {
             //if(m_strCurrentClassName != classname)
             //{
-            std::cout << classname << "::" << testname;
+            Report() << classname << "::" << testname;
             m_strCurrentClassName = classname;
             //}
             m_LengthOfLinePtr = classname.length() + 2 + std::string(testname).length();
         }
-        std::cout.flush();
+        Report().flush();
 
         ++countTests;
         return true;
@@ -316,11 +336,21 @@ bool TestFixture::runTest(const char testname[])
     return false;
 }
 
+std::ostream &TestFixture::Report(void) const
+{
+    if(m_bBuffered)
+    {
+        return m_report;
+    }
+    return std::cout;
+}
+
 void TestFixture::reportStatus(void) const
 {
     // report results
+    std::ostream &out = Report();
     // fill up with dots
-    const std::ios::fmtflags currentFormatFlags( cout.flags() );
+    const std::ios::fmtflags currentFormatFlags( out.flags() );
     if(!m_Settings.bIsTXT2TagsOutputSet())
     {
         int width = static_cast<int>(m_LengthOfLinePtr);
@@ -328,39 +358,39 @@ void TestFixture::reportStatus(void) const
         {
             width = 80 - static_cast<int>(m_LengthOfLinePtr);
         }
-        std::cout << std::setfill('.') << std::setw(width);
+        out << std::setfill('.') << std::setw(width);
     }
     if(m_Settings.bIsColoredOutputSet())
     {
-        if(fails_counter_backup == fails_counter)
+        if(m_failsReported == m_failsCount)
         {
-            COUT_LIGHT_GREEN(" [OK]");
+            out << COULOURIZE_LIGHT_GREEN(" [OK]");
         }
         else
         {
-            fails_counter_backup = fails_counter;
-            COUT_RED(" [NOK]");
+            m_failsReported = m_failsCount;
+            out << COULOURIZE_RED(" [NOK]");
         }
     }
     else // ASCII
     {
-        if(fails_counter_backup == fails_counter)
+        if(m_failsReported == m_failsCount)
         {
-            std::cout << " [OK]";
+            out << " [OK]";
         }
         else
         {
-            fails_counter_backup = fails_counter;
-            std::cout << " [NOK]";
+            m_failsReported = m_failsCount;
+            out << " [NOK]";
         }
     }
     if(m_Settings.bIsTXT2TagsOutputSet())
     {
-        std::cout << " | ";
+        out << " | ";
     }
-    std::cout << "\n";
+    out << "\n";
     // restore the format flags for the next run
-    std::cout.flags(currentFormatFlags);
+    out.flags(currentFormatFlags);
 }
 
 std::string TestFixture::strWriteStr(const std::string &str)
@@ -399,6 +429,8 @@ void TestFixture::vAssert(const char *filename, unsigned int linenr, bool condit
     if (!condition)
     {
         ++fails_counter;
+        ++m_failsCount;
+        std::lock_guard<std::mutex> lock(g_ResultMutex);
         errmsg << "Assertion failed in " << filename << " at line " << linenr << std::endl;
     }
 }
@@ -427,7 +459,9 @@ void TestFixture::assertEquals(const char * const cFilename, unsigned int uiLine
     if (strExpected != strActual)
     {
         ++fails_counter;
+        ++m_failsCount;
 
+        std::lock_guard<std::mutex> lock(g_ResultMutex);
         if(!m_SCAssertResultRecorder.bAddAssertResult(cFilename, uiLineNr, TestFixture::strWriteStr(strExpected),  TestFixture::strWriteStr(strActual)))
         {
             std::cerr << "### Internal error in TestFixture::assertEquals, please report\n";
@@ -486,7 +520,9 @@ void TestFixture::todoAssertEquals_bool(const char * const filename, const unsig
 void TestFixture::assertThrowFail(const char * const cFileName, unsigned int uiLineNr)
 {
     ++fails_counter;
+    ++m_failsCount;
 
+    std::lock_guard<std::mutex> lock(g_ResultMutex);
     errmsg << "Assertion failed in " << cFileName << " at line " << uiLineNr << std::endl
            << "The expected exception was not thrown" << std::endl;
 }
@@ -544,17 +580,31 @@ size_t TestFixture::runTests(const char cmd[])
         TestRegistry::theInstance().RevertListOrder();
     }
     const std::list<TestFixture *> &tests = TestRegistry::theInstance().tests();
+    std::vector<TestFixture *> selected;
     for (std::list<TestFixture *>::const_iterator it = tests.begin(); it != tests.end(); ++it)
     {
         // perform default processing: by default a test is set as activated
         if ((strClassName.empty() || (*it)->classname == strClassName) && (*it)->bIsActivated)
         {
-            (*it)->run(testname);
+            selected.push_back(*it);
         }
         // perform specific tests that are explicitly activated
         else if ( ((*it)->classname == strClassName) && !(*it)->bIsActivated)
         {
-            (*it)->run(testname);
+            selected.push_back(*it);
+        }
+    }
+
+    // a single test case reports the skipped ones, it runs on its own
+    if (bRunParallel && selected.size() > 1 && testname.empty() && simple_thread_pool::GetInstance().GetNumberOfThreads() > 1)
+    {
+        vRunParallel(selected, testname);
+    }
+    else
+    {
+        for (size_t ui = 0; ui < selected.size(); ++ui)
+        {
+            selected[ui]->run(testname);
         }
     }
 
@@ -563,6 +613,56 @@ size_t TestFixture::runTests(const char cmd[])
     return fails_counter;
 }
 
+void TestFixture::vRunParallel(const std::vector<TestFixture *> &tests, const std::string &testname)
+{
+    // swapping the stream buffers per test case is not thread safe, the output of the tests is dropped
+    CNullStreamBuffer nullBuffer;
+    std::streambuf *pBackupCoutStream = std::cout.rdbuf(&nullBuffer);
+    std::streambuf *pBackupCerrStream = std::cerr.rdbuf(&nullBuffer);
+    try
+    {
+        simple_task_group group(simple_thread_pool::GetInstance());
+        for (size_t ui = 0; ui < tests.size(); ++ui)
+        {
+            TestFixture *pTest = tests[ui];
+            if (pTest->m_bSerial)
+            {
+                continue;
+            }
+            pTest->m_bBuffered = true;
+            pTest->m_report.str("");
+            group.Run([pTest, &testname]
+            {
+                pTest->run(testname);
+            });
+        }
+        group.Wait();
+    }
+    catch (...)
+    {
+        std::cout.rdbuf(pBackupCoutStream);
+        std::cerr.rdbuf(pBackupCerrStream);
+        throw;
+    }
+    std::cout.rdbuf(pBackupCoutStream);
+    std::cerr.rdbuf(pBackupCerrStream);
+
+    // print the status lines in the order of the registry, the serial fixtures run
+    // after the parallel ones are finished
+    for (size_t ui = 0; ui < tests.size(); ++ui)
+    {
+        if (tests[ui]->m_bSerial)
+        {
+            tests[ui]->run(testname);
+            continue;
+        }
+        tests[ui]->m_bBuffered = false;
+        std::cout << tests[ui]->m_report.str();
+        tests[ui]->m_report.str("");
+    }
+    std::cout.flush();
+}
+
 void TestFixture::printFinalReport(void)
 {
     // define output text here
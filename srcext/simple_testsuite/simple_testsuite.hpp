@@ -10,6 +10,7 @@
 // enforce posix compliance for tested code
 #define _POSIX_SOURCE 1
 
+#include <atomic>
 #include <sstream>
 #include <iostream>
 #include <iomanip>
@@ -100,7 +101,7 @@ class simple_testsuite_assert_results
             {
                 C = new size_t*[m + 1];
             }
-            catch(std::bad_alloc)
+            catch(const std::bad_alloc &)
             {
                 return NULL;
             }
@@ -111,7 +112,7 @@ class simple_testsuite_assert_results
                     C[i] = new size_t[n + 1];
                 }
             }
-            catch(std::bad_alloc)
+            catch(const std::bad_alloc &)
             {
                 delete [] C;
                 return NULL;
@@ -210,11 +211,19 @@ class TestFixture
     private:
         static std::ostringstream errmsg;
         static simple_testsuite_assert_results m_SCAssertResultRecorder;
-        static size_t countTests;
-        static size_t fails_counter;
-        static size_t assert_counter;
-        static size_t todos_counter;
-        static size_t fails_counter_backup;
+        // the counters are shared by the fixtures, which run in parallel
+        static std::atomic<size_t> countTests;
+        static std::atomic<size_t> fails_counter;
+        static std::atomic<size_t> assert_counter;
+        static std::atomic<size_t> todos_counter;
+        /// the failed asserts of this fixture and their number at the last status report
+        size_t m_failsCount;
+        mutable size_t m_failsReported;
+        /// the status lines are collected here, in case the fixture runs in parallel to others
+        mutable std::ostringstream m_report;
+
+        std::ostream &Report(void) const;
+        static void vRunParallel(const std::vector<TestFixture *> &tests, const std::string &testname);
 
     public:
         std::string classname;
@@ -223,9 +232,14 @@ class TestFixture
         bool bIsActivated;
         size_t m_LengthOfLinePtr;
         std::string m_strCurrentClassName;
-        static size_t m_assertCount;
+        static std::atomic<size_t> m_assertCount;
+        /// true, while the fixture runs in parallel to others
+        bool m_bBuffered;
         /// \brief stop on first error [default = false]
         bool m_bStopOnError;
+        /// \brief never run in parallel to other fixtures, e.g. because the fixture
+        /// checks process-global state [default = false]
+        bool m_bSerial;
 
         /// Generate a random number of type T
         /// \return <-- a random number
@@ -330,9 +344,21 @@ class TestFixture
         // -------------------------------------------------------------
         static void vExcludeTest(const std::string &strNameOfTest);
 
+        // -------------------------------------------------------------
+        /// Run the registered tests one after the other. With bRunParallel,
+        /// the fixtures are distributed over the threads of
+        /// simple_thread_pool::GetInstance() (see SIMPLE_THREAD_POOL_THREADS),
+        /// their status lines are printed in the order of the registry afterwards.
+        //
+        /// \param cmd --> NULL, the name of a fixture or fixture::test
+        /// \return <-- the number of failed asserts
+        // -------------------------------------------------------------
         static size_t runTests(const char cmd[]);
 
         static bool bRevertOrder;
+        /// run the fixtures as tasks of simple_thread_pool [default = false]. Fixtures, which
+        /// check process-global state (e.g. the counters of simple_tokenize_stats), set m_bSerial.
+        static bool bRunParallel;
 
         static void vSetConfiguration(const simple_testsuite_settings &Settings);
 
@@ -393,7 +419,8 @@ class TestRegistry
 #define CLEAR_COUT_STREAM {output.str("");}
 #define CLEAR_CERR_STREAM {errout.str("");}
 
-#define TEST_CASE( NAME )                           { if ( runTest(#NAME) ) {START_LISTEN_ALL  NAME(); END_LISTEN_ALL reportStatus();} }
+// the output of parallel fixtures is dropped by runTests, the streams are not swapped per test then
+#define TEST_CASE( NAME )                           { if ( runTest(#NAME) ) { if ( m_bBuffered ) { NAME(); } else { START_LISTEN_ALL  NAME(); END_LISTEN_ALL } reportStatus();} }
 #define ASSERT( CONDITION )                         vAssert(__FILE__, __LINE__, CONDITION)
 
 #define ASSERT_EQUALS( EXPECTED , ACTUAL )          { assertEquals(__FILE__, __LINE__, EXPECTED, ACTUAL); ++m_assertCount; }
@@ -30,6 +30,7 @@ int main(const int argc, const char *argv[])
     const std::string strRevertOrderOption    = "--revert-order";
     const std::string strExcludeOption        = "--exclude=";
     const std::string strSeqOption            = "--seq";
+    const std::string strParallelOption       = "--parallel";
     const std::string strShowTestsOption      = "--show-tests";
     const std::string strNumberOfTestsOption  = "--show-number-of-tests";
     std::vector<std::string> TestQueue;
@@ -63,6 +64,8 @@ int main(const int argc, const char *argv[])
                         std::cout << "\t   In order to exclude several tests, separate them \n";
                         std::cout << "\t   using a ',' operator e.g.: --exclude=Test1,Test2,Test3\n";
                         std::cout << "\t " << strSeqOption << ": runs each test, but in sequential order\n";
+                        std::cout << "\t " << strParallelOption << ": runs the tests on the threads of simple_thread_pool\n";
+                        std::cout << "\t   (SIMPLE_THREAD_POOL_THREADS), the output of the tests is dropped\n";
                         std::cout << "\t " << strShowTestsOption << ": Prints a list of available tests\n";
                         std::cout << "\t " << strNumberOfTestsOption << ": Prints the current number of registered \n";
                         std::cout << "\t   testclasses\n";
@@ -102,6 +105,12 @@ int main(const int argc, const char *argv[])
                             bRundSequential = true;
                             break;
                         }
+                        else if(strncmp(option.c_str(), strParallelOption.c_str(), strParallelOption.size()) == 0U
+                                && option.size() == strParallelOption.size())
+                        {
+                            TestFixture::bRunParallel = true;
+                            break;
+                        }
                         else if(strncmp(option.c_str(), strRevertOrderOption.c_str(), strRevertOrderOption.size()) == 0U
                                 && option.size() == strRevertOrderOption.size())
                         {
@@ -0,0 +1,580 @@
+/*!
+ * \file simple_thread_pool.hpp
+ * \brief A work-stealing thread pool.
+ *  - simple_work_stealing_deque: Chase-Lev deque, the owner pushes and pops at
+ *    the bottom, other threads steal from the top
+ *  - simple_thread_pool: one deque per worker, ParallelFor() with adaptive grain size
+ *  - simple_task_group: a set of tasks, which are waited for together, the first
+ *    exception of a task is rethrown by Wait()
+ *
+ *  The number of threads of the shared instance is read from the environment
+ *  variable SIMPLE_THREAD_POOL_THREADS (default: the number of cores).
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_THREAD_POOL_HPP
+#define SIMPLE_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+/** \addtogroup simple_thread_pool simple_thread_pool
+ *  @{
+ */
+
+/// \brief Chase-Lev work-stealing deque of pointers.
+///  Push() and Pop() may only be called by the owning thread, Steal() by any thread.
+///  The array grows, when it is full. Old arrays are kept until the deque is destroyed,
+///  because a thief may still read from them.
+template <class T> class simple_work_stealing_deque
+{
+    public:
+        explicit simple_work_stealing_deque(std::size_t capacity = 256)
+            : m_top(0)
+            , m_bottom(0)
+        {
+            std::size_t size = 2;
+            while(size < capacity)
+            {
+                size <<= 1;
+            }
+            m_arrays.push_back(std::unique_ptr<CArray>(new CArray(size)));
+            m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+        }
+
+        simple_work_stealing_deque(const simple_work_stealing_deque &) = delete;
+        simple_work_stealing_deque& operator=(const simple_work_stealing_deque &) = delete;
+
+        /// Add an item at the bottom (owner only).
+        void Push(T *pItem)
+        {
+            const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            const int64_t top    = m_top.load(std::memory_order_acquire);
+            CArray *pArray = m_array.load(std::memory_order_relaxed);
+            if(bottom - top > static_cast<int64_t>(pArray->mask))
+            {
+                pArray = Grow(pArray, top, bottom);
+            }
+            pArray->Put(bottom, pItem);
+            m_bottom.store(bottom + 1, std::memory_order_release);
+        }
+
+        /// Take the item, that was pushed last (owner only).
+        /// \return <-- NULL, in case the deque is empty
+        T *Pop(void)
+        {
+            const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+            CArray *pArray = m_array.load(std::memory_order_relaxed);
+            // the store has to be visible to the thieves, before top is read
+            m_bottom.store(bottom, std::memory_order_seq_cst);
+            int64_t top = m_top.load(std::memory_order_seq_cst);
+            if(top > bottom)
+            {
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+                return NULL;
+            }
+            T *pItem = pArray->Get(bottom);
+            if(top == bottom)
+            {
+                // the last item, race against the thieves
+                if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    pItem = NULL;
+                }
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return pItem;
+        }
+
+        /// Take the item, that was pushed first (any thread).
+        /// \return <-- NULL, in case the deque is empty or another thread was faster
+        T *Steal(void)
+        {
+            int64_t top = m_top.load(std::memory_order_seq_cst);
+            const int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+            if(top >= bottom)
+            {
+                return NULL;
+            }
+            T *pItem = m_array.load(std::memory_order_acquire)->Get(top);
+            if(!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return NULL;
+            }
+            return pItem;
+        }
+
+        /// \return <-- the number of items, the result is a snapshot
+        std::size_t Size(void) const
+        {
+            const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+            const int64_t top    = m_top.load(std::memory_order_relaxed);
+            return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+        }
+
+    private:
+
+        struct CArray
+        {
+            explicit CArray(std::size_t size)
+                : items(new std::atomic<T*>[size])
+                , mask(size - 1)
+            {}
+
+            T *Get(int64_t index) const
+            {
+                return items[static_cast<std::size_t>(index) & mask].load(std::memory_order_relaxed);
+            }
+
+            void Put(int64_t index, T *pItem)
+            {
+                items[static_cast<std::size_t>(index) & mask].store(pItem, std::memory_order_relaxed);
+            }
+
+            std::unique_ptr<std::atomic<T*>[]> items;
+            std::size_t mask;
+        };
+
+        CArray *Grow(CArray *pOld, int64_t top, int64_t bottom)
+        {
+            m_arrays.push_back(std::unique_ptr<CArray>(new CArray((pOld->mask + 1) * 2)));
+            CArray *pNew = m_arrays.back().get();
+            for(int64_t index = top; index < bottom; ++index)
+            {
+                pNew->Put(index, pOld->Get(index));
+            }
+            m_array.store(pNew, std::memory_order_release);
+            return pNew;
+        }
+
+        std::atomic<int64_t>                 m_top;
+        std::atomic<int64_t>                 m_bottom;
+        std::atomic<CArray*>                 m_array;
+        /// the current array and all arrays before, only touched by the owner
+        std::vector< std::unique_ptr<CArray> > m_arrays;
+};
+
+class simple_task_group;
+
+/// \brief A pool of worker threads, each with its own deque. A worker runs the tasks
+///  of its own deque in LIFO order (the data is still in the cache) and steals the
+///  oldest task of another worker, when it has nothing to do. Tasks of threads outside
+///  of the pool are put into a shared queue.
+///
+///  A thread, that waits for a task group, runs tasks in the meantime. Therefore a pool
+///  with n threads starts n - 1 workers, the waiting thread is the n-th one.
+///  A pool with one thread starts no worker at all and runs every task in Wait().
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         std::vector<std::size_t> sizes(lines.size());
+///         simple_thread_pool::GetInstance().ParallelFor(0, lines.size(), [&](std::size_t ui)
+///         {
+///             sizes[ui] = lines[ui].size();
+///         });
+///  \endcode
+class simple_thread_pool
+{
+    public:
+        typedef std::function<void(void)> task;
+
+        /// \param threads --> the number of threads, 0 means GetDefaultNumberOfThreads()
+        explicit simple_thread_pool(std::size_t threads = 0)
+            : m_threads(threads == 0 ? GetDefaultNumberOfThreads() : threads)
+            , m_queued(0)
+            , m_sleeping(0)
+            , m_bStop(false)
+        {
+            for(std::size_t ui = 1; ui < m_threads; ++ui)
+            {
+                m_deques.push_back(std::unique_ptr< simple_work_stealing_deque<task> >(new simple_work_stealing_deque<task>()));
+            }
+            for(std::size_t ui = 1; ui < m_threads; ++ui)
+            {
+                m_workers.push_back(std::thread(&simple_thread_pool::WorkerLoop, this, ui - 1));
+            }
+        }
+
+        simple_thread_pool(const simple_thread_pool &) = delete;
+        simple_thread_pool& operator=(const simple_thread_pool &) = delete;
+
+        /// Stop the workers. Tasks, which have not been started yet, are destroyed without being run.
+        ~simple_thread_pool(void)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_bStop = true;
+            }
+            m_wakeUp.notify_all();
+            for(std::size_t ui = 0; ui < m_workers.size(); ++ui)
+            {
+                m_workers[ui].join();
+            }
+            task *pTask = NULL;
+            while((pTask = TakeTask()) != NULL)
+            {
+                delete pTask;
+            }
+        }
+
+        /// \return <-- the number of threads, the thread waiting for a task group included
+        std::size_t GetNumberOfThreads(void) const
+        {
+            return m_threads;
+        }
+
+        /// \return <-- SIMPLE_THREAD_POOL_THREADS, or the number of cores in case it is not set
+        static std::size_t GetDefaultNumberOfThreads(void)
+        {
+            const char *pValue = getenv("SIMPLE_THREAD_POOL_THREADS");
+            if(pValue != NULL)
+            {
+                const unsigned long value = strtoul(pValue, NULL, 10);
+                if(value > 0)
+                {
+                    return static_cast<std::size_t>(value);
+                }
+            }
+            const unsigned int cores = std::thread::hardware_concurrency();
+            return cores > 0 ? cores : 1;
+        }
+
+        /// \return <-- the pool, which is shared by the library
+        static simple_thread_pool &GetInstance(void)
+        {
+            static simple_thread_pool pool;
+            return pool;
+        }
+
+        /// Call f(index) for every index in [begin, end), the calls are distributed over the threads.
+        /// A range is split in halves, as long as it is longer than the grain size and fewer tasks are
+        /// queued than there are threads. Hence the ranges are large, when all threads are busy, and
+        /// small, when threads are idle. Returns, when all calls are done, the first exception is rethrown.
+        /// \param minGrain --> the smallest number of indices of a task, e.g. to avoid tasks for cheap calls
+        template <class F> void ParallelFor(std::size_t begin, std::size_t end, const F &f, std::size_t minGrain = 1);
+
+        /// Run a single task of the pool in the calling thread.
+        /// \return <-- false, in case there is no task
+        bool RunPendingTask(void)
+        {
+            task *pTask = TakeTask();
+            if(pTask == NULL)
+            {
+                return false;
+            }
+            (*pTask)();
+            delete pTask;
+            return true;
+        }
+
+    private:
+        friend class simple_task_group;
+
+        template <class F> void ForRange(simple_task_group &roGroup, std::size_t begin, std::size_t end, const F &f, std::size_t grain);
+
+        /// \return <-- the index of the deque of the calling thread, or -1 for threads outside of the pool
+        int GetWorkerIndex(void) const
+        {
+            return (CurrentPool() == this) ? CurrentWorkerIndex() : -1;
+        }
+
+        static const simple_thread_pool *&CurrentPool(void)
+        {
+            static thread_local const simple_thread_pool *pPool = NULL;
+            return pPool;
+        }
+
+        static int &CurrentWorkerIndex(void)
+        {
+            static thread_local int index = -1;
+            return index;
+        }
+
+        void Submit(task *pTask)
+        {
+            // counted before it is visible, so that the counter never drops below zero
+            m_queued.fetch_add(1, std::memory_order_seq_cst);
+            const int index = GetWorkerIndex();
+            if(index >= 0)
+            {
+                m_deques[static_cast<std::size_t>(index)]->Push(pTask);
+            }
+            else
+            {
+                std::lock_guard<std::mutex> lock(m_sharedMutex);
+                m_shared.push_back(pTask);
+            }
+            // a worker, which goes to sleep, increments m_sleeping before it checks m_queued
+            if(m_sleeping.load(std::memory_order_seq_cst) > 0)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_wakeUp.notify_one();
+            }
+        }
+
+        task *TakeTask(void)
+        {
+            if(m_queued.load(std::memory_order_relaxed) == 0)
+            {
+                return NULL;
+            }
+            const int index = GetWorkerIndex();
+            task *pTask = NULL;
+            if(index >= 0)
+            {
+                pTask = m_deques[static_cast<std::size_t>(index)]->Pop();
+            }
+            if(pTask == NULL)
+            {
+                std::lock_guard<std::mutex> lock(m_sharedMutex);
+                if(!m_shared.empty())
+                {
+                    pTask = m_shared.front();
+                    m_shared.pop_front();
+                }
+            }
+            // steal from the others, starting behind the own deque
+            const std::size_t count = m_deques.size();
+            for(std::size_t ui = 0; pTask == NULL && ui < count; ++ui)
+            {
+                pTask = m_deques[(static_cast<std::size_t>(index + 1) + ui) % count]->Steal();
+            }
+            if(pTask != NULL)
+            {
+                m_queued.fetch_sub(1, std::memory_order_relaxed);
+            }
+            return pTask;
+        }
+
+        void WorkerLoop(std::size_t index)
+        {
+            CurrentPool()        = this;
+            CurrentWorkerIndex() = static_cast<int>(index);
+            unsigned int idle = 0;
+            while(true)
+            {
+                if(RunPendingTask())
+                {
+                    idle = 0;
+                    continue;
+                }
+                if(++idle < 64)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+                while(!m_bStop && m_queued.load(std::memory_order_seq_cst) == 0)
+                {
+                    m_wakeUp.wait(lock);
+                }
+                m_sleeping.fetch_sub(1, std::memory_order_seq_cst);
+                if(m_bStop)
+                {
+                    return;
+                }
+                idle = 0;
+            }
+        }
+
+        const std::size_t                                                 m_threads;
+        std::vector< std::unique_ptr< simple_work_stealing_deque<task> > > m_deques;
+        std::vector<std::thread>                                          m_workers;
+        /// the tasks of threads outside of the pool
+        std::deque<task*>                                                 m_shared;
+        std::mutex                                                        m_sharedMutex;
+        /// the number of tasks, which have been submitted, but not taken
+        std::atomic<std::size_t>                                          m_queued;
+        std::atomic<std::size_t>                                          m_sleeping;
+        std::mutex                                                        m_mutex;
+        std::condition_variable                                           m_wakeUp;
+        bool                                                              m_bStop;
+};
+
+/// \brief A set of tasks, which are waited for together. Tasks may add further tasks
+///  to the group. In case a task throws, the tasks of the group, which have not started
+///  yet, are skipped and Wait() rethrows the first exception.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_task_group group(simple_thread_pool::GetInstance());
+///         group.Run([&]{ ParseHeader(); });
+///         group.Run([&]{ ParseBody(); });
+///         group.Wait();
+///  \endcode
+class simple_task_group
+{
+    public:
+        explicit simple_task_group(simple_thread_pool &roPool)
+            : m_roPool(roPool)
+            , m_pending(0)
+            , m_bFailed(false)
+        {}
+
+        simple_task_group(const simple_task_group &) = delete;
+        simple_task_group& operator=(const simple_task_group &) = delete;
+
+        /// Waits for the tasks, an exception is not rethrown here.
+        ~simple_task_group(void)
+        {
+            WaitForTasks();
+        }
+
+        /// Add a task to the group.
+        template <class F> void Run(F f)
+        {
+            m_pending.fetch_add(1, std::memory_order_relaxed);
+            m_roPool.Submit(new simple_thread_pool::task([this, f]()
+            {
+                if(!m_bFailed.load(std::memory_order_relaxed))
+                {
+                    try
+                    {
+                        f();
+                    }
+                    catch(...)
+                    {
+                        SetException(std::current_exception());
+                    }
+                }
+                m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            }));
+        }
+
+        /// Run tasks of the pool, until every task of the group is done.
+        /// \exception the first exception thrown by a task of the group
+        void Wait(void)
+        {
+            WaitForTasks();
+            if(m_bFailed.load(std::memory_order_relaxed))
+            {
+                std::exception_ptr pException;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    pException.swap(m_pException);
+                }
+                m_bFailed.store(false, std::memory_order_relaxed);
+                std::rethrow_exception(pException);
+            }
+        }
+
+        /// \return <-- true, in case a task of the group has thrown
+        bool IsFailed(void) const
+        {
+            return m_bFailed.load(std::memory_order_relaxed);
+        }
+
+    private:
+        friend class simple_thread_pool;
+
+        void SetException(std::exception_ptr pException)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if(!m_pException)
+            {
+                m_pException = pException;
+            }
+            m_bFailed.store(true, std::memory_order_relaxed);
+        }
+
+        void WaitForTasks(void)
+        {
+            unsigned int idle = 0;
+            while(m_pending.load(std::memory_order_acquire) != 0)
+            {
+                if(m_roPool.RunPendingTask())
+                {
+                    idle = 0;
+                }
+                else if(++idle > 64)
+                {
+                    // the remaining tasks run on other threads
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        simple_thread_pool       &m_roPool;
+        std::atomic<std::size_t> m_pending;
+        std::atomic<bool>        m_bFailed;
+        std::mutex               m_mutex;
+        std::exception_ptr       m_pException;
+};
+
+template <class F> inline void simple_thread_pool::ParallelFor(std::size_t begin, std::size_t end, const F &f, std::size_t minGrain)
+{
+    if(end <= begin)
+    {
+        return;
+    }
+    const std::size_t size  = end - begin;
+    std::size_t       grain = size / (m_threads * 8);
+    if(grain < minGrain)
+    {
+        grain = minGrain;
+    }
+    if(grain == 0)
+    {
+        grain = 1;
+    }
+    if(m_threads == 1 || size <= grain)
+    {
+        for(; begin != end; ++begin)
+        {
+            f(begin);
+        }
+        return;
+    }
+    simple_task_group group(*this);
+    try
+    {
+        ForRange(group, begin, end, f, grain);
+    }
+    catch(...)
+    {
+        // the tasks refer to f, they have to be done before leaving
+        group.SetException(std::current_exception());
+    }
+    group.Wait();
+}
+
+template <class F> inline void simple_thread_pool::ForRange(simple_task_group &roGroup, std::size_t begin, std::size_t end, const F &f, std::size_t grain)
+{
+    while(end - begin > grain && !roGroup.IsFailed())
+    {
+        if(m_queued.load(std::memory_order_relaxed) < m_threads)
+        {
+            // threads may be idle, give the upper half away
+            const std::size_t middle = begin + (end - begin) / 2;
+            roGroup.Run([this, &roGroup, middle, end, &f, grain]
+            {
+                ForRange(roGroup, middle, end, f, grain);
+            });
+            end = middle;
+            continue;
+        }
+        for(const std::size_t stop = begin + grain; begin != stop; ++begin)
+        {
+            f(begin);
+        }
+    }
+    for(; begin != end; ++begin)
+    {
+        f(begin);
+    }
+}
+
+/** @}*/
+
+#endif // SIMPLE_THREAD_POOL_HPP
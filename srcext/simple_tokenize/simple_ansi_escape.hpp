@@ -0,0 +1,532 @@
+/*!
+ * \file simple_ansi_escape.hpp
+ * \brief Removal and parsing of the escape sequences, which are written by
+ *  simple_shell_macros.hpp (e.g. colours), and the display width of a line.
+ *  - simple_ansi_parser:   a resumable state machine, the text between the
+ *                          sequences is found with simple_simd::FindByte
+ *  - simple_ansi_sequence: a parsed sequence, e.g. the parameters of a CSI sequence
+ *  - simple_display_width: the number of terminal columns of visible text
+ *
+ *  The header is part of simple_tokenize, since it is built on simple_simd.hpp.
+ *  It does not depend on simple_shell_macros.
+ *
+ *   References:
+ *       - ECMA-48, 5.4 control sequences
+ *       - HTTP://vt100.net/emu/dec_ansi_parser
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_ANSI_ESCAPE_HPP
+#define SIMPLE_ANSI_ESCAPE_HPP
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+#include "simple_simd.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief A sequence, that was found by simple_ansi_parser.
+struct simple_ansi_sequence
+{
+    enum EType
+    {
+        /// ESC [ parameters intermediates final, e.g. "\033[22;31m"
+        CSI,
+        /// ESC intermediates final, e.g. "\033(B"
+        ESCAPE,
+        /// a string terminated by BEL or ESC \ (OSC, DCS, SOS, PM, APC), e.g. a window title.
+        /// A string without terminator ends at the next newline and is not reported.
+        STRING
+    };
+
+    enum { MAX_PARAMS = 16 };
+
+    simple_ansi_sequence(void)
+        : type(CSI)
+        , final(0)
+        , prefix(0)
+        , intermediate(0)
+        , count(0)
+    {}
+
+    /// \return <-- the parameter at index, or defaultValue, in case it is empty or missing
+    int GetParam(unsigned int index, int defaultValue = 0) const
+    {
+        return (index < count && params[index] >= 0) ? params[index] : defaultValue;
+    }
+
+    EType        type;
+    /// the final byte, for a STRING the introducer (e.g. ']' for OSC)
+    char         final;
+    /// the private marker of a CSI sequence ('<', '=', '>' or '?') or 0
+    char         prefix;
+    /// the last intermediate byte (0x20-0x2F) or 0
+    char         intermediate;
+    /// the number of parameters, parameters beyond MAX_PARAMS are dropped
+    unsigned int count;
+    /// the parameters, an empty parameter is -1
+    int          params[MAX_PARAMS];
+};
+
+/// \brief Counts the terminal columns of visible text: ASCII characters and most
+///  other code points are one column, East Asian wide characters and emoji are two,
+///  combining marks and control characters are none, a tab advances to the next
+///  multiple of 8. Blocks of 16 printable ASCII characters are counted at once.
+class simple_display_width
+{
+    public:
+        simple_display_width(void) : m_width(0) {}
+
+        /// Add the width of text, which must not contain escape sequences.
+        void Add(const char *p, std::size_t size)
+        {
+            const char *it  = p;
+            const char *end = p + size;
+            while(end - it >= 16)
+            {
+                if((simple_simd::HighBitMask16(it) | simple_simd::RangeMask16(it, 0x00, 0x1F) | simple_simd::MatchMask16(it, 0x7F)) == 0)
+                {
+                    m_width += 16;
+                    it      += 16;
+                    continue;
+                }
+                // a character may end behind the block
+                for(const char *blockEnd = it + 16; it < blockEnd;)
+                {
+                    it = Step(it, end);
+                }
+            }
+            while(it < end)
+            {
+                it = Step(it, end);
+            }
+        }
+
+        std::size_t Get(void) const
+        {
+            return m_width;
+        }
+
+        void Reset(void)
+        {
+            m_width = 0;
+        }
+
+        /// \return <-- the number of columns of a code point (0, 1 or 2)
+        static unsigned int GetCodePointWidth(uint32_t codePoint)
+        {
+            static const uint32_t zeroWidth[][2] =
+            {
+                {0x0080, 0x009F}, {0x0300, 0x036F}, {0x0483, 0x0489}, {0x0591, 0x05BD},
+                {0x1AB0, 0x1AFF}, {0x1DC0, 0x1DFF}, {0x200B, 0x200F}, {0x2028, 0x202E},
+                {0x2060, 0x2064}, {0x20D0, 0x20FF}, {0xFE00, 0xFE0F}, {0xFE20, 0xFE2F},
+                {0xFEFF, 0xFEFF}
+            };
+            static const uint32_t doubleWidth[][2] =
+            {
+                {0x1100, 0x115F}, {0x2E80, 0x303E}, {0x3041, 0x33FF}, {0x3400, 0x4DBF},
+                {0x4E00, 0x9FFF}, {0xA000, 0xA4CF}, {0xAC00, 0xD7A3}, {0xF900, 0xFAFF},
+                {0xFE30, 0xFE4F}, {0xFF00, 0xFF60}, {0xFFE0, 0xFFE6}, {0x1F300, 0x1F64F},
+                {0x1F900, 0x1F9FF}, {0x20000, 0x2FFFD}, {0x30000, 0x3FFFD}
+            };
+            if(codePoint < 0x0300 && codePoint >= 0x00A0)
+            {
+                return 1;
+            }
+            for(std::size_t ui = 0; ui < sizeof(zeroWidth) / sizeof(zeroWidth[0]); ++ui)
+            {
+                if(codePoint >= zeroWidth[ui][0] && codePoint <= zeroWidth[ui][1])
+                {
+                    return 0;
+                }
+            }
+            for(std::size_t ui = 0; ui < sizeof(doubleWidth) / sizeof(doubleWidth[0]); ++ui)
+            {
+                if(codePoint >= doubleWidth[ui][0] && codePoint <= doubleWidth[ui][1])
+                {
+                    return 2;
+                }
+            }
+            return 1;
+        }
+
+    private:
+
+        /// Count the character at it.
+        /// \return <-- the position behind the character
+        const char *Step(const char *it, const char *end)
+        {
+            const unsigned char c = static_cast<unsigned char>(*it);
+            if(c < 0x80)
+            {
+                if(c == '\t')
+                {
+                    m_width = (m_width / 8 + 1) * 8;
+                }
+                else if(c >= 0x20 && c != 0x7F)
+                {
+                    ++m_width;
+                }
+                return it + 1;
+            }
+            if(c < 0xC0)
+            {
+                // a continuation byte without a leading byte
+                return it + 1;
+            }
+            const std::size_t length = (c < 0xE0) ? 2 : (c < 0xF0) ? 3 : (c < 0xF8) ? 4 : 0;
+            uint32_t codePoint = c & ((length == 2) ? 0x1FU : (length == 3) ? 0x0FU : 0x07U);
+            bool bValid = length != 0 && static_cast<std::size_t>(end - it) >= length;
+            for(std::size_t ui = 1; bValid && ui < length; ++ui)
+            {
+                const unsigned char next = static_cast<unsigned char>(it[ui]);
+                bValid = (next & 0xC0) == 0x80;
+                codePoint = (codePoint << 6) | (next & 0x3FU);
+            }
+            if(!bValid)
+            {
+                // shown as a replacement character
+                ++m_width;
+                return it + 1;
+            }
+            m_width += GetCodePointWidth(codePoint);
+            return it + length;
+        }
+
+        std::size_t m_width;
+};
+
+/// \brief A parser for the escape sequences of a terminal. The text between the sequences
+///  is passed on in pieces as large as possible, the bytes of the sequences are never copied.
+///  Since the state is kept between the calls, the input can be processed in blocks, that
+///  cut through sequences. Control characters other than ESC are part of the text.
+///  A string sequence (e.g. OSC), that is not terminated, is dropped up to the end of
+///  its line, so a broken sequence does not swallow the rest of the input.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_ansi_parser parser;
+///         std::string strPlain;
+///         while(ReadBlock(block))
+///         {
+///             strPlain.clear();
+///             parser.Strip(strPlain, block);
+///             Write(strPlain);
+///         }
+///  \endcode
+class simple_ansi_parser
+{
+    public:
+        simple_ansi_parser(void)
+            : m_state(GROUND)
+            , m_param(0)
+            , m_numberOfSequences(0)
+        {}
+
+        /// Forget an incomplete sequence, e.g. at the beginning of a new file.
+        void Reset(void)
+        {
+            m_state = GROUND;
+        }
+
+        /// \return <-- true, in case the input seen so far ends within a sequence
+        bool IsInSequence(void) const
+        {
+            return m_state != GROUND;
+        }
+
+        /// \return <-- the number of complete sequences seen so far
+        std::size_t GetNumberOfSequences(void) const
+        {
+            return m_numberOfSequences;
+        }
+
+        /// Split the input into text and sequences.
+        /// \param input      --> the next block of the input
+        /// \param onText     --> called as onText(const char *p, std::size_t size) for the text
+        /// \param onSequence --> called as onSequence(const simple_ansi_sequence &) for every complete sequence
+        template <class FText, class FSequence> void Parse(std::string_view input, FText onText, FSequence onSequence);
+
+        /// Append the input without the escape sequences to roResult.
+        void Strip(std::string &roResult, std::string_view input)
+        {
+            Parse(input, [&roResult](const char *p, std::size_t size)
+            {
+                roResult.append(p, size);
+            }, [](const simple_ansi_sequence &) {});
+        }
+
+        /// \return <-- the complete input without the escape sequences
+        static std::string GetPlainText(std::string_view input)
+        {
+            std::string strResult;
+            strResult.reserve(input.size());
+            simple_ansi_parser parser;
+            parser.Strip(strResult, input);
+            return strResult;
+        }
+
+        /// \return <-- the number of columns of a line on a terminal, the escape sequences take no space
+        static std::size_t GetDisplayWidth(std::string_view line)
+        {
+            simple_display_width width;
+            simple_ansi_parser parser;
+            parser.Parse(line, [&width](const char *p, std::size_t size)
+            {
+                width.Add(p, size);
+            }, [](const simple_ansi_sequence &) {});
+            return width.Get();
+        }
+
+    private:
+
+        enum EState
+        {
+            GROUND,
+            ESCAPE,
+            ESCAPE_INTERMEDIATE,
+            CSI_PARAM,
+            CSI_IGNORE,
+            STRING,
+            STRING_ESCAPE
+        };
+
+        static const char ESC = '\033';
+        static const char BEL = '\007';
+        static const char CAN = '\030';
+        static const char SUB = '\032';
+
+        void Begin(simple_ansi_sequence::EType type)
+        {
+            m_sequence = simple_ansi_sequence();
+            m_sequence.type = type;
+            m_param = 0;
+        }
+
+        template <class FSequence> void End(char final, FSequence &onSequence)
+        {
+            if(m_sequence.type != simple_ansi_sequence::STRING)
+            {
+                m_sequence.final = final;
+            }
+            ++m_numberOfSequences;
+            m_state = GROUND;
+            onSequence(m_sequence);
+        }
+
+        void AddDigit(char c)
+        {
+            if(m_sequence.count == 0)
+            {
+                m_sequence.count     = 1;
+                m_sequence.params[0] = -1;
+            }
+            if(m_param >= simple_ansi_sequence::MAX_PARAMS)
+            {
+                return;
+            }
+            int &param = m_sequence.params[m_param];
+            // saturated, larger values have no meaning for a terminal
+            param = (param < 0) ? (c - '0') : (param < 100000) ? param * 10 + (c - '0') : param;
+        }
+
+        void NextParam(void)
+        {
+            if(m_sequence.count == 0)
+            {
+                m_sequence.count     = 1;
+                m_sequence.params[0] = -1;
+            }
+            if(++m_param < simple_ansi_sequence::MAX_PARAMS)
+            {
+                m_sequence.params[m_param] = -1;
+                m_sequence.count = m_param + 1;
+            }
+        }
+
+        EState               m_state;
+        simple_ansi_sequence m_sequence;
+        /// the index of the current parameter, it may exceed MAX_PARAMS
+        unsigned int         m_param;
+        std::size_t          m_numberOfSequences;
+};
+
+template <class FText, class FSequence> inline void simple_ansi_parser::Parse(std::string_view input, FText onText, FSequence onSequence)
+{
+    const char *it  = input.data();
+    const char *end = it + input.size();
+    while(it != end)
+    {
+        if(m_state == GROUND)
+        {
+            const char *pEscape = simple_simd::FindByte(it, end, ESC);
+            if(pEscape != it)
+            {
+                onText(it, static_cast<std::size_t>(pEscape - it));
+            }
+            if(pEscape == end)
+            {
+                return;
+            }
+            m_state = ESCAPE;
+            it = pEscape + 1;
+            continue;
+        }
+
+        const char c = *it;
+        const unsigned char u = static_cast<unsigned char>(c);
+        if(c == '\n' && (m_state == STRING || m_state == STRING_ESCAPE))
+        {
+            // a terminal string never spans lines, the terminator is missing
+            m_state = GROUND;
+            continue;
+        }
+        if(c == ESC && m_state != STRING)
+        {
+            // a new sequence cancels the current one
+            m_state = ESCAPE;
+            ++it;
+            continue;
+        }
+        if(c == CAN || c == SUB)
+        {
+            m_state = GROUND;
+            ++it;
+            continue;
+        }
+        if(u >= 0x80 && m_state != STRING)
+        {
+            // not part of a sequence, the byte is text again
+            m_state = GROUND;
+            continue;
+        }
+        if(u < 0x20 && m_state != STRING && m_state != STRING_ESCAPE)
+        {
+            // a control character within a sequence is executed, i.e. it is text
+            onText(it, 1);
+            ++it;
+            continue;
+        }
+        ++it;
+        switch(m_state)
+        {
+            case ESCAPE:
+            {
+                if(c == '[')
+                {
+                    Begin(simple_ansi_sequence::CSI);
+                    m_state = CSI_PARAM;
+                }
+                else if(c == ']' || c == 'P' || c == 'X' || c == '^' || c == '_')
+                {
+                    Begin(simple_ansi_sequence::STRING);
+                    m_sequence.final = c;
+                    m_state = STRING;
+                }
+                else if(u >= 0x20 && u <= 0x2F)
+                {
+                    Begin(simple_ansi_sequence::ESCAPE);
+                    m_sequence.intermediate = c;
+                    m_state = ESCAPE_INTERMEDIATE;
+                }
+                else if(u >= 0x30 && u <= 0x7E)
+                {
+                    Begin(simple_ansi_sequence::ESCAPE);
+                    End(c, onSequence);
+                }
+                break;
+            }
+            case ESCAPE_INTERMEDIATE:
+            {
+                if(u >= 0x20 && u <= 0x2F)
+                {
+                    m_sequence.intermediate = c;
+                }
+                else if(u >= 0x30 && u <= 0x7E)
+                {
+                    End(c, onSequence);
+                }
+                break;
+            }
+            case CSI_PARAM:
+            {
+                if(c >= '0' && c <= '9')
+                {
+                    AddDigit(c);
+                }
+                else if(c == ';' || c == ':')
+                {
+                    NextParam();
+                }
+                else if(u >= 0x3C && u <= 0x3F)
+                {
+                    if(m_sequence.count == 0 && m_sequence.prefix == 0 && m_sequence.intermediate == 0)
+                    {
+                        m_sequence.prefix = c;
+                    }
+                    else
+                    {
+                        m_state = CSI_IGNORE;
+                    }
+                }
+                else if(u >= 0x20 && u <= 0x2F)
+                {
+                    m_sequence.intermediate = c;
+                }
+                else if(u >= 0x40 && u <= 0x7E)
+                {
+                    End(c, onSequence);
+                }
+                break;
+            }
+            case CSI_IGNORE:
+            {
+                // a malformed sequence is removed up to its final byte, but not reported
+                if(u >= 0x40 && u <= 0x7E)
+                {
+                    m_state = GROUND;
+                }
+                break;
+            }
+            case STRING:
+            {
+                if(c == BEL)
+                {
+                    End(c, onSequence);
+                }
+                else if(c == ESC)
+                {
+                    m_state = STRING_ESCAPE;
+                }
+                break;
+            }
+            case STRING_ESCAPE:
+            {
+                if(c == '\\')
+                {
+                    End(c, onSequence);
+                }
+                else
+                {
+                    // no string terminator, the ESC starts a new sequence
+                    m_state = ESCAPE;
+                    --it;
+                }
+                break;
+            }
+            case GROUND:
+            {
+                break;
+            }
+        }
+    }
+}
+
+/** @}*/
+
+#endif // SIMPLE_ANSI_ESCAPE_HPP
@@ -0,0 +1,249 @@
+/*!
+ * \file simple_fixed_width.hpp
+ * \brief A splitter for fixed width records, which have no separators at all.
+ *  The fields are located by their column offsets, no byte of a record is scanned,
+ *  except the padding of trimmed fields.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_FIXED_WIDTH_HPP
+#define SIMPLE_FIXED_WIDTH_HPP
+
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "simple_simd.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief The side of a field, from which its padding is removed.
+enum ESimpleFixedWidthTrim
+{
+    SIMPLE_FIXED_WIDTH_TRIM_NONE     = 0,
+    /// e.g. zero-padded numbers, "000100" --> "100"
+    SIMPLE_FIXED_WIDTH_TRIM_LEADING  = 1,
+    /// e.g. blank-padded text, "Smith   " --> "Smith"
+    SIMPLE_FIXED_WIDTH_TRIM_TRAILING = 2,
+    SIMPLE_FIXED_WIDTH_TRIM_BOTH     = 3
+};
+
+/// \brief The position of a field inside of a fixed width record.
+struct simple_fixed_width_column
+{
+    std::size_t           offset;
+    std::size_t           width;
+    /// the side, from which the padding is removed
+    ESimpleFixedWidthTrim trim;
+    /// the byte, that is removed
+    char                  padding;
+
+    simple_fixed_width_column(std::size_t columnOffset, std::size_t columnWidth
+                              , ESimpleFixedWidthTrim trimSide = SIMPLE_FIXED_WIDTH_TRIM_TRAILING, char paddingByte = ' ')
+        : offset(columnOffset)
+        , width(columnWidth)
+        , trim(trimSide)
+        , padding(paddingByte)
+    {}
+};
+
+/// \brief This class splits fixed width records into fields according to a column layout.
+///  Records, that are shorter than the layout, yield truncated or empty fields.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         std::vector<simple_fixed_width_column> layout;
+///         layout.push_back(simple_fixed_width_column(0, 8));     // account, blank-padded
+///         layout.push_back(simple_fixed_width_column(8, 10, SIMPLE_FIXED_WIDTH_TRIM_LEADING, '0'));    // amount, zero-padded
+///         simple_fixed_width splitter(layout);
+///
+///         std::vector< std::vector<std::string_view> > columns;
+///         splitter.SplitColumns(columns, fileContent);           // one record per line
+///         std::vector<int64_t> amounts;
+///         simple_fixed_width::ToIntegers(amounts, columns[1]);
+///  \endcode
+class simple_fixed_width
+{
+    public:
+
+        /// \param roLayout --> the columns
+        explicit simple_fixed_width(const std::vector<simple_fixed_width_column> &roLayout)
+            : m_layout(roLayout)
+            , m_recordLength(0)
+        {
+            for(std::size_t ui = 0; ui < m_layout.size(); ++ui)
+            {
+                if(m_layout[ui].offset + m_layout[ui].width > m_recordLength)
+                {
+                    m_recordLength = m_layout[ui].offset + m_layout[ui].width;
+                }
+            }
+        }
+
+        std::size_t GetNumberOfColumns(void) const
+        {
+            return m_layout.size();
+        }
+
+        /// \return the minimal record length, which contains every column completely
+        std::size_t GetRecordLength(void) const
+        {
+            return m_recordLength;
+        }
+
+        /// Split one record.
+        /// \param fields <-- GetNumberOfColumns() views into the record
+        void Split(std::string_view *fields, std::string_view record) const
+        {
+            const char *beg = record.data();
+            const std::size_t size = record.size();
+            for(std::size_t ui = 0; ui < m_layout.size(); ++ui)
+            {
+                const simple_fixed_width_column &column = m_layout[ui];
+                const std::size_t fieldBeg = (column.offset < size) ? column.offset : size;
+                const std::size_t fieldEnd = (column.offset + column.width < size) ? column.offset + column.width : size;
+                const char *itBeg = beg + fieldBeg;
+                const char *itEnd = beg + fieldEnd;
+                if(column.trim & SIMPLE_FIXED_WIDTH_TRIM_LEADING)
+                {
+                    itBeg = simple_simd::SkipByte(itBeg, itEnd, column.padding);
+                    // a zero-padded zero keeps its last digit
+                    if(itBeg == itEnd && itBeg != beg + fieldBeg && column.padding == '0')
+                    {
+                        --itBeg;
+                    }
+                }
+                if(column.trim & SIMPLE_FIXED_WIDTH_TRIM_TRAILING)
+                {
+                    itEnd = simple_simd::SkipByteBackwards(itBeg, itEnd, column.padding);
+                }
+                fields[ui] = std::string_view(itBeg, static_cast<std::size_t>(itEnd - itBeg));
+            }
+        }
+
+        /// Split one record into a vector of views.
+        void Split(std::vector<std::string_view> &roResult, std::string_view record) const
+        {
+            roResult.resize(m_layout.size());
+            Split(roResult.data(), record);
+        }
+
+        /// Split a block of records and call onRecord(const std::string_view *fields) for every record.
+        /// \param data         --> the records
+        /// \param recordStride --> the distance of two records in bytes. In case it is zero, every record
+        ///                         ends with a newline ('\n') or CRLF ("\r\n"), which is not part of the record.
+        /// \return <-- the number of records
+        template <class F> std::size_t ForEachRecord(std::string_view data, F onRecord, std::size_t recordStride = 0) const
+        {
+            std::vector<std::string_view> fields(m_layout.size());
+            std::size_t records = 0;
+            const char *it  = data.data();
+            const char *end = it + data.size();
+            while(it != end)
+            {
+                const char *recordEnd;
+                const char *next;
+                if(recordStride > 0)
+                {
+                    recordEnd = (static_cast<std::size_t>(end - it) > recordStride) ? it + recordStride : end;
+                    next      = recordEnd;
+                }
+                else
+                {
+                    recordEnd = simple_simd::FindByte(it, end, '\n');
+                    next      = (recordEnd != end) ? recordEnd + 1 : end;
+                    if(recordEnd != it && *(recordEnd - 1) == '\r')
+                    {
+                        --recordEnd;
+                    }
+                }
+                Split(fields.data(), std::string_view(it, static_cast<std::size_t>(recordEnd - it)));
+                onRecord(static_cast<const std::string_view*>(fields.data()));
+                ++records;
+                it = next;
+            }
+            return records;
+        }
+
+        /// Split a block of records into columns, roColumns[column][record] is a field.
+        /// \return <-- the number of records
+        std::size_t SplitColumns(std::vector< std::vector<std::string_view> > &roColumns, std::string_view data, std::size_t recordStride = 0) const
+        {
+            roColumns.resize(m_layout.size());
+            for(std::size_t ui = 0; ui < roColumns.size(); ++ui)
+            {
+                roColumns[ui].clear();
+                if(recordStride > 0)
+                {
+                    roColumns[ui].reserve((data.size() + recordStride - 1) / recordStride);
+                }
+            }
+            return ForEachRecord(data, [&roColumns](const std::string_view *fields)
+            {
+                for(std::size_t ui = 0; ui < roColumns.size(); ++ui)
+                {
+                    roColumns[ui].push_back(fields[ui]);
+                }
+            }, recordStride);
+        }
+
+        /// Convert a field of decimal digits with an optional sign into an integer.
+        /// \return <-- false, in case the field is empty, contains other bytes or overflows
+        static bool ToInteger(int64_t &value, std::string_view field)
+        {
+            std::size_t pos = 0;
+            const bool negative = !field.empty() && field[0] == '-';
+            if(!field.empty() && (field[0] == '-' || field[0] == '+'))
+            {
+                pos = 1;
+            }
+            if(pos == field.size())
+            {
+                return false;
+            }
+            uint64_t magnitude = 0;
+            for(; pos < field.size(); ++pos)
+            {
+                const unsigned int digit = static_cast<unsigned int>(field[pos] - '0');
+                if(digit > 9 || magnitude > (UINT64_MAX - digit) / 10)
+                {
+                    return false;
+                }
+                magnitude = magnitude * 10 + digit;
+            }
+            if(magnitude > (negative ? uint64_t(INT64_MAX) + 1 : uint64_t(INT64_MAX)))
+            {
+                return false;
+            }
+            value = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+            return true;
+        }
+
+        /// Convert a column into integers.
+        /// \return <-- false, in case a field is not an integer. roValues contains the values up to this field.
+        static bool ToIntegers(std::vector<int64_t> &roValues, const std::vector<std::string_view> &roColumn)
+        {
+            roValues.clear();
+            roValues.reserve(roColumn.size());
+            for(std::size_t ui = 0; ui < roColumn.size(); ++ui)
+            {
+                int64_t value;
+                if(!ToInteger(value, roColumn[ui]))
+                {
+                    return false;
+                }
+                roValues.push_back(value);
+            }
+            return true;
+        }
+
+    private:
+        std::vector<simple_fixed_width_column> m_layout;
+        std::size_t                            m_recordLength;
+};
+
+/** @}*/
+
+#endif // SIMPLE_FIXED_WIDTH_HPP
@@ -0,0 +1,440 @@
+/*!
+ * \file simple_group_by.hpp
+ * \brief Hash aggregation of a value column grouped by a key column
+ *  ("group by field 3, sum field 7") with count, sum, min, max and mean per group.
+ *
+ *  The groups are kept in an open addressing hash table with linear probing. A slot
+ *  holds the hash of its key, so that a probe compares the key bytes only in case
+ *  the hashes are equal and a rehash does not hash the keys again. Rows are inserted
+ *  in batches: the hashes of a batch are computed and its slots prefetched first,
+ *  then the rows are probed, while the cache lines are already on their way.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_GROUP_BY_HPP
+#define SIMPLE_GROUP_BY_HPP
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+
+#include "simple_fixed_width.hpp"
+#include "simple_simd.hpp"
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief The aggregates of a group
+struct simple_group_aggregate
+{
+    uint64_t count;
+    int64_t  sum;
+    int64_t  min;
+    int64_t  max;
+
+    double Mean(void) const
+    {
+        return (count != 0) ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+    }
+};
+
+/// \brief Group by aggregation over columns of keys and values.
+///  Every thread should aggregate into its own instance, the partial aggregates
+///  are combined by Merge() (see AggregateLines()).
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_group_by groups;
+///         // columns of tokenizer output, e.g. from simple_fixed_width::SplitColumns
+///         groups.AddColumns(keys, values);
+///         // or: group the lines by field 3 and aggregate field 7 (counted from 0)
+///         simple_group_by::AggregateLines<CIsSpace>(groups, fileContent, 3, 7);
+///         groups.ForEachGroup([](std::string_view key, const simple_group_aggregate &aggregate)
+///         {
+///             std::cout << key << " " << aggregate.sum << "\n";
+///         });
+///  \endcode
+class simple_group_by
+{
+    public:
+
+        /// \param expectedGroups --> the table is sized for this number of groups, it grows on demand
+        explicit simple_group_by(std::size_t expectedGroups = 1024)
+            : m_slots()
+            , m_mask(0)
+            , m_size(0)
+            , m_strKeys()
+        {
+            std::size_t capacity = 16;
+            while(capacity < 2 * expectedGroups)
+            {
+                capacity <<= 1;
+            }
+            m_slots.assign(capacity, SSlot());
+            m_mask = capacity - 1;
+        }
+
+        /// Aggregate a row.
+        void Add(std::string_view key, int64_t value)
+        {
+            Reserve(1);
+            Update(FindOrInsert(key, Hash(key)), value);
+        }
+
+        /// Aggregate rows: keys[i] and values[i] form a row.
+        void AddBatch(const std::string_view *pKeys, const int64_t *pValues, std::size_t count);
+
+        /// Aggregate two columns of the same length.
+        void AddColumns(const std::vector<std::string_view> &roKeys, const std::vector<int64_t> &roValues)
+        {
+            AddBatch(roKeys.data(), roValues.data(), std::min(roKeys.size(), roValues.size()));
+        }
+
+        /// Add the groups of an other instance, e.g. the partial aggregates of an other thread.
+        void Merge(const simple_group_by &roOther);
+
+        /// Tokenize the lines of data, group by the key field and aggregate the value field.
+        /// Lines without these fields or with a value, that is not an integer, are skipped.
+        /// \param keyField   --> the index of the key token (counted from 0)
+        /// \param valueField --> the index of the value token (counted from 0)
+        /// \return <-- the number of aggregated lines
+        template <class Pred> std::size_t AddLines(std::string_view data, std::size_t keyField, std::size_t valueField, const Pred & roPred = Pred());
+
+        /// Aggregate the lines of data with several threads, every thread aggregates a part
+        /// of the lines (split at line boundaries), the partial aggregates are merged into roResult.
+        /// \param numberOfThreads --> 0 means one per core
+        /// \return <-- the number of aggregated lines
+        template <class Pred> static std::size_t AggregateLines(simple_group_by &roResult, std::string_view data
+                , std::size_t keyField, std::size_t valueField, unsigned int numberOfThreads = 0, const Pred & roPred = Pred());
+
+        /// \return <-- false, in case there is no group of the key
+        bool Get(std::string_view key, simple_group_aggregate &roAggregate) const
+        {
+            const uint64_t hash = Hash(key);
+            for(std::size_t pos = hash & m_mask; m_slots[pos].hash != 0; pos = (pos + 1) & m_mask)
+            {
+                if(m_slots[pos].hash == hash && GetKey(m_slots[pos]) == key)
+                {
+                    roAggregate = m_slots[pos].aggregate;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// Call onGroup(key, aggregate) for every group, in no particular order.
+        template <class F> void ForEachGroup(F onGroup) const
+        {
+            for(std::size_t ui = 0; ui < m_slots.size(); ++ui)
+            {
+                if(m_slots[ui].hash != 0)
+                {
+                    onGroup(GetKey(m_slots[ui]), m_slots[ui].aggregate);
+                }
+            }
+        }
+
+        /// \param roGroups <-- the groups sorted by their keys
+        void GetGroups(std::vector< std::pair<std::string, simple_group_aggregate> > &roGroups) const
+        {
+            roGroups.clear();
+            roGroups.reserve(m_size);
+            ForEachGroup([&roGroups](std::string_view key, const simple_group_aggregate &aggregate)
+            {
+                roGroups.push_back(std::make_pair(std::string(key), aggregate));
+            });
+            std::sort(roGroups.begin(), roGroups.end(), [](const std::pair<std::string, simple_group_aggregate> &roLhs
+                      , const std::pair<std::string, simple_group_aggregate> &roRhs)
+            {
+                return roLhs.first < roRhs.first;
+            });
+        }
+
+        /// \return the number of groups
+        std::size_t Size(void) const
+        {
+            return m_size;
+        }
+
+        void Clear(void)
+        {
+            std::fill(m_slots.begin(), m_slots.end(), SSlot());
+            m_size = 0;
+            m_strKeys.clear();
+        }
+
+        /// A fast hash of short keys, it processes 8 bytes at a time and is never 0.
+        static uint64_t Hash(std::string_view key)
+        {
+            const char *p = key.data();
+            std::size_t size = key.size();
+            uint64_t hash = 0x9E3779B97F4A7C15ULL ^ (size * 0xFF51AFD7ED558CCDULL);
+            for(; size >= 8; p += 8, size -= 8)
+            {
+                uint64_t word;
+                memcpy(&word, p, 8);
+                hash = (hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+                hash ^= hash >> 29;
+            }
+            if(size > 0)
+            {
+                uint64_t word = 0;
+                memcpy(&word, p, size);
+                hash = (hash ^ word) * 0xBF58476D1CE4E5B9ULL;
+            }
+            hash ^= hash >> 32;
+            hash *= 0x94D049BB133111EBULL;
+            hash ^= hash >> 29;
+            return (hash != 0) ? hash : 1;
+        }
+
+    private:
+
+        /// the number of rows, whose slots are prefetched in advance
+        static constexpr std::size_t BATCH = 16;
+
+        struct SSlot
+        {
+            /// 0 marks an empty slot
+            uint64_t hash;
+            uint32_t keyOffset;
+            uint32_t keyLength;
+            simple_group_aggregate aggregate;
+
+            SSlot(void) : hash(0), keyOffset(0), keyLength(0), aggregate() {}
+        };
+
+        std::string_view GetKey(const SSlot &roSlot) const
+        {
+            return std::string_view(m_strKeys.data() + roSlot.keyOffset, roSlot.keyLength);
+        }
+
+        static void Update(SSlot &roSlot, int64_t value)
+        {
+            simple_group_aggregate &aggregate = roSlot.aggregate;
+            if(aggregate.count == 0)
+            {
+                aggregate.min = value;
+                aggregate.max = value;
+            }
+            else
+            {
+                aggregate.min = std::min(aggregate.min, value);
+                aggregate.max = std::max(aggregate.max, value);
+            }
+            ++aggregate.count;
+            aggregate.sum += value;
+        }
+
+        SSlot &FindOrInsert(std::string_view key, uint64_t hash)
+        {
+            std::size_t pos = hash & m_mask;
+            for(; m_slots[pos].hash != 0; pos = (pos + 1) & m_mask)
+            {
+                if(m_slots[pos].hash == hash && GetKey(m_slots[pos]) == key)
+                {
+                    return m_slots[pos];
+                }
+            }
+            SSlot &slot = m_slots[pos];
+            slot.hash      = hash;
+            slot.keyOffset = static_cast<uint32_t>(m_strKeys.size());
+            slot.keyLength = static_cast<uint32_t>(key.size());
+            m_strKeys.append(key.data(), key.size());
+            ++m_size;
+            return slot;
+        }
+
+        /// Grow the table, so that count more groups keep the load factor at most 1/2.
+        void Reserve(std::size_t count)
+        {
+            if(2 * (m_size + count) <= m_slots.size())
+            {
+                return;
+            }
+            std::size_t capacity = m_slots.size();
+            while(2 * (m_size + count) > capacity)
+            {
+                capacity <<= 1;
+            }
+            std::vector<SSlot> slots(capacity);
+            const std::size_t mask = capacity - 1;
+            for(std::size_t ui = 0; ui < m_slots.size(); ++ui)
+            {
+                if(m_slots[ui].hash != 0)
+                {
+                    std::size_t pos = m_slots[ui].hash & mask;
+                    while(slots[pos].hash != 0)
+                    {
+                        pos = (pos + 1) & mask;
+                    }
+                    slots[pos] = m_slots[ui];
+                }
+            }
+            m_slots.swap(slots);
+            m_mask = mask;
+        }
+
+        std::vector<SSlot> m_slots;
+        std::size_t        m_mask;
+        std::size_t        m_size;
+        /// the bytes of all keys, the slots address up to 4 GiB of them
+        std::string        m_strKeys;
+};
+
+inline void simple_group_by::AddBatch(const std::string_view *pKeys, const int64_t *pValues, std::size_t count)
+{
+    uint64_t hashes[BATCH];
+    for(std::size_t first = 0; first < count; first += BATCH)
+    {
+        const std::size_t size = std::min(BATCH, count - first);
+        // the table does not grow within a batch, so that the prefetched slots stay valid
+        Reserve(size);
+        for(std::size_t ui = 0; ui < size; ++ui)
+        {
+            hashes[ui] = Hash(pKeys[first + ui]);
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(&m_slots[hashes[ui] & m_mask]);
+#endif
+        }
+        for(std::size_t ui = 0; ui < size; ++ui)
+        {
+            Update(FindOrInsert(pKeys[first + ui], hashes[ui]), pValues[first + ui]);
+        }
+    }
+}
+
+inline void simple_group_by::Merge(const simple_group_by &roOther)
+{
+    if(&roOther == this)
+    {
+        return;
+    }
+    Reserve(roOther.m_size);
+    for(std::size_t ui = 0; ui < roOther.m_slots.size(); ++ui)
+    {
+        const SSlot &roSource = roOther.m_slots[ui];
+        if(roSource.hash == 0)
+        {
+            continue;
+        }
+        simple_group_aggregate &aggregate = FindOrInsert(roOther.GetKey(roSource), roSource.hash).aggregate;
+        if(aggregate.count == 0)
+        {
+            aggregate = roSource.aggregate;
+            continue;
+        }
+        aggregate.count += roSource.aggregate.count;
+        aggregate.sum   += roSource.aggregate.sum;
+        aggregate.min    = std::min(aggregate.min, roSource.aggregate.min);
+        aggregate.max    = std::max(aggregate.max, roSource.aggregate.max);
+    }
+}
+
+template <class Pred> std::size_t simple_group_by::AddLines(std::string_view data, std::size_t keyField, std::size_t valueField, const Pred & roPred)
+{
+    // the lines are collected into columns of BATCH rows
+    std::string_view keys[BATCH];
+    int64_t values[BATCH];
+    std::size_t rows  = 0;
+    std::size_t lines = 0;
+    const std::size_t lastField = std::max(keyField, valueField);
+    const char *it  = data.data();
+    const char *end = it + data.size();
+    while(it != end)
+    {
+        const char *lineEnd = simple_simd::FindByte(it, end, '\n');
+        const std::string_view line(it, static_cast<std::size_t>(lineEnd - it));
+        it = (lineEnd != end) ? lineEnd + 1 : end;
+
+        std::string_view key;
+        std::string_view value;
+        std::size_t pos = 0;
+        for(std::size_t field = 0; field <= lastField; ++field)
+        {
+            const std::string_view token = simple_tokenize<Pred>::NextToken(line, pos, roPred);
+            if(token.empty())
+            {
+                break;
+            }
+            if(field == keyField)
+            {
+                key = token;
+            }
+            if(field == valueField)
+            {
+                value = token;
+            }
+        }
+        if(key.empty() || !simple_fixed_width::ToInteger(values[rows], value))
+        {
+            continue;
+        }
+        keys[rows++] = key;
+        ++lines;
+        if(rows == BATCH)
+        {
+            AddBatch(keys, values, rows);
+            rows = 0;
+        }
+    }
+    AddBatch(keys, values, rows);
+    return lines;
+}
+
+template <class Pred> std::size_t simple_group_by::AggregateLines(simple_group_by &roResult, std::string_view data
+        , std::size_t keyField, std::size_t valueField, unsigned int numberOfThreads, const Pred & roPred)
+{
+    if(numberOfThreads == 0)
+    {
+        numberOfThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    // small inputs are not worth the threads
+    const std::size_t minimalChunkSize = 1 << 20;
+    numberOfThreads = static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(numberOfThreads, data.size() / minimalChunkSize)));
+    if(numberOfThreads == 1)
+    {
+        return roResult.AddLines(data, keyField, valueField, roPred);
+    }
+
+    const char *pData = data.data();
+    const char *pEnd  = pData + data.size();
+    std::vector<const char*> bounds(1, pData);
+    for(unsigned int t = 1; t < numberOfThreads; ++t)
+    {
+        const char *pBound = std::max(bounds.back(), pData + t * (data.size() / numberOfThreads));
+        pBound = simple_simd::FindByte(pBound, pEnd, '\n');
+        bounds.push_back((pBound != pEnd) ? pBound + 1 : pBound);
+    }
+    bounds.push_back(pEnd);
+
+    std::vector<simple_group_by> partials(numberOfThreads, simple_group_by(roResult.Size()));
+    std::vector<std::size_t> lines(numberOfThreads, 0);
+    std::vector<std::thread> threads;
+    for(unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+        threads.push_back(std::thread([&partials, &lines, &bounds, &roPred, keyField, valueField, t]()
+        {
+            lines[t] = partials[t].AddLines(std::string_view(bounds[t], static_cast<std::size_t>(bounds[t + 1] - bounds[t])), keyField, valueField, roPred);
+        }));
+    }
+    std::size_t total = 0;
+    for(unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+        threads[t].join();
+        roResult.Merge(partials[t]);
+        total += lines[t];
+    }
+    return total;
+}
+
+/** @}*/
+
+#endif // SIMPLE_GROUP_BY_HPP
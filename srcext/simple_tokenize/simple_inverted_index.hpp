@@ -0,0 +1,579 @@
+/*!
+ * \file simple_inverted_index.hpp
+ * \brief A persistent inverted index, which maps every token of a file to the lines,
+ *  that contain it. Queries for lines with all (AND) or any (OR) of some tokens read
+ *  a few postings lists instead of scanning the file.
+ *
+ *  The file is tokenized in parallel over chunks, which end at line boundaries. The
+ *  index is stored next to the file (\<file\>.sinv) and memory mapped on later runs,
+ *  as long as the size and modification time of the file did not change.
+ *
+ *  Index file format (version 2, native byte order):
+ *   - header: magic "SINVX", version, size and modification time of the indexed file,
+ *     the hash of the tokenizer id, the number of terms and the section sizes (72 bytes)
+ *   - terms: per term (sorted by its bytes) the offset and length of its bytes, the number
+ *     of lines and the offset of its postings list (24 bytes)
+ *   - term bytes
+ *   - postings: per term the ascending offsets of the lines, that contain it. The first
+ *     offset and the differences of the following ones are LEB128 varints.
+ *     The section is followed by 16 padding bytes, so that 16 bytes can always be loaded.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_INVERTED_INDEX_HPP
+#define SIMPLE_INVERTED_INDEX_HPP
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/stat.h>
+
+#include "simple_mapped_file.hpp"
+#include "simple_radix_sort.hpp"
+#include "simple_simd.hpp"
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief Token to line lookups in a (large) file.
+///  A line is identified by the offset of its first byte, GetLine() returns its content.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_inverted_index<> index;
+///         if(index.Open("access.log"))   // builds access.log.sinv, in case it is missing or outdated
+///         {
+///             std::vector<uint64_t> lines;
+///             index.QueryAnd(lines, {"ERROR", "disk"});
+///             for(std::size_t ui = 0; ui < lines.size(); ++ui)
+///             {
+///                 std::cout << index.GetLine(lines[ui]) << std::endl;
+///             }
+///         }
+///  \endcode
+template < class Pred = CIsSpace > class simple_inverted_index
+{
+    public:
+
+        static constexpr uint32_t VERSION = 2;
+
+        /// \param roPred         --> the separator
+        /// \param strTokenizerId --> identifies the tokenizer in the index. Predicates with parameters
+        ///                           (e.g. CIsFromString) need a different id for every parameter.
+        ///                           By default the type name of Pred is used.
+        explicit simple_inverted_index(const Pred & roPred = Pred(), const std::string &strTokenizerId = "");
+        ~simple_inverted_index(void);
+
+        simple_inverted_index(const simple_inverted_index &) = delete;
+        simple_inverted_index& operator=(const simple_inverted_index &) = delete;
+
+        /// Map a file and its index. The index is (re)built, in case it does not exist,
+        /// has an other version, was built by an other tokenizer or does not belong to
+        /// the current state of the file.
+        /// \param strFileName     --> the file to be indexed
+        /// \param numberOfThreads --> threads used to build the index, 0 means one per core
+        /// \return false, in case the file cannot be mapped or the index cannot be built
+        bool Open(const std::string &strFileName, unsigned int numberOfThreads = 0);
+
+        void Close(void);
+
+        /// Build the index of a file and write it to strIndexFileName.
+        bool Build(const std::string &strFileName, const std::string &strIndexFileName, unsigned int numberOfThreads = 0) const;
+
+        static std::string GetIndexFileName(const std::string &strFileName)
+        {
+            return strFileName + ".sinv";
+        }
+
+        /// \return true, in case the last call of Open() had to build the index
+        bool WasIndexBuilt(void) const
+        {
+            return m_bIndexBuilt;
+        }
+
+        std::size_t GetNumberOfTerms(void) const
+        {
+            return (m_pHeader != NULL) ? static_cast<std::size_t>(m_pHeader->numberOfTerms) : 0;
+        }
+
+        /// \return the number of lines, that contain the token
+        std::size_t GetNumberOfLines(std::string_view token) const
+        {
+            const STerm *pTerm = FindTerm(token);
+            return (pTerm != NULL) ? pTerm->count : 0;
+        }
+
+        /// \param roLines <-- the ascending offsets of the lines, that contain the token
+        /// \return <-- false, in case the token is not contained in the file
+        bool Lookup(std::vector<uint64_t> &roLines, std::string_view token) const;
+
+        /// \param roLines <-- the ascending offsets of the lines, that contain all tokens
+        void QueryAnd(std::vector<uint64_t> &roLines, const std::vector<std::string_view> &roTokens) const;
+
+        /// \param roLines <-- the ascending offsets of the lines, that contain at least one of the tokens
+        void QueryOr(std::vector<uint64_t> &roLines, const std::vector<std::string_view> &roTokens) const;
+
+        /// \return the line at the offset without its newline
+        std::string_view GetLine(uint64_t offset) const
+        {
+            const char *beg = m_pData + offset;
+            const char *end = simple_simd::FindByte(beg, m_pData + m_dataSize, '\n');
+            return std::string_view(beg, static_cast<std::size_t>(end - beg));
+        }
+
+        /// Decode count LEB128 varints, which are the first value and the differences of an ascending
+        /// sequence. Runs of one byte varints are recognised 16 bytes at a time.
+        /// At least 16 bytes behind the encoded values have to be readable.
+        /// \return <-- the position behind the last decoded byte
+        static const unsigned char *DecodeDeltas(const unsigned char *p, std::size_t count, uint64_t *pValues);
+
+    private:
+
+        struct SHeader
+        {
+            char     magic[8];
+            uint32_t version;
+            uint32_t reserved;
+            uint64_t fileSize;
+            int64_t  fileModificationTime;      // seconds
+            int64_t  fileModificationTimeNsec;  // nanoseconds
+            uint64_t tokenizerHash;
+            uint64_t numberOfTerms;
+            uint64_t termBytesSize;
+            uint64_t postingsSize;
+        };
+        static_assert(sizeof(SHeader) == 72, "the header size is part of the file format");
+
+        struct STerm
+        {
+            uint64_t termOffset;
+            uint32_t termLength;
+            uint32_t count;
+            uint64_t postingsOffset;
+        };
+
+        static constexpr std::size_t PADDING = 16;
+
+        typedef std::unordered_map< std::string_view, std::vector<uint64_t> > postings_map;
+
+        /// FNV-1a of the tokenizer id
+        static uint64_t HashId(const std::string &strId)
+        {
+            uint64_t hash = 0xCBF29CE484222325ULL;
+            for(std::size_t ui = 0; ui < strId.size(); ++ui)
+            {
+                hash = (hash ^ static_cast<unsigned char>(strId[ui])) * 0x100000001B3ULL;
+            }
+            return hash;
+        }
+
+        const STerm *FindTerm(std::string_view token) const;
+        bool MapIndex(const std::string &strIndexFileName);
+
+        Pred                 m_Pred;
+        uint64_t             m_tokenizerHash;
+        const char          *m_pData;
+        std::size_t          m_dataSize;
+        const char          *m_pIndex;
+        std::size_t          m_indexSize;
+        const SHeader       *m_pHeader;
+        const STerm         *m_pTerms;
+        const char          *m_pTermBytes;
+        const unsigned char *m_pPostings;
+        bool                 m_bIndexBuilt;
+};
+
+template <class Pred> simple_inverted_index<Pred>::simple_inverted_index(const Pred & roPred, const std::string &strTokenizerId)
+    : m_Pred(roPred)
+    , m_tokenizerHash(HashId(strTokenizerId.empty() ? std::string(typeid(Pred).name()) : strTokenizerId))
+    , m_pData(NULL)
+    , m_dataSize(0)
+    , m_pIndex(NULL)
+    , m_indexSize(0)
+    , m_pHeader(NULL)
+    , m_pTerms(NULL)
+    , m_pTermBytes(NULL)
+    , m_pPostings(NULL)
+    , m_bIndexBuilt(false)
+{}
+
+template <class Pred> simple_inverted_index<Pred>::~simple_inverted_index(void)
+{
+    Close();
+}
+
+template <class Pred> void simple_inverted_index<Pred>::Close(void)
+{
+    simple_mapped_file::Unmap(m_pData, m_dataSize);
+    simple_mapped_file::Unmap(m_pIndex, m_indexSize);
+    m_pHeader    = NULL;
+    m_pTerms     = NULL;
+    m_pTermBytes = NULL;
+    m_pPostings  = NULL;
+}
+
+template <class Pred> bool simple_inverted_index<Pred>::Build(const std::string &strFileName, const std::string &strIndexFileName, unsigned int numberOfThreads) const
+{
+    const char *pData = NULL;
+    std::size_t size  = 0;
+    struct stat status;
+    if(!simple_mapped_file::Map(strFileName, pData, size, status))
+    {
+        return false;
+    }
+    if(numberOfThreads == 0)
+    {
+        numberOfThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    // small files are not worth the threads
+    const std::size_t minimalChunkSize = 1 << 20;
+    numberOfThreads = static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(numberOfThreads, size / minimalChunkSize)));
+
+    // the chunks end behind a newline, so that no line is split
+    std::vector<const char*> bounds(1, pData);
+    for(unsigned int t = 1; t < numberOfThreads; ++t)
+    {
+        const char *pBound = std::max(bounds.back(), pData + t * (size / numberOfThreads));
+        pBound = simple_simd::FindByte(pBound, pData + size, '\n');
+        bounds.push_back((pBound != pData + size) ? pBound + 1 : pBound);
+    }
+    bounds.push_back(pData + size);
+
+    // every thread collects the postings of its chunk, the lines of a chunk are ascending
+    std::vector<postings_map> postings(numberOfThreads);
+    std::vector<std::thread> threads;
+    for(unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+        threads.push_back(std::thread([this, &postings, &bounds, pData, t]()
+        {
+            postings_map &roPostings = postings[t];
+            const char *it  = bounds[t];
+            const char *end = bounds[t + 1];
+            while(it != end)
+            {
+                const char *lineEnd = simple_simd::FindByte(it, end, '\n');
+                const uint64_t line = static_cast<uint64_t>(it - pData);
+                simple_tokenize<Pred>::ForEachToken(std::string_view(it, static_cast<std::size_t>(lineEnd - it)), [&roPostings, line](std::string_view token)
+                {
+                    std::vector<uint64_t> &roLines = roPostings[token];
+                    // a token, which occurs several times in a line, is stored once
+                    if(roLines.empty() || roLines.back() != line)
+                    {
+                        roLines.push_back(line);
+                    }
+                }, m_Pred);
+                it = (lineEnd != end) ? lineEnd + 1 : end;
+            }
+        }));
+    }
+    for(std::size_t t = 0; t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+
+    // the dictionary is sorted, so that a term is found by binary search
+    std::vector<std::string_view> terms;
+    for(unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+        for(typename postings_map::const_iterator it = postings[t].begin(); it != postings[t].end(); ++it)
+        {
+            terms.push_back(it->first);
+        }
+    }
+    simple_radix_sort::SortUnique(terms);
+
+    std::vector<STerm> entries(terms.size());
+    std::string strTermBytes;
+    std::string strPostings;
+    bool bOverflow = false;
+    for(std::size_t ui = 0; ui < terms.size(); ++ui)
+    {
+        STerm &entry = entries[ui];
+        entry.termOffset     = strTermBytes.size();
+        entry.termLength     = static_cast<uint32_t>(terms[ui].size());
+        entry.postingsOffset = strPostings.size();
+        strTermBytes.append(terms[ui].data(), terms[ui].size());
+        bOverflow = bOverflow || (terms[ui].size() > UINT32_MAX);
+
+        uint64_t count    = 0;
+        uint64_t previous = 0;
+        // the chunks are in file order, so the concatenated postings are ascending
+        for(unsigned int t = 0; t < numberOfThreads; ++t)
+        {
+            typename postings_map::const_iterator it = postings[t].find(terms[ui]);
+            if(it == postings[t].end())
+            {
+                continue;
+            }
+            for(std::size_t uj = 0; uj < it->second.size(); ++uj)
+            {
+                uint64_t delta = it->second[uj] - previous;
+                previous = it->second[uj];
+                do
+                {
+                    strPostings.push_back(static_cast<char>((delta & 0x7F) | (delta > 0x7F ? 0x80 : 0)));
+                    delta >>= 7;
+                }
+                while(delta != 0);
+            }
+            count += it->second.size();
+        }
+        bOverflow = bOverflow || (count > UINT32_MAX);
+        entry.count = static_cast<uint32_t>(count);
+    }
+    strPostings.append(PADDING, '\0');
+    postings.clear();
+    simple_mapped_file::Unmap(pData, size);
+    if(bOverflow)
+    {
+        return false;
+    }
+
+    SHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "SINVX", 5);
+    header.version                  = VERSION;
+    header.fileSize                 = static_cast<uint64_t>(status.st_size);
+    header.fileModificationTime     = static_cast<int64_t>(status.st_mtim.tv_sec);
+    header.fileModificationTimeNsec = static_cast<int64_t>(status.st_mtim.tv_nsec);
+    header.tokenizerHash            = m_tokenizerHash;
+    header.numberOfTerms            = entries.size();
+    header.termBytesSize            = strTermBytes.size();
+    header.postingsSize             = strPostings.size();
+
+    // write to a temporary file and rename it, so that readers never see a partial index
+    const std::string strTempFileName(strIndexFileName + ".tmp");
+    FILE *pFile = fopen(strTempFileName.c_str(), "wb");
+    if(pFile == NULL)
+    {
+        return false;
+    }
+    bool bSuccess = (fwrite(&header, sizeof(header), 1, pFile) == 1);
+    if(bSuccess && !entries.empty())
+    {
+        bSuccess = (fwrite(&entries[0], sizeof(STerm), entries.size(), pFile) == entries.size());
+    }
+    if(bSuccess && !strTermBytes.empty())
+    {
+        bSuccess = (fwrite(strTermBytes.data(), 1, strTermBytes.size(), pFile) == strTermBytes.size());
+    }
+    if(bSuccess)
+    {
+        bSuccess = (fwrite(strPostings.data(), 1, strPostings.size(), pFile) == strPostings.size());
+    }
+    bSuccess = (fclose(pFile) == 0) && bSuccess;
+    if(!bSuccess || rename(strTempFileName.c_str(), strIndexFileName.c_str()) != 0)
+    {
+        (void)remove(strTempFileName.c_str());
+        return false;
+    }
+    return true;
+}
+
+template <class Pred> bool simple_inverted_index<Pred>::MapIndex(const std::string &strIndexFileName)
+{
+    struct stat status;
+    if(!simple_mapped_file::Map(strIndexFileName, m_pIndex, m_indexSize, status))
+    {
+        return false;
+    }
+    if(m_indexSize < sizeof(SHeader))
+    {
+        simple_mapped_file::Unmap(m_pIndex, m_indexSize);
+        return false;
+    }
+    const SHeader *pHeader = reinterpret_cast<const SHeader*>(m_pIndex);
+    const uint64_t expectedSize = sizeof(SHeader)
+                                  + pHeader->numberOfTerms * sizeof(STerm)
+                                  + pHeader->termBytesSize
+                                  + pHeader->postingsSize;
+    if(memcmp(pHeader->magic, "SINVX", 5) != 0
+            || pHeader->version != VERSION
+            || pHeader->postingsSize < PADDING
+            || expectedSize != m_indexSize)
+    {
+        simple_mapped_file::Unmap(m_pIndex, m_indexSize);
+        return false;
+    }
+    m_pHeader    = pHeader;
+    m_pTerms     = reinterpret_cast<const STerm*>(m_pIndex + sizeof(SHeader));
+    m_pTermBytes = reinterpret_cast<const char*>(m_pTerms + pHeader->numberOfTerms);
+    m_pPostings  = reinterpret_cast<const unsigned char*>(m_pTermBytes + pHeader->termBytesSize);
+    return true;
+}
+
+template <class Pred> bool simple_inverted_index<Pred>::Open(const std::string &strFileName, unsigned int numberOfThreads)
+{
+    Close();
+    m_bIndexBuilt = false;
+    struct stat status;
+    if(!simple_mapped_file::Map(strFileName, m_pData, m_dataSize, status))
+    {
+        return false;
+    }
+    const std::string strIndexFileName(GetIndexFileName(strFileName));
+    if(MapIndex(strIndexFileName)
+            && m_pHeader->fileSize == static_cast<uint64_t>(status.st_size)
+            && m_pHeader->fileModificationTime == static_cast<int64_t>(status.st_mtim.tv_sec)
+            && m_pHeader->fileModificationTimeNsec == static_cast<int64_t>(status.st_mtim.tv_nsec)
+            && m_pHeader->tokenizerHash == m_tokenizerHash)
+    {
+        return true;
+    }
+    simple_mapped_file::Unmap(m_pIndex, m_indexSize);
+    m_pHeader = NULL;
+
+    if(!Build(strFileName, strIndexFileName, numberOfThreads) || !MapIndex(strIndexFileName))
+    {
+        Close();
+        return false;
+    }
+    m_bIndexBuilt = true;
+    return true;
+}
+
+template <class Pred> const typename simple_inverted_index<Pred>::STerm *simple_inverted_index<Pred>::FindTerm(std::string_view token) const
+{
+    if(m_pHeader == NULL)
+    {
+        return NULL;
+    }
+    const STerm *pEnd = m_pTerms + m_pHeader->numberOfTerms;
+    const STerm *pTerm = std::lower_bound(m_pTerms, pEnd, token, [this](const STerm &term, std::string_view value)
+    {
+        return std::string_view(m_pTermBytes + term.termOffset, term.termLength) < value;
+    });
+    if(pTerm == pEnd || std::string_view(m_pTermBytes + pTerm->termOffset, pTerm->termLength) != token)
+    {
+        return NULL;
+    }
+    return pTerm;
+}
+
+template <class Pred> const unsigned char *simple_inverted_index<Pred>::DecodeDeltas(const unsigned char *p, std::size_t count, uint64_t *pValues)
+{
+    uint64_t value = 0;
+    std::size_t ui = 0;
+    while(ui < count)
+    {
+        // the bytes without continuation bit in front of the first one with it are complete varints
+        const unsigned int mask = simple_simd::HighBitMask16(reinterpret_cast<const char*>(p));
+        std::size_t run = (mask == 0) ? 16 : simple_simd::CountTrailingZeros(mask);
+        run = std::min(run, count - ui);
+        for(std::size_t uj = 0; uj < run; ++uj)
+        {
+            value += p[uj];
+            pValues[ui + uj] = value;
+        }
+        p  += run;
+        ui += run;
+        if(ui == count || run == 16)
+        {
+            continue;
+        }
+        // a varint of several bytes
+        uint64_t delta = 0;
+        unsigned int shift = 0;
+        do
+        {
+            delta |= static_cast<uint64_t>(*p & 0x7F) << shift;
+            shift += 7;
+        }
+        while(*p++ & 0x80);
+        value += delta;
+        pValues[ui++] = value;
+    }
+    return p;
+}
+
+template <class Pred> bool simple_inverted_index<Pred>::Lookup(std::vector<uint64_t> &roLines, std::string_view token) const
+{
+    roLines.clear();
+    const STerm *pTerm = FindTerm(token);
+    if(pTerm == NULL)
+    {
+        return false;
+    }
+    roLines.resize(pTerm->count);
+    DecodeDeltas(m_pPostings + pTerm->postingsOffset, pTerm->count, roLines.data());
+    return true;
+}
+
+template <class Pred> void simple_inverted_index<Pred>::QueryAnd(std::vector<uint64_t> &roLines, const std::vector<std::string_view> &roTokens) const
+{
+    roLines.clear();
+    // intersect the shortest lists first, so that the result shrinks fast
+    std::vector<const STerm*> terms;
+    for(std::size_t ui = 0; ui < roTokens.size(); ++ui)
+    {
+        const STerm *pTerm = FindTerm(roTokens[ui]);
+        if(pTerm == NULL)
+        {
+            return;
+        }
+        terms.push_back(pTerm);
+    }
+    if(terms.empty())
+    {
+        return;
+    }
+    std::sort(terms.begin(), terms.end(), [](const STerm *pLhs, const STerm *pRhs)
+    {
+        return pLhs->count < pRhs->count;
+    });
+    roLines.resize(terms[0]->count);
+    DecodeDeltas(m_pPostings + terms[0]->postingsOffset, terms[0]->count, roLines.data());
+    std::vector<uint64_t> lines;
+    for(std::size_t ui = 1; ui < terms.size() && !roLines.empty(); ++ui)
+    {
+        lines.resize(terms[ui]->count);
+        DecodeDeltas(m_pPostings + terms[ui]->postingsOffset, terms[ui]->count, lines.data());
+        // binary search of the (few) remaining lines in the longer list
+        std::size_t kept = 0;
+        std::vector<uint64_t>::const_iterator it = lines.begin();
+        for(std::size_t uj = 0; uj < roLines.size(); ++uj)
+        {
+            it = std::lower_bound(it, static_cast<std::vector<uint64_t>::const_iterator>(lines.end()), roLines[uj]);
+            if(it == lines.end())
+            {
+                break;
+            }
+            if(*it == roLines[uj])
+            {
+                roLines[kept++] = roLines[uj];
+            }
+        }
+        roLines.resize(kept);
+    }
+}
+
+template <class Pred> void simple_inverted_index<Pred>::QueryOr(std::vector<uint64_t> &roLines, const std::vector<std::string_view> &roTokens) const
+{
+    roLines.clear();
+    std::vector<uint64_t> lines;
+    std::vector<uint64_t> merged;
+    for(std::size_t ui = 0; ui < roTokens.size(); ++ui)
+    {
+        if(!Lookup(lines, roTokens[ui]))
+        {
+            continue;
+        }
+        merged.clear();
+        std::set_union(roLines.begin(), roLines.end(), lines.begin(), lines.end(), std::back_inserter(merged));
+        roLines.swap(merged);
+    }
+}
+
+/** @}*/
+
+#endif // SIMPLE_INVERTED_INDEX_HPP
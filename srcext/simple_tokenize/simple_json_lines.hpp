@@ -0,0 +1,443 @@
+/*!
+ * \file simple_json_lines.hpp
+ * \brief Extraction of top-level keys from JSON lines without building a document.
+ *  A structural index of 64 bytes (quotes, braces, brackets, colons and commas
+ *  outside of strings) is computed at once with SSE2 and bit operations, only
+ *  these positions are visited. The keys are looked up in a simple_kv_schema.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_JSON_LINES_HPP
+#define SIMPLE_JSON_LINES_HPP
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+
+#include "simple_kv_parser.hpp"
+#include "simple_simd.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief The type of a JSON value, which is found by simple_json_lines_parser.
+enum ESimpleJsonType
+{
+    SIMPLE_JSON_NONE = 0,
+    SIMPLE_JSON_STRING,
+    SIMPLE_JSON_NUMBER,
+    SIMPLE_JSON_BOOLEAN,
+    SIMPLE_JSON_NULL,
+    SIMPLE_JSON_OBJECT,
+    SIMPLE_JSON_ARRAY
+};
+
+/// \brief This class extracts the values of known top-level keys of a JSON object in one pass.
+///  The values are views into the line: the content of a string without the quotes (escape
+///  sequences are kept, see Unescape()), the text of any other value, e.g. a nested object.
+///  Nested objects are skipped without looking at their keys. The scan stops, as soon as every
+///  key of the schema has been found. In case a key appears several times, the first value is kept.
+///  Keys are compared in their escaped form.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         static constexpr auto schema = simple_make_kv_schema("user", "status");
+///         simple_json_lines_parser<2> parser(schema);
+///         parser.Parse("{\"status\":200,\"user\":\"bob\",\"tags\":[\"a\"]}");
+///         std::string_view user = parser.Get(schema.Find("user"));   // bob
+///  \endcode
+template < std::size_t N > class simple_json_lines_parser
+{
+    public:
+        explicit simple_json_lines_parser(const simple_kv_schema<N> &roSchema)
+            : m_schema(roSchema)
+            , m_values()
+            , m_types()
+            , m_escaped()
+            , m_known(0)
+        {}
+
+        /// Parse a line, the values of the previous line are removed.
+        /// \param line --> a JSON object, it has to outlive the values
+        /// \return <-- the number of distinct known keys in the line, 0 in case it is no object
+        std::size_t Parse(std::string_view line)
+        {
+            m_values.fill(std::string_view());
+            m_types.fill(SIMPLE_JSON_NONE);
+            m_escaped.fill(false);
+            m_known = 0;
+
+            const char *p = line.data();
+            const std::size_t size = line.size();
+            unsigned int depth = 0;
+            EState state = EXPECT_KEY;
+            const char *keyBeg   = NULL;
+            const char *valueBeg = NULL;
+            std::size_t slot = simple_kv_schema<N>::NPOS;
+            // the state at the end of the previous block
+            uint64_t inStringCarry = 0;
+            uint64_t escapeCarry   = 0;
+            char tail[64];
+            for(std::size_t pos = 0; pos < size; pos += 64)
+            {
+                const char *block = p + pos;
+                if(size - pos < 64)
+                {
+                    // the blanks of the padding are no events
+                    memset(tail, ' ', sizeof(tail));
+                    memcpy(tail, p + pos, size - pos);
+                    block = tail;
+                }
+                uint64_t quotes      = 0;
+                uint64_t backslashes = 0;
+                uint64_t structural  = 0;
+                for(unsigned int part = 0; part < 4; ++part)
+                {
+                    const char *p16 = block + 16 * part;
+                    quotes      |= static_cast<uint64_t>(simple_simd::MatchMask16(p16, '"'))  << (16 * part);
+                    backslashes |= static_cast<uint64_t>(simple_simd::MatchMask16(p16, '\\')) << (16 * part);
+                    structural  |= static_cast<uint64_t>(simple_simd::MatchMask16(p16, '{') | simple_simd::MatchMask16(p16, '}')
+                                                         | simple_simd::MatchMask16(p16, '[') | simple_simd::MatchMask16(p16, ']')
+                                                         | simple_simd::MatchMask16(p16, ':') | simple_simd::MatchMask16(p16, ',')) << (16 * part);
+                }
+                if(backslashes != 0 || escapeCarry != 0)
+                {
+                    quotes &= ~FindEscaped(backslashes, escapeCarry);
+                }
+                // bit i is set, in case byte i is within a string (the opening quote included)
+                const uint64_t inString = PrefixXor(quotes) ^ inStringCarry;
+                inStringCarry = static_cast<uint64_t>(0) - (inString >> 63);
+                structural &= ~inString;
+                uint64_t events = quotes | structural;
+                while(events != 0)
+                {
+                    const unsigned int index = CountTrailingZeros64(events);
+                    events &= events - 1;
+                    const char *at = p + pos + index;
+                    const char c   = block[index];
+                    if(depth == 0)
+                    {
+                        // the line has to start with an object
+                        if(c != '{')
+                        {
+                            return 0;
+                        }
+                        depth = 1;
+                        continue;
+                    }
+                    switch(c)
+                    {
+                        case '"':
+                        {
+                            if(depth != 1 || state == EXPECT_VALUE)
+                            {
+                                break;
+                            }
+                            if(inString & (static_cast<uint64_t>(1) << index))
+                            {
+                                keyBeg = at + 1;
+                            }
+                            else if(keyBeg != NULL)
+                            {
+                                slot  = m_schema.Find(std::string_view(keyBeg, static_cast<std::size_t>(at - keyBeg)));
+                                state = EXPECT_COLON;
+                            }
+                            break;
+                        }
+                        case ':':
+                        {
+                            if(depth == 1 && state == EXPECT_COLON)
+                            {
+                                valueBeg = at + 1;
+                                state    = EXPECT_VALUE;
+                            }
+                            break;
+                        }
+                        case ',':
+                        {
+                            if(depth != 1)
+                            {
+                                break;
+                            }
+                            if(state == EXPECT_VALUE && Store(slot, valueBeg, at) && m_known == N)
+                            {
+                                return m_known;
+                            }
+                            state  = EXPECT_KEY;
+                            keyBeg = NULL;
+                            break;
+                        }
+                        case '{':
+                        case '[':
+                        {
+                            ++depth;
+                            break;
+                        }
+                        default: // '}' and ']'
+                        {
+                            if(depth == 1)
+                            {
+                                // the end of the object
+                                if(state == EXPECT_VALUE)
+                                {
+                                    Store(slot, valueBeg, at);
+                                }
+                                return m_known;
+                            }
+                            --depth;
+                            break;
+                        }
+                    }
+                }
+            }
+            return m_known;
+        }
+
+        /// \return true, in case the last line contains the key of the slot
+        bool Has(std::size_t slot) const
+        {
+            return slot < N && m_types[slot] != SIMPLE_JSON_NONE;
+        }
+
+        /// \return the value of the slot in the last line or an empty view
+        std::string_view Get(std::size_t slot) const
+        {
+            return slot < N ? m_values[slot] : std::string_view();
+        }
+
+        /// \return the type of the value of the slot in the last line
+        ESimpleJsonType GetType(std::size_t slot) const
+        {
+            return slot < N ? m_types[slot] : SIMPLE_JSON_NONE;
+        }
+
+        /// \return true, in case the value of the slot is a string with escape sequences
+        bool IsEscaped(std::size_t slot) const
+        {
+            return slot < N && m_escaped[slot];
+        }
+
+        /// Decode the escape sequences of a JSON string, \\uXXXX is converted to UTF-8.
+        /// \param roResult <-- the decoded string
+        /// \param str      --> the content of a string without the quotes
+        /// \return <-- false, in case of an invalid escape sequence
+        static bool Unescape(std::string &roResult, std::string_view str)
+        {
+            roResult.clear();
+            roResult.reserve(str.size());
+            for(std::size_t ui = 0; ui < str.size(); ++ui)
+            {
+                if(str[ui] != '\\')
+                {
+                    roResult += str[ui];
+                    continue;
+                }
+                if(++ui == str.size())
+                {
+                    return false;
+                }
+                switch(str[ui])
+                {
+                    case '"':  roResult += '"';  break;
+                    case '\\': roResult += '\\'; break;
+                    case '/':  roResult += '/';  break;
+                    case 'b':  roResult += '\b'; break;
+                    case 'f':  roResult += '\f'; break;
+                    case 'n':  roResult += '\n'; break;
+                    case 'r':  roResult += '\r'; break;
+                    case 't':  roResult += '\t'; break;
+                    case 'u':
+                    {
+                        uint32_t codePoint = 0;
+                        if(!ReadHex4(str, ui + 1, codePoint))
+                        {
+                            return false;
+                        }
+                        ui += 4;
+                        // a surrogate pair
+                        if(codePoint >= 0xD800 && codePoint <= 0xDBFF)
+                        {
+                            uint32_t low = 0;
+                            if(ui + 2 >= str.size() || str[ui + 1] != '\\' || str[ui + 2] != 'u'
+                                    || !ReadHex4(str, ui + 3, low) || low < 0xDC00 || low > 0xDFFF)
+                            {
+                                return false;
+                            }
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                            ui += 6;
+                        }
+                        AppendUtf8(roResult, codePoint);
+                        break;
+                    }
+                    default:
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+    private:
+
+        enum EState
+        {
+            EXPECT_KEY,
+            EXPECT_COLON,
+            EXPECT_VALUE
+        };
+
+        /// \return a mask of the bytes, which follow an odd number of backslashes.
+        ///  The runs of backslashes are found by an addition, which carries through each run
+        ///  (the method of simdjson), roCarry is 1, in case the next block starts escaped.
+        static uint64_t FindEscaped(uint64_t backslashes, uint64_t &roCarry)
+        {
+            const uint64_t evenBits = 0x5555555555555555ULL;
+            backslashes &= ~roCarry;
+            const uint64_t followsEscape = (backslashes << 1) | roCarry;
+            const uint64_t oddStarts     = backslashes & ~evenBits & ~followsEscape;
+            const uint64_t sum           = oddStarts + backslashes;
+            roCarry = (sum < backslashes) ? 1 : 0;
+            const uint64_t invertMask = sum << 1;
+            return (evenBits ^ invertMask) & followsEscape;
+        }
+
+        /// \return bit i is the XOR of the bits 0 to i, i.e. set between an opening and a closing quote
+        static uint64_t PrefixXor(uint64_t mask)
+        {
+            mask ^= mask << 1;
+            mask ^= mask << 2;
+            mask ^= mask << 4;
+            mask ^= mask << 8;
+            mask ^= mask << 16;
+            mask ^= mask << 32;
+            return mask;
+        }
+
+        static unsigned int CountTrailingZeros64(uint64_t mask)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned int>(__builtin_ctzll(mask));
+#else
+            unsigned int index = 0;
+            while((mask & 1U) == 0)
+            {
+                mask >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        /// Store the value in [beg, end) without the surrounding white spaces.
+        /// \return <-- true, in case a known key got its first value
+        bool Store(std::size_t slot, const char *beg, const char *end)
+        {
+            if(slot == simple_kv_schema<N>::NPOS || m_types[slot] != SIMPLE_JSON_NONE)
+            {
+                return false;
+            }
+            while(beg != end && IsWhiteSpace(*beg))
+            {
+                ++beg;
+            }
+            while(end != beg && IsWhiteSpace(*(end - 1)))
+            {
+                --end;
+            }
+            if(beg == end)
+            {
+                return false;
+            }
+            ESimpleJsonType type = SIMPLE_JSON_NUMBER;
+            switch(*beg)
+            {
+                case '"':
+                {
+                    if(end - beg < 2 || *(end - 1) != '"')
+                    {
+                        return false;
+                    }
+                    ++beg;
+                    --end;
+                    type = SIMPLE_JSON_STRING;
+                    m_escaped[slot] = memchr(beg, '\\', static_cast<std::size_t>(end - beg)) != NULL;
+                    break;
+                }
+                case '{': type = SIMPLE_JSON_OBJECT;  break;
+                case '[': type = SIMPLE_JSON_ARRAY;   break;
+                case 't':
+                case 'f': type = SIMPLE_JSON_BOOLEAN; break;
+                case 'n': type = SIMPLE_JSON_NULL;    break;
+                default:  break;
+            }
+            m_values[slot] = std::string_view(beg, static_cast<std::size_t>(end - beg));
+            m_types[slot]  = type;
+            ++m_known;
+            return true;
+        }
+
+        static bool IsWhiteSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        static bool ReadHex4(std::string_view str, std::size_t pos, uint32_t &roValue)
+        {
+            if(pos + 4 > str.size())
+            {
+                return false;
+            }
+            roValue = 0;
+            for(std::size_t ui = pos; ui < pos + 4; ++ui)
+            {
+                const char c = str[ui];
+                const int digit = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+                if(digit < 0)
+                {
+                    return false;
+                }
+                roValue = (roValue << 4) | static_cast<uint32_t>(digit);
+            }
+            return true;
+        }
+
+        static void AppendUtf8(std::string &roResult, uint32_t codePoint)
+        {
+            if(codePoint < 0x80)
+            {
+                roResult += static_cast<char>(codePoint);
+            }
+            else if(codePoint < 0x800)
+            {
+                roResult += static_cast<char>(0xC0 | (codePoint >> 6));
+                roResult += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if(codePoint < 0x10000)
+            {
+                roResult += static_cast<char>(0xE0 | (codePoint >> 12));
+                roResult += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                roResult += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                roResult += static_cast<char>(0xF0 | (codePoint >> 18));
+                roResult += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                roResult += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                roResult += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+
+        simple_kv_schema<N>                  m_schema;
+        std::array<std::string_view, N>      m_values;
+        std::array<ESimpleJsonType, N>       m_types;
+        std::array<bool, N>                  m_escaped;
+        std::size_t                          m_known;
+};
+
+/** @}*/
+
+#endif // SIMPLE_JSON_LINES_HPP
@@ -0,0 +1,270 @@
+/*!
+ * \file simple_kv_parser.hpp
+ * \brief A parser for lines of key=value pairs, e.g. structured log lines.
+ *  The known keys are arranged at compile time by a perfect hash, so that every
+ *  key of a line is mapped to its slot by one hash computation.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_KV_PARSER_HPP
+#define SIMPLE_KV_PARSER_HPP
+
+#include <array>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief A set of N keys with a collision free hash table, which is built by the compiler.
+///  The table has at least twice as many entries as keys, the seed of the hash function
+///  is searched until no two keys share an entry. A schema with duplicate keys, or one, for
+///  which no seed is found within MAX_SEEDS tries, is invalid: IsValid() returns false and
+///  Find() knows no key.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         constexpr auto schema = simple_make_kv_schema("user", "ip", "status");
+///         static_assert(schema.IsValid(), "duplicate keys");
+///         constexpr std::size_t STATUS = schema.Find("status");    // 2
+///  \endcode
+template <std::size_t N> class simple_kv_schema
+{
+    static_assert(N > 0, "the schema needs at least one key");
+
+    public:
+        /// the result of Find() for an unknown key
+        static constexpr std::size_t NPOS = static_cast<std::size_t>(-1);
+        /// the number of seeds, which are tried, before the schema is given up
+        static constexpr uint64_t MAX_SEEDS = 1 << 16;
+
+        constexpr explicit simple_kv_schema(const std::array<std::string_view, N> &roKeys)
+            : m_keys(roKeys)
+            , m_entries()
+            , m_seed(0)
+            , m_bValid(false)
+        {
+            ClearEntries();
+            // duplicate keys share their entry with every seed
+            if(HasDuplicates())
+            {
+                return;
+            }
+            for(uint64_t seed = 1; seed <= MAX_SEEDS; ++seed)
+            {
+                if(TryBuild(seed))
+                {
+                    m_seed   = seed;
+                    m_bValid = true;
+                    return;
+                }
+            }
+            ClearEntries();
+        }
+
+        /// \return false, in case the keys contain duplicates or no collision free seed was found
+        constexpr bool IsValid(void) const
+        {
+            return m_bValid;
+        }
+
+        /// \return the slot of the key, i.e. its index in the schema, or NPOS
+        constexpr std::size_t Find(std::string_view key) const
+        {
+            const std::size_t slot = m_entries[Hash(m_seed, key) & (TABLE_SIZE - 1)];
+            // an unknown key may hash to the entry of a known one, so the key is compared once
+            if(slot == NPOS || m_keys[slot] != key)
+            {
+                return NPOS;
+            }
+            return slot;
+        }
+
+        constexpr std::string_view GetKey(std::size_t slot) const
+        {
+            return m_keys[slot];
+        }
+
+        static constexpr std::size_t size(void)
+        {
+            return N;
+        }
+
+    private:
+
+        /// the smallest power of two, that is at least twice the number of keys
+        static constexpr std::size_t TableSize(void)
+        {
+            std::size_t size = 1;
+            while(size < 2 * N)
+            {
+                size *= 2;
+            }
+            return size;
+        }
+
+        static constexpr std::size_t TABLE_SIZE = TableSize();
+
+        /// FNV-1a with a seed and a final mix of the upper bits
+        static constexpr uint64_t Hash(uint64_t seed, std::string_view key)
+        {
+            uint64_t hash = 14695981039346656037ULL ^ (seed * 0x9E3779B97F4A7C15ULL);
+            for(std::size_t ui = 0; ui < key.size(); ++ui)
+            {
+                hash ^= static_cast<unsigned char>(key[ui]);
+                hash *= 1099511628211ULL;
+            }
+            return hash ^ (hash >> 29);
+        }
+
+        constexpr void ClearEntries(void)
+        {
+            for(std::size_t ui = 0; ui < TABLE_SIZE; ++ui)
+            {
+                m_entries[ui] = NPOS;
+            }
+        }
+
+        constexpr bool HasDuplicates(void) const
+        {
+            for(std::size_t ui = 0; ui < N; ++ui)
+            {
+                for(std::size_t uj = ui + 1; uj < N; ++uj)
+                {
+                    if(m_keys[ui] == m_keys[uj])
+                    {
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        constexpr bool TryBuild(uint64_t seed)
+        {
+            ClearEntries();
+            for(std::size_t ui = 0; ui < N; ++ui)
+            {
+                std::size_t &entry = m_entries[Hash(seed, m_keys[ui]) & (TABLE_SIZE - 1)];
+                if(entry != NPOS)
+                {
+                    return false;
+                }
+                entry = ui;
+            }
+            return true;
+        }
+
+        std::array<std::string_view, N>    m_keys;
+        std::array<std::size_t, TABLE_SIZE> m_entries;
+        uint64_t                           m_seed;
+        bool                               m_bValid;
+};
+
+/// \return a schema of the given keys, the slot of a key is its position in the argument list
+template <class... Keys> constexpr simple_kv_schema<sizeof...(Keys)> simple_make_kv_schema(Keys... keys)
+{
+    return simple_kv_schema<sizeof...(Keys)>(std::array<std::string_view, sizeof...(Keys)> {{ std::string_view(keys)... }});
+}
+
+/// \brief This class splits a line into key=value pairs in one pass and stores the values
+///  of the known keys in the slots of the schema. The values are views into the line.
+///  Tokens without assignment character are skipped, in case a key appears several times,
+///  the last value is kept.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         static constexpr auto schema = simple_make_kv_schema("user", "ip", "status");
+///         simple_kv_parser<3> parser(schema);
+///         parser.Parse("ip=10.0.0.1 status=200 user=bob");
+///         std::string_view status = parser.Get(schema.Find("status"));   // "200"
+///  \endcode
+template < std::size_t N, class Pred = CIsSpace > class simple_kv_parser
+{
+    static_assert(!simple_tokenize_is_multichar<Pred>::value, "the pairs are separated by single characters");
+
+    public:
+        typedef std::pair<std::string_view, std::string_view> pair_type;
+
+        /// \param roSchema --> the known keys
+        /// \param assign   --> the character between key and value
+        /// \param roPred   --> the separator of the pairs
+        explicit simple_kv_parser(const simple_kv_schema<N> &roSchema, char assign = '=', const Pred & roPred = Pred())
+            : m_schema(roSchema)
+            , m_Pred(roPred)
+            , m_assign(assign)
+            , m_values()
+        {}
+
+        /// Parse a line, the values of the previous line are removed.
+        /// \param line      --> the line, it has to outlive the values
+        /// \param pOverflow <-- optional, the pairs of unknown keys are appended
+        /// \return <-- the number of distinct known keys in the line
+        std::size_t Parse(std::string_view line, std::vector<pair_type> *pOverflow = NULL)
+        {
+            m_values.fill(std::string_view());
+            std::size_t known = 0;
+            const char *it  = line.data();
+            const char *end = it + line.size();
+            while(it != end)
+            {
+                //Eat separators
+                while(it != end && m_Pred(*it)) ++it;
+                const char *keyBeg = it;
+                const char *assign = NULL;
+                // find the end of the pair and its first assignment character in the same pass
+                for(; it != end && !m_Pred(*it); ++it)
+                {
+                    if(*it == m_assign && assign == NULL)
+                    {
+                        assign = it;
+                    }
+                }
+                if(assign == NULL)
+                {
+                    continue;
+                }
+                const std::string_view key(keyBeg, static_cast<std::size_t>(assign - keyBeg));
+                const std::string_view value(assign + 1, static_cast<std::size_t>(it - assign - 1));
+                const std::size_t slot = m_schema.Find(key);
+                if(slot != simple_kv_schema<N>::NPOS)
+                {
+                    known += m_values[slot].data() == NULL ? 1 : 0;
+                    // an empty value points behind the assignment character, so it is distinguishable from a missing one
+                    m_values[slot] = value;
+                }
+                else if(pOverflow != NULL)
+                {
+                    pOverflow->push_back(pair_type(key, value));
+                }
+            }
+            return known;
+        }
+
+        /// \return true, in case the last line contains the key of the slot
+        bool Has(std::size_t slot) const
+        {
+            return slot < N && m_values[slot].data() != NULL;
+        }
+
+        /// \return the value of the slot in the last line or an empty view
+        std::string_view Get(std::size_t slot) const
+        {
+            return slot < N ? m_values[slot] : std::string_view();
+        }
+
+    private:
+        simple_kv_schema<N>               m_schema;
+        Pred                              m_Pred;
+        char                              m_assign;
+        std::array<std::string_view, N>   m_values;
+};
+
+/** @}*/
+
+#endif // SIMPLE_KV_PARSER_HPP
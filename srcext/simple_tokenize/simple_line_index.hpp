@@ -0,0 +1,447 @@
+/*!
+ * \file simple_line_index.hpp
+ * \brief A persistent index of the line offsets of a file, which gives random access
+ *  to its records (lines) without tokenizing the file from the start.
+ *
+ *  The index is built by counting and locating the newlines of a memory mapped file
+ *  with SSE2 in parallel over chunks. It is stored next to the file (\<file\>.lidx)
+ *  and memory mapped on later runs, as long as the size and modification time of
+ *  the file did not change. In case the index cannot be written (e.g. in a read-only
+ *  directory), it is kept in memory.
+ *
+ *  Index file format (version 1, native byte order):
+ *   - header: magic "SLIDX", version, checkpoint interval, size and modification time
+ *     of the indexed file, number of records and number of checkpoints (64 bytes)
+ *   - checkpoints: the 64 bit offset of every record, whose number is a multiple
+ *     of the checkpoint interval
+ *   - offsets: the 32 bit offset of every record relative to its checkpoint
+ *  This takes a little more than 4 bytes per record, a lookup reads two values.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_LINE_INDEX_HPP
+#define SIMPLE_LINE_INDEX_HPP
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simple_mapped_file.hpp"
+#include "simple_simd.hpp"
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief Random access to the lines of a (large) file.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_line_index index;
+///         if(index.Open("access.log"))   // builds access.log.lidx, in case it is missing or outdated
+///         {
+///             std::vector<std::string> fields;
+///             index.TokenizeRecord(fields, 123456789);
+///         }
+///  \endcode
+class simple_line_index
+{
+    public:
+
+        static constexpr uint32_t VERSION             = 1;
+        static constexpr uint32_t CHECKPOINT_INTERVAL = 64;
+
+        simple_line_index(void);
+        ~simple_line_index(void);
+
+        simple_line_index(const simple_line_index &) = delete;
+        simple_line_index& operator=(const simple_line_index &) = delete;
+
+        /// Map a file and its index. The index is (re)built, in case it does not exist,
+        /// has an other version or does not belong to the current state of the file.
+        /// A built index, which cannot be written, is used from memory.
+        /// \param strFileName     --> the file to be indexed
+        /// \param numberOfThreads --> threads used to build the index, 0 means one per core
+        /// \return false, in case the file cannot be mapped or the index cannot be built
+        bool Open(const std::string &strFileName, unsigned int numberOfThreads = 0);
+
+        void Close(void);
+
+        /// Build the index of a file and write it to strIndexFileName.
+        static bool Build(const std::string &strFileName, const std::string &strIndexFileName, unsigned int numberOfThreads = 0);
+
+        static std::string GetIndexFileName(const std::string &strFileName)
+        {
+            return strFileName + ".lidx";
+        }
+
+        /// \return true, in case the last call of Open() had to build the index
+        bool WasIndexBuilt(void) const
+        {
+            return m_bIndexBuilt;
+        }
+
+        /// \return true, in case the index could not be written and is kept in memory
+        bool IsIndexInMemory(void) const
+        {
+            return !m_memoryIndex.empty();
+        }
+
+        std::size_t GetNumberOfRecords(void) const
+        {
+            return (m_pHeader != NULL) ? static_cast<std::size_t>(m_pHeader->numberOfRecords) : 0;
+        }
+
+        /// \return the offset of record n in the file
+        uint64_t GetRecordOffset(std::size_t n) const
+        {
+            return m_pCheckpoints[n / CHECKPOINT_INTERVAL] + m_pOffsets[n];
+        }
+
+        /// \return the record n without its newline, n has to be less than GetNumberOfRecords()
+        std::string_view GetRecord(std::size_t n) const;
+
+        /// Tokenize record n, see simple_tokenize<Pred>::Tokenize
+        template <class Pred> void TokenizeRecord(std::vector<std::string> &roResult, std::size_t n, const Pred &roPred = Pred()) const
+        {
+            roResult.clear();
+            simple_tokenize<Pred>::ForEachToken(GetRecord(n), [&roResult](std::string_view token)
+            {
+                roResult.push_back(std::string(token));
+            }, roPred);
+        }
+
+    private:
+
+        struct SHeader
+        {
+            char     magic[8];
+            uint32_t version;
+            uint32_t checkpointInterval;
+            uint64_t fileSize;
+            int64_t  fileModificationTime;      // seconds
+            int64_t  fileModificationTimeNsec;  // nanoseconds
+            uint64_t numberOfRecords;
+            uint64_t numberOfCheckpoints;
+            uint64_t reserved;
+        };
+
+        static void FillHeader(SHeader &header, const struct stat &status, uint64_t numberOfRecords);
+        /// Build the index of a file in memory, roIndex holds its roIndexSize bytes.
+        static bool CreateIndex(const std::string &strFileName, std::vector<uint64_t> &roIndex, std::size_t &roIndexSize, unsigned int numberOfThreads);
+        static bool WriteIndex(const std::string &strIndexFileName, const char *pIndex, std::size_t size);
+        bool MapIndex(const std::string &strIndexFileName);
+        /// Check the header of an index and refer to its parts.
+        bool SetIndex(const char *pIndex, std::size_t size);
+
+        const char     *m_pData;
+        std::size_t     m_dataSize;
+        const char     *m_pIndex;
+        std::size_t     m_indexSize;
+        const SHeader  *m_pHeader;
+        const uint64_t *m_pCheckpoints;
+        const uint32_t *m_pOffsets;
+        bool            m_bIndexBuilt;
+        /// the index, which could not be written
+        std::vector<uint64_t> m_memoryIndex;
+};
+
+inline simple_line_index::simple_line_index(void)
+    : m_pData(NULL)
+    , m_dataSize(0)
+    , m_pIndex(NULL)
+    , m_indexSize(0)
+    , m_pHeader(NULL)
+    , m_pCheckpoints(NULL)
+    , m_pOffsets(NULL)
+    , m_bIndexBuilt(false)
+    , m_memoryIndex()
+{}
+
+inline simple_line_index::~simple_line_index(void)
+{
+    Close();
+}
+
+inline void simple_line_index::Close(void)
+{
+    simple_mapped_file::Unmap(m_pData, m_dataSize);
+    simple_mapped_file::Unmap(m_pIndex, m_indexSize);
+    m_memoryIndex.clear();
+    m_memoryIndex.shrink_to_fit();
+    m_pHeader      = NULL;
+    m_pCheckpoints = NULL;
+    m_pOffsets     = NULL;
+}
+
+inline void simple_line_index::FillHeader(SHeader &header, const struct stat &status, uint64_t numberOfRecords)
+{
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "SLIDX", 5);
+    header.version                  = VERSION;
+    header.checkpointInterval       = CHECKPOINT_INTERVAL;
+    header.fileSize                 = static_cast<uint64_t>(status.st_size);
+    header.fileModificationTime     = static_cast<int64_t>(status.st_mtim.tv_sec);
+    header.fileModificationTimeNsec = static_cast<int64_t>(status.st_mtim.tv_nsec);
+    header.numberOfRecords          = numberOfRecords;
+    header.numberOfCheckpoints      = (numberOfRecords + CHECKPOINT_INTERVAL - 1) / CHECKPOINT_INTERVAL;
+}
+
+inline bool simple_line_index::Build(const std::string &strFileName, const std::string &strIndexFileName, unsigned int numberOfThreads)
+{
+    std::vector<uint64_t> index;
+    std::size_t indexSize = 0;
+    return CreateIndex(strFileName, index, indexSize, numberOfThreads)
+           && WriteIndex(strIndexFileName, reinterpret_cast<const char*>(index.data()), indexSize);
+}
+
+inline bool simple_line_index::CreateIndex(const std::string &strFileName, std::vector<uint64_t> &roIndex, std::size_t &roIndexSize, unsigned int numberOfThreads)
+{
+    const char *pData = NULL;
+    std::size_t size  = 0;
+    struct stat status;
+    if(!simple_mapped_file::Map(strFileName, pData, size, status))
+    {
+        return false;
+    }
+    if(numberOfThreads == 0)
+    {
+        numberOfThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    // small files are not worth the threads
+    const std::size_t minimalChunkSize = 1 << 20;
+    numberOfThreads = static_cast<unsigned int>(std::max<std::size_t>(1, std::min<std::size_t>(numberOfThreads, size / minimalChunkSize)));
+    const std::size_t chunkSize = size / numberOfThreads;
+
+    // first pass: count the newlines of every chunk
+    std::vector<uint64_t> newlines(numberOfThreads + 1, 0);
+    std::vector<std::thread> threads;
+    for(unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+        threads.push_back(std::thread([&newlines, pData, size, chunkSize, numberOfThreads, t]()
+        {
+            const char *beg = pData + t * chunkSize;
+            const char *end = (t + 1 == numberOfThreads) ? pData + size : beg + chunkSize;
+            newlines[t + 1] = simple_simd::CountByte(beg, end, '\n');
+        }));
+    }
+    for(std::size_t t = 0; t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+    threads.clear();
+    // newlines[t] becomes the number of newlines in front of chunk t
+    for(unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+        newlines[t + 1] += newlines[t];
+    }
+    const bool bTrailingNewline = (size > 0) && (pData[size - 1] == '\n');
+    const uint64_t numberOfRecords = (size == 0) ? 0 : newlines[numberOfThreads] + 1 - (bTrailingNewline ? 1 : 0);
+
+    SHeader header;
+    FillHeader(header, status, numberOfRecords);
+    // the index is built in its file format, the 64 bit words keep the checkpoints aligned
+    roIndexSize = sizeof(SHeader) + header.numberOfCheckpoints * sizeof(uint64_t) + numberOfRecords * sizeof(uint32_t);
+    roIndex.assign((roIndexSize + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+    char *pIndex = reinterpret_cast<char*>(roIndex.data());
+    memcpy(pIndex, &header, sizeof(header));
+    uint64_t *checkpoints = reinterpret_cast<uint64_t*>(pIndex + sizeof(SHeader));
+    uint32_t *offsets     = reinterpret_cast<uint32_t*>(pIndex + sizeof(SHeader) + header.numberOfCheckpoints * sizeof(uint64_t));
+    if(numberOfRecords > 0)
+    {
+        // record 0 starts at the beginning of the file, record k + 1 behind newline k
+        checkpoints[0] = 0;
+    }
+
+    // second pass: locate the records. The checkpoint of the first records of a chunk may be
+    // located in a previous chunk, their absolute offsets are resolved after all threads finished.
+    std::vector< std::vector< std::pair<uint64_t, uint64_t> > > unresolved(numberOfThreads);
+    // char instead of bool, because the elements of std::vector<bool> share their words between the threads
+    std::vector<char> overflow(numberOfThreads, 0);
+    for(unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+        threads.push_back(std::thread([&, t]()
+        {
+            const char *beg = pData + t * chunkSize;
+            const char *end = (t + 1 == numberOfThreads) ? pData + size : beg + chunkSize;
+            uint64_t record = newlines[t];
+            uint64_t checkpoint = 0;
+            bool bCheckpointKnown = (t == 0);
+            simple_simd::ForEachByte(beg, end, '\n', [&](const char *pNewline)
+            {
+                ++record;
+                if(record >= numberOfRecords)
+                {
+                    return;
+                }
+                const uint64_t offset = static_cast<uint64_t>(pNewline - pData) + 1;
+                if(record % CHECKPOINT_INTERVAL == 0)
+                {
+                    checkpoints[record / CHECKPOINT_INTERVAL] = offset;
+                    checkpoint       = offset;
+                    bCheckpointKnown = true;
+                }
+                if(!bCheckpointKnown)
+                {
+                    unresolved[t].push_back(std::make_pair(record, offset));
+                }
+                else if(offset - checkpoint > UINT32_MAX)
+                {
+                    overflow[t] = 1;
+                }
+                else
+                {
+                    offsets[record] = static_cast<uint32_t>(offset - checkpoint);
+                }
+            });
+        }));
+    }
+    for(std::size_t t = 0; t < threads.size(); ++t)
+    {
+        threads[t].join();
+    }
+    simple_mapped_file::Unmap(pData, size);
+
+    bool bOverflow = false;
+    for(unsigned int t = 0; t < numberOfThreads; ++t)
+    {
+        bOverflow = bOverflow || (overflow[t] != 0);
+        for(std::size_t ui = 0; ui < unresolved[t].size(); ++ui)
+        {
+            const uint64_t record = unresolved[t][ui].first;
+            const uint64_t offset = unresolved[t][ui].second - checkpoints[record / CHECKPOINT_INTERVAL];
+            bOverflow = bOverflow || (offset > UINT32_MAX);
+            offsets[record] = static_cast<uint32_t>(offset);
+        }
+    }
+    // lines of more than 4GB / CHECKPOINT_INTERVAL cannot be indexed
+    return !bOverflow;
+}
+
+inline bool simple_line_index::WriteIndex(const std::string &strIndexFileName, const char *pIndex, std::size_t size)
+{
+    // write to a temporary file and rename it, so that readers never see a partial index
+    const std::string strTempFileName(strIndexFileName + ".tmp");
+    FILE *pFile = fopen(strTempFileName.c_str(), "wb");
+    if(pFile == NULL)
+    {
+        return false;
+    }
+    bool bSuccess = (fwrite(pIndex, 1, size, pFile) == size);
+    bSuccess = (fclose(pFile) == 0) && bSuccess;
+    if(!bSuccess || rename(strTempFileName.c_str(), strIndexFileName.c_str()) != 0)
+    {
+        (void)remove(strTempFileName.c_str());
+        return false;
+    }
+    return true;
+}
+
+inline bool simple_line_index::MapIndex(const std::string &strIndexFileName)
+{
+    struct stat status;
+    if(!simple_mapped_file::Map(strIndexFileName, m_pIndex, m_indexSize, status))
+    {
+        return false;
+    }
+    if(!SetIndex(m_pIndex, m_indexSize))
+    {
+        simple_mapped_file::Unmap(m_pIndex, m_indexSize);
+        return false;
+    }
+    return true;
+}
+
+inline bool simple_line_index::SetIndex(const char *pIndex, std::size_t size)
+{
+    if(size < sizeof(SHeader))
+    {
+        return false;
+    }
+    const SHeader *pHeader = reinterpret_cast<const SHeader*>(pIndex);
+    const uint64_t expectedSize = sizeof(SHeader)
+                                  + pHeader->numberOfCheckpoints * sizeof(uint64_t)
+                                  + pHeader->numberOfRecords * sizeof(uint32_t);
+    if(memcmp(pHeader->magic, "SLIDX", 5) != 0
+            || pHeader->version != VERSION
+            || pHeader->checkpointInterval != CHECKPOINT_INTERVAL
+            || expectedSize != size)
+    {
+        return false;
+    }
+    m_pHeader      = pHeader;
+    m_pCheckpoints = reinterpret_cast<const uint64_t*>(pIndex + sizeof(SHeader));
+    m_pOffsets     = reinterpret_cast<const uint32_t*>(pIndex + sizeof(SHeader) + pHeader->numberOfCheckpoints * sizeof(uint64_t));
+    return true;
+}
+
+inline bool simple_line_index::Open(const std::string &strFileName, unsigned int numberOfThreads)
+{
+    Close();
+    m_bIndexBuilt = false;
+    struct stat status;
+    if(!simple_mapped_file::Map(strFileName, m_pData, m_dataSize, status))
+    {
+        return false;
+    }
+    SHeader expected;
+    FillHeader(expected, status, 0);
+
+    const std::string strIndexFileName(GetIndexFileName(strFileName));
+    if(MapIndex(strIndexFileName)
+            && m_pHeader->fileSize == expected.fileSize
+            && m_pHeader->fileModificationTime == expected.fileModificationTime
+            && m_pHeader->fileModificationTimeNsec == expected.fileModificationTimeNsec)
+    {
+        return true;
+    }
+    simple_mapped_file::Unmap(m_pIndex, m_indexSize);
+    m_pHeader = NULL;
+
+    std::vector<uint64_t> index;
+    std::size_t indexSize = 0;
+    if(!CreateIndex(strFileName, index, indexSize, numberOfThreads))
+    {
+        Close();
+        return false;
+    }
+    m_bIndexBuilt = true;
+    if(WriteIndex(strIndexFileName, reinterpret_cast<const char*>(index.data()), indexSize) && MapIndex(strIndexFileName))
+    {
+        return true;
+    }
+    // e.g. a read-only directory: the records are accessible for this run
+    m_memoryIndex.swap(index);
+    return SetIndex(reinterpret_cast<const char*>(m_memoryIndex.data()), indexSize);
+}
+
+inline std::string_view simple_line_index::GetRecord(std::size_t n) const
+{
+    const uint64_t beg = GetRecordOffset(n);
+    uint64_t end = m_dataSize;
+    if(n + 1 < GetNumberOfRecords())
+    {
+        // exclude the newline
+        end = GetRecordOffset(n + 1) - 1;
+    }
+    else if(end > beg && m_pData[end - 1] == '\n')
+    {
+        --end;
+    }
+    return std::string_view(m_pData + beg, static_cast<std::size_t>(end - beg));
+}
+
+/** @}*/
+
+#endif // SIMPLE_LINE_INDEX_HPP
@@ -0,0 +1,586 @@
+/*!
+ * \file simple_log_template.hpp
+ * \brief Online mining of log templates, e.g. "Connection from <*> closed after <*> ms",
+ *  from a stream of lines (the method of Drain).
+ *
+ *  A line is routed through a prefix tree of fixed depth: the first level is keyed
+ *  by the number of tokens, the next levels by the leading tokens. Tokens with digits
+ *  are routed to the wildcard child, as well as new tokens of a node, which has
+ *  reached its maximal number of children. A leaf holds the templates of its lines.
+ *  A line joins the most similar template (the fraction of equal tokens), in case it
+ *  reaches the threshold, the differing tokens of the template become wildcards.
+ *  Otherwise, the line starts a new template.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_LOG_TEMPLATE_HPP
+#define SIMPLE_LOG_TEMPLATE_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief Streaming log template miner over the tokens of simple_tokenize.
+///  The memory is bounded by the maximal number of templates: once it is reached,
+///  the least recently matched template is evicted and its ID is reused. The nodes
+///  of the tree, which lead to no template anymore, are removed as well.
+///  A template is reported with its tokens separated by a single blank.
+///  'tokenize_bench template' measures the lines per second on a synthetic log.
+///
+///  Every thread should mine into its own instance, the instances are combined by
+///  Merge(), which maps the template IDs of the other instance to the combined ones.
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_log_template_miner<> miner;
+///         std::vector<std::string_view> params;
+///         while(std::getline(ifs, line))
+///         {
+///             const std::size_t id = miner.Add(line, params);
+///             // e.g. id 3, params {"10.0.0.1", "17"}
+///         }
+///         std::string strTemplate = miner.GetTemplate(3);   // Connection from <*> closed after <*> ms
+///  \endcode
+template < class Pred = CIsSpace > class simple_log_template_miner
+{
+    public:
+
+        static constexpr std::size_t NPOS = static_cast<std::size_t>(-1);
+        static constexpr std::string_view WILDCARD = "<*>";
+
+        /// \param similarity   --> the minimal fraction of equal tokens, to join a template
+        /// \param depth        --> the number of leading tokens, which route a line
+        /// \param maxChildren  --> the maximal number of children of a node, including the wildcard
+        /// \param maxTemplates --> the maximal number of templates
+        /// \param roPred       --> the separator of the tokens
+        explicit simple_log_template_miner(double similarity = 0.4
+                                           , std::size_t depth = 2
+                                           , std::size_t maxChildren = 100
+                                           , std::size_t maxTemplates = 10000
+                                           , const Pred & roPred = Pred());
+
+        simple_log_template_miner(const simple_log_template_miner &) = delete;
+        simple_log_template_miner& operator=(const simple_log_template_miner &) = delete;
+
+        /// Assign a line to a template, the template is created or generalized.
+        /// \return <-- the ID of the template
+        std::size_t Add(std::string_view line)
+        {
+            return AddLine(line, NULL);
+        }
+
+        /// \param roParams <-- the tokens of the line at the wildcards of its template, views into the line
+        std::size_t Add(std::string_view line, std::vector<std::string_view> &roParams)
+        {
+            return AddLine(line, &roParams);
+        }
+
+        /// \return <-- the ID of the template, which the line would join, or NPOS. Nothing is changed.
+        std::size_t Match(std::string_view line) const;
+
+        /// \return <-- the template, an empty string for an unused ID
+        std::string GetTemplate(std::size_t id) const;
+
+        /// \return <-- the number of lines of a template
+        uint64_t GetCount(std::size_t id) const
+        {
+            return IsTemplate(id) ? m_clusters[id].count : 0;
+        }
+
+        bool IsTemplate(std::size_t id) const
+        {
+            return id < m_clusters.size() && m_clusters[id].bUsed;
+        }
+
+        /// \param roIds <-- the IDs of the templates by descending number of lines
+        void GetTemplateIds(std::vector<std::size_t> &roIds) const;
+
+        /// Add the templates of an other instance, e.g. the one of an other thread.
+        /// \param pMapping <-- optional, the ID in this instance for every ID of roOther (NPOS for unused IDs)
+        /// \return <-- false, in case roOther is this instance
+        bool Merge(const simple_log_template_miner &roOther, std::vector<std::size_t> *pMapping = NULL);
+
+        void Clear(void);
+
+        std::size_t GetNumberOfTemplates(void) const
+        {
+            return m_used;
+        }
+
+        std::size_t GetNumberOfNodes(void) const
+        {
+            return m_nodes.size() - m_freeNodes.size();
+        }
+
+        /// \return the number of evicted templates
+        uint64_t GetNumberOfEvictions(void) const
+        {
+            return m_evictions;
+        }
+
+        /// \return the number of added lines
+        uint64_t GetTotal(void) const
+        {
+            return m_total;
+        }
+
+    private:
+
+        static constexpr uint32_t NONE = UINT32_MAX;
+
+        struct SNode
+        {
+            /// the key in the children of the parent
+            std::string token;
+            uint32_t    parent;
+            /// the keys refer to the tokens of the children, which are never moved within the deque
+            std::unordered_map<std::string_view, uint32_t> children;
+            /// the templates of a leaf
+            std::vector<uint32_t> clusters;
+        };
+
+        struct SCluster
+        {
+            std::vector<std::string> tokens;
+            uint64_t count;
+            /// the serial number of the template, an evicted ID gets a new one
+            uint64_t serial;
+            uint32_t leaf;
+            /// the list of the templates by their last match, the most recent one first
+            uint32_t prev;
+            uint32_t next;
+            bool     bUsed;
+        };
+
+        std::size_t AddLine(std::string_view line, std::vector<std::string_view> *pParams)
+        {
+            m_tokens.clear();
+            simple_tokenize<Pred>::ForEachToken(line, [this](std::string_view token)
+            {
+                m_tokens.push_back(token);
+            }, m_Pred);
+            ++m_total;
+            return Insert(m_tokens, 1, pParams);
+        }
+
+        /// \return the key of a token in the tree, tokens with digits are likely parameters
+        static std::string_view GetRoutingKey(std::string_view token)
+        {
+            for(std::size_t ui = 0; ui < token.size(); ++ui)
+            {
+                if(token[ui] >= '0' && token[ui] <= '9')
+                {
+                    return WILDCARD;
+                }
+            }
+            return token;
+        }
+
+        /// \return the key of the first level
+        static std::string_view GetLengthKey(char (&buffer)[24], std::size_t count)
+        {
+            const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), count);
+            return std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer));
+        }
+
+        uint32_t FindChild(uint32_t node, std::string_view key) const
+        {
+            const std::unordered_map<std::string_view, uint32_t> &children = m_nodes[node].children;
+            std::unordered_map<std::string_view, uint32_t>::const_iterator it = children.find(key);
+            return (it != children.end()) ? it->second : NONE;
+        }
+
+        uint32_t FindLeaf(const std::vector<std::string_view> &roTokens) const;
+        uint32_t GetLeaf(const std::vector<std::string_view> &roTokens);
+        uint32_t AddChild(uint32_t parent, std::string_view key);
+        uint32_t FindCluster(uint32_t leaf, const std::vector<std::string_view> &roTokens) const;
+        std::size_t Insert(const std::vector<std::string_view> &roTokens, uint64_t count, std::vector<std::string_view> *pParams);
+        uint32_t NewCluster(void);
+        void Unlink(uint32_t id);
+        void PushFront(uint32_t id);
+        void Prune(uint32_t node);
+
+        Pred        m_Pred;
+        double      m_similarity;
+        std::size_t m_depth;
+        std::size_t m_maxChildren;
+        std::size_t m_maxTemplates;
+        uint64_t    m_total;
+        uint64_t    m_evictions;
+        uint64_t    m_serial;
+        std::size_t m_used;
+        uint32_t    m_head;
+        uint32_t    m_tail;
+        /// node 0 is the root
+        std::deque<SNode>     m_nodes;
+        std::vector<uint32_t> m_freeNodes;
+        std::vector<SCluster> m_clusters;
+        /// the tokens of the current line
+        std::vector<std::string_view> m_tokens;
+};
+
+template <class Pred> simple_log_template_miner<Pred>::simple_log_template_miner(double similarity
+        , std::size_t depth
+        , std::size_t maxChildren
+        , std::size_t maxTemplates
+        , const Pred & roPred)
+    : m_Pred(roPred)
+    , m_similarity(similarity)
+    , m_depth(depth)
+    , m_maxChildren(std::max<std::size_t>(maxChildren, 2))
+    , m_maxTemplates(std::max<std::size_t>(maxTemplates, 1))
+    , m_total(0)
+    , m_evictions(0)
+    , m_serial(0)
+    , m_used(0)
+    , m_head(NONE)
+    , m_tail(NONE)
+    , m_nodes()
+    , m_freeNodes()
+    , m_clusters()
+    , m_tokens()
+{
+    Clear();
+}
+
+template <class Pred> std::size_t simple_log_template_miner<Pred>::Match(std::string_view line) const
+{
+    std::vector<std::string_view> tokens;
+    simple_tokenize<Pred>::ForEachToken(line, [&tokens](std::string_view token)
+    {
+        tokens.push_back(token);
+    }, m_Pred);
+    const uint32_t leaf = FindLeaf(tokens);
+    if(leaf == NONE)
+    {
+        return NPOS;
+    }
+    const uint32_t id = FindCluster(leaf, tokens);
+    return (id != NONE) ? id : NPOS;
+}
+
+template <class Pred> std::string simple_log_template_miner<Pred>::GetTemplate(std::size_t id) const
+{
+    std::string strResult;
+    if(!IsTemplate(id))
+    {
+        return strResult;
+    }
+    const std::vector<std::string> &tokens = m_clusters[id].tokens;
+    for(std::size_t ui = 0; ui < tokens.size(); ++ui)
+    {
+        if(ui > 0)
+        {
+            strResult += ' ';
+        }
+        strResult += tokens[ui];
+    }
+    return strResult;
+}
+
+template <class Pred> void simple_log_template_miner<Pred>::GetTemplateIds(std::vector<std::size_t> &roIds) const
+{
+    roIds.clear();
+    for(std::size_t ui = 0; ui < m_clusters.size(); ++ui)
+    {
+        if(m_clusters[ui].bUsed)
+        {
+            roIds.push_back(ui);
+        }
+    }
+    std::sort(roIds.begin(), roIds.end(), [this](std::size_t lhs, std::size_t rhs)
+    {
+        return (m_clusters[lhs].count != m_clusters[rhs].count) ? m_clusters[lhs].count > m_clusters[rhs].count : lhs < rhs;
+    });
+}
+
+template <class Pred> bool simple_log_template_miner<Pred>::Merge(const simple_log_template_miner &roOther, std::vector<std::size_t> *pMapping)
+{
+    if(&roOther == this)
+    {
+        return false;
+    }
+    if(pMapping != NULL)
+    {
+        pMapping->assign(roOther.m_clusters.size(), NPOS);
+    }
+    // the templates are added like lines, which occurred count times
+    std::vector<std::string_view> tokens;
+    std::vector<uint64_t> serials(roOther.m_clusters.size(), 0);
+    for(std::size_t ui = 0; ui < roOther.m_clusters.size(); ++ui)
+    {
+        const SCluster &cluster = roOther.m_clusters[ui];
+        if(!cluster.bUsed)
+        {
+            continue;
+        }
+        tokens.assign(cluster.tokens.begin(), cluster.tokens.end());
+        const std::size_t id = Insert(tokens, cluster.count, NULL);
+        serials[ui] = m_clusters[id].serial;
+        if(pMapping != NULL)
+        {
+            (*pMapping)[ui] = id;
+        }
+    }
+    m_total += roOther.m_total;
+    // a later template of roOther may have evicted an earlier one
+    if(pMapping != NULL)
+    {
+        for(std::size_t ui = 0; ui < pMapping->size(); ++ui)
+        {
+            const std::size_t id = (*pMapping)[ui];
+            if(id != NPOS && (!IsTemplate(id) || m_clusters[id].serial != serials[ui]))
+            {
+                (*pMapping)[ui] = NPOS;
+            }
+        }
+    }
+    return true;
+}
+
+template <class Pred> void simple_log_template_miner<Pred>::Clear(void)
+{
+    m_total     = 0;
+    m_evictions = 0;
+    m_serial    = 0;
+    m_used      = 0;
+    m_head      = NONE;
+    m_tail      = NONE;
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_clusters.clear();
+    m_nodes.push_back(SNode());
+    m_nodes[0].parent = NONE;
+}
+
+template <class Pred> uint32_t simple_log_template_miner<Pred>::FindLeaf(const std::vector<std::string_view> &roTokens) const
+{
+    char buffer[24];
+    uint32_t node = FindChild(0, GetLengthKey(buffer, roTokens.size()));
+    const std::size_t depth = std::min(m_depth, roTokens.size());
+    for(std::size_t ui = 0; ui < depth && node != NONE; ++ui)
+    {
+        const uint32_t child = FindChild(node, GetRoutingKey(roTokens[ui]));
+        node = (child != NONE) ? child : FindChild(node, WILDCARD);
+    }
+    return node;
+}
+
+template <class Pred> uint32_t simple_log_template_miner<Pred>::GetLeaf(const std::vector<std::string_view> &roTokens)
+{
+    char buffer[24];
+    const std::string_view length = GetLengthKey(buffer, roTokens.size());
+    uint32_t node = FindChild(0, length);
+    if(node == NONE)
+    {
+        node = AddChild(0, length);
+    }
+    const std::size_t depth = std::min(m_depth, roTokens.size());
+    for(std::size_t ui = 0; ui < depth; ++ui)
+    {
+        std::string_view key = GetRoutingKey(roTokens[ui]);
+        uint32_t child = FindChild(node, key);
+        if(child == NONE)
+        {
+            // the last child of a node is reserved for the wildcard
+            if(key != WILDCARD && m_nodes[node].children.size() + 1 >= m_maxChildren)
+            {
+                key   = WILDCARD;
+                child = FindChild(node, key);
+            }
+            if(child == NONE)
+            {
+                child = AddChild(node, key);
+            }
+        }
+        node = child;
+    }
+    return node;
+}
+
+template <class Pred> uint32_t simple_log_template_miner<Pred>::AddChild(uint32_t parent, std::string_view key)
+{
+    uint32_t node = 0;
+    if(!m_freeNodes.empty())
+    {
+        node = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    }
+    else
+    {
+        node = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(SNode());
+    }
+    SNode &child = m_nodes[node];
+    child.token.assign(key.data(), key.size());
+    child.parent = parent;
+    m_nodes[parent].children[child.token] = node;
+    return node;
+}
+
+template <class Pred> uint32_t simple_log_template_miner<Pred>::FindCluster(uint32_t leaf, const std::vector<std::string_view> &roTokens) const
+{
+    // the templates of a leaf have the number of tokens of the line
+    const std::vector<uint32_t> &clusters = m_nodes[leaf].clusters;
+    uint32_t best = NONE;
+    std::size_t bestEqual = 0;
+    std::size_t bestWildcards = 0;
+    for(std::size_t ui = 0; ui < clusters.size(); ++ui)
+    {
+        const std::vector<std::string> &tokens = m_clusters[clusters[ui]].tokens;
+        std::size_t equal = 0;
+        std::size_t wildcards = 0;
+        for(std::size_t token = 0; token < tokens.size(); ++token)
+        {
+            if(tokens[token] == WILDCARD)
+            {
+                ++wildcards;
+            }
+            else if(tokens[token] == roTokens[token])
+            {
+                ++equal;
+            }
+        }
+        // on equal similarity, the more general template is preferred
+        if(best == NONE || equal > bestEqual || (equal == bestEqual && wildcards > bestWildcards))
+        {
+            best          = clusters[ui];
+            bestEqual     = equal;
+            bestWildcards = wildcards;
+        }
+    }
+    if(best == NONE)
+    {
+        return NONE;
+    }
+    const double similarity = roTokens.empty() ? 1.0 : static_cast<double>(bestEqual) / static_cast<double>(roTokens.size());
+    return (similarity >= m_similarity) ? best : NONE;
+}
+
+template <class Pred> std::size_t simple_log_template_miner<Pred>::Insert(const std::vector<std::string_view> &roTokens
+        , uint64_t count
+        , std::vector<std::string_view> *pParams)
+{
+    if(pParams != NULL)
+    {
+        pParams->clear();
+    }
+    const uint32_t leaf = FindLeaf(roTokens);
+    uint32_t id = (leaf != NONE) ? FindCluster(leaf, roTokens) : NONE;
+    if(id != NONE)
+    {
+        SCluster &cluster = m_clusters[id];
+        for(std::size_t ui = 0; ui < roTokens.size(); ++ui)
+        {
+            std::string &token = cluster.tokens[ui];
+            if(token != WILDCARD && token != roTokens[ui])
+            {
+                token.assign(WILDCARD.data(), WILDCARD.size());
+            }
+            if(pParams != NULL && token == WILDCARD)
+            {
+                pParams->push_back(roTokens[ui]);
+            }
+        }
+        cluster.count += count;
+        Unlink(id);
+        PushFront(id);
+        return id;
+    }
+    // a new template, the eviction happens first, because it may remove nodes of the path
+    id = NewCluster();
+    SCluster &cluster = m_clusters[id];
+    cluster.tokens.assign(roTokens.begin(), roTokens.end());
+    cluster.count  = count;
+    cluster.serial = m_serial++;
+    cluster.leaf   = GetLeaf(roTokens);
+    cluster.bUsed = true;
+    m_nodes[cluster.leaf].clusters.push_back(id);
+    PushFront(id);
+    ++m_used;
+    return id;
+}
+
+template <class Pred> uint32_t simple_log_template_miner<Pred>::NewCluster(void)
+{
+    if(m_used < m_maxTemplates)
+    {
+        m_clusters.push_back(SCluster());
+        return static_cast<uint32_t>(m_clusters.size() - 1);
+    }
+    // evict the least recently matched template
+    const uint32_t id = m_tail;
+    SCluster &cluster = m_clusters[id];
+    std::vector<uint32_t> &clusters = m_nodes[cluster.leaf].clusters;
+    clusters.erase(std::find(clusters.begin(), clusters.end(), id));
+    Prune(cluster.leaf);
+    Unlink(id);
+    cluster.bUsed = false;
+    --m_used;
+    ++m_evictions;
+    return id;
+}
+
+template <class Pred> void simple_log_template_miner<Pred>::Unlink(uint32_t id)
+{
+    SCluster &cluster = m_clusters[id];
+    if(cluster.prev != NONE)
+    {
+        m_clusters[cluster.prev].next = cluster.next;
+    }
+    else
+    {
+        m_head = cluster.next;
+    }
+    if(cluster.next != NONE)
+    {
+        m_clusters[cluster.next].prev = cluster.prev;
+    }
+    else
+    {
+        m_tail = cluster.prev;
+    }
+}
+
+template <class Pred> void simple_log_template_miner<Pred>::PushFront(uint32_t id)
+{
+    SCluster &cluster = m_clusters[id];
+    cluster.prev = NONE;
+    cluster.next = m_head;
+    if(m_head != NONE)
+    {
+        m_clusters[m_head].prev = id;
+    }
+    m_head = id;
+    if(m_tail == NONE)
+    {
+        m_tail = id;
+    }
+}
+
+template <class Pred> void simple_log_template_miner<Pred>::Prune(uint32_t node)
+{
+    while(node != 0 && m_nodes[node].clusters.empty() && m_nodes[node].children.empty())
+    {
+        SNode &leaf = m_nodes[node];
+        const uint32_t parent = leaf.parent;
+        m_nodes[parent].children.erase(leaf.token);
+        leaf.token.clear();
+        m_freeNodes.push_back(node);
+        node = parent;
+    }
+}
+
+/** @}*/
+
+#endif // SIMPLE_LOG_TEMPLATE_HPP
@@ -0,0 +1,75 @@
+/*!
+ * \file simple_mapped_file.hpp
+ * \brief Read only memory mapping of a file (POSIX).
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_MAPPED_FILE_HPP
+#define SIMPLE_MAPPED_FILE_HPP
+
+#include <string>
+#include <cstddef>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief Helper functions to map a complete file into memory.
+class simple_mapped_file
+{
+    public:
+
+        /// Map a file read only.
+        /// \param pData  <-- the content, NULL in case the file is empty
+        /// \param size   <-- the size of the file
+        /// \param status <-- the status of the file at the time it was mapped
+        /// \return <-- false, in case the file cannot be opened or mapped
+        static bool Map(const std::string &strFileName, const char *&pData, std::size_t &size, struct stat &status)
+        {
+            const int fd = open(strFileName.c_str(), O_RDONLY);
+            if(fd < 0)
+            {
+                return false;
+            }
+            if(fstat(fd, &status) != 0)
+            {
+                close(fd);
+                return false;
+            }
+            size  = static_cast<std::size_t>(status.st_size);
+            pData = NULL;
+            if(size > 0)
+            {
+                void *p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if(p == MAP_FAILED)
+                {
+                    close(fd);
+                    return false;
+                }
+                pData = static_cast<const char*>(p);
+            }
+            // the mapping stays valid after closing the file
+            close(fd);
+            return true;
+        }
+
+        /// Unmap a file mapped by Map(), pData and size are reset.
+        static void Unmap(const char *&pData, std::size_t &size)
+        {
+            if(pData != NULL)
+            {
+                munmap(const_cast<char*>(pData), size);
+            }
+            pData = NULL;
+            size  = 0;
+        }
+};
+
+/** @}*/
+
+#endif // SIMPLE_MAPPED_FILE_HPP
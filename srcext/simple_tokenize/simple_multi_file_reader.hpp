@@ -0,0 +1,592 @@
+/*!
+ * \file simple_multi_file_reader.hpp
+ * \brief Reading of many files at once, whose contents are passed to tokenizer workers.
+ *  On Linux the reads are submitted in batches through io_uring, which needs one system
+ *  call for a whole batch of reads. Without io_uring, or on kernels older than 5.6,
+ *  which cannot read through io_uring, a pool of threads reads the files with pread.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_MULTI_FILE_READER_HPP
+#define SIMPLE_MULTI_FILE_READER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief This class reads a list of files and passes the content of every file to
+///  onFile(fileIndex, std::string_view content), which is called by several worker
+///  threads concurrently. The content is passed without copying, the view is valid
+///  only during the call.
+///
+///  With io_uring, the calling thread opens the files and keeps up to queueDepth reads
+///  in flight. The completed files are queued for the workers. At most two files per
+///  worker wait in the queue, then the reading pauses until a worker is free. Otherwise
+///  every worker opens and reads files itself.
+///
+///  Only the reads go through io_uring. open, fstat and close are still blocking system
+///  calls of the calling thread, so a slow file system delays the submission of reads.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_multi_file_reader reader(64, 4);
+///         std::atomic<uint64_t> tokens(0);
+///         reader.TokenizeFiles<CIsSpace>(files, [&tokens](std::size_t, std::string_view)
+///         {
+///             tokens.fetch_add(1, std::memory_order_relaxed);
+///         });
+///         // reader.GetThroughput() bytes per second
+///  \endcode
+class simple_multi_file_reader
+{
+    public:
+
+        /// \param queueDepth      --> the maximal number of reads in flight
+        /// \param numberOfWorkers --> the number of threads, which call onFile. Zero uses one thread per core.
+        /// \param useIoUring      --> false forces the pread fallback
+        explicit simple_multi_file_reader(unsigned int queueDepth = 64
+                                          , unsigned int numberOfWorkers = 0
+                                          , bool useIoUring = true)
+            : m_queueDepth(queueDepth > 0 ? queueDepth : 1)
+            , m_numberOfWorkers(numberOfWorkers > 0 ? numberOfWorkers : DefaultNumberOfWorkers())
+            , m_useIoUring(useIoUring)
+            , m_usedIoUring(false)
+            , m_bytes(0)
+            , m_reads(0)
+            , m_syscalls(0)
+            , m_maxInFlight(0)
+            , m_maxQueued(0)
+            , m_seconds(0.0)
+        {}
+
+        simple_multi_file_reader(const simple_multi_file_reader &) = delete;
+        simple_multi_file_reader& operator=(const simple_multi_file_reader &) = delete;
+
+        /// Read all files and call onFile(std::size_t fileIndex, std::string_view content) for every
+        /// file, that could be read.
+        /// \return <-- false, in case a file could not be read, see GetFailedFiles()
+        template <class F> bool ReadFiles(const std::vector<std::string> &roFiles, F onFile);
+
+        /// Read all files and call onToken(std::size_t fileIndex, std::string_view token) for every token.
+        template <class Pred, class F> bool TokenizeFiles(const std::vector<std::string> &roFiles, F onToken, const Pred & roPred = Pred())
+        {
+            return ReadFiles(roFiles, [&onToken, &roPred](std::size_t fileIndex, std::string_view content)
+            {
+                simple_tokenize<Pred>::ForEachToken(content, [&onToken, fileIndex](std::string_view token)
+                {
+                    onToken(fileIndex, token);
+                }, roPred);
+            });
+        }
+
+        /// \return true, in case the last call used io_uring
+        bool UsedIoUring(void) const
+        {
+            return m_usedIoUring;
+        }
+
+        /// \return the indices of the files, that could not be read by the last call
+        const std::vector<std::size_t> &GetFailedFiles(void) const
+        {
+            return m_failedFiles;
+        }
+
+        uint64_t GetBytes(void) const
+        {
+            return m_bytes;
+        }
+
+        /// \return the number of read requests of the last call
+        uint64_t GetReads(void) const
+        {
+            return m_reads;
+        }
+
+        /// \return the number of system calls, that submitted or performed the reads
+        uint64_t GetSyscalls(void) const
+        {
+            return m_syscalls;
+        }
+
+        /// \return the number of read system calls, that were saved by submitting them in batches
+        uint64_t GetSyscallsSaved(void) const
+        {
+            return (m_reads > m_syscalls) ? m_reads - m_syscalls : 0;
+        }
+
+        /// \return the maximal number of reads, that were in flight at the same time
+        unsigned int GetMaxQueueDepth(void) const
+        {
+            return m_maxInFlight;
+        }
+
+        /// \return the maximal number of read files, that waited for a worker at the same time
+        std::size_t GetMaxQueuedFiles(void) const
+        {
+            return m_maxQueued;
+        }
+
+        double GetSeconds(void) const
+        {
+            return m_seconds;
+        }
+
+        /// \return the bytes per second of the last call, from the first open to the last onFile
+        double GetThroughput(void) const
+        {
+            return (m_seconds > 0.0) ? static_cast<double>(m_bytes) / m_seconds : 0.0;
+        }
+
+    private:
+
+        static unsigned int DefaultNumberOfWorkers(void)
+        {
+            const unsigned int cores = std::thread::hardware_concurrency();
+            return cores > 0 ? cores : 1;
+        }
+
+        /// The content of a file, that is read completely.
+        struct SFile
+        {
+            std::size_t             index;
+            int                     fd;
+            std::size_t             size;
+            std::size_t             offset;
+            std::unique_ptr<char[]> data;
+        };
+
+        /// The queue of read files between the reading thread and the workers.
+        struct SQueue
+        {
+            std::mutex                          mutex;
+            std::condition_variable             condition;
+            /// signalled, when a worker took a file
+            std::condition_variable             space;
+            std::deque< std::unique_ptr<SFile> > files;
+            std::size_t                         maxFiles;
+            bool                                finished;
+
+            explicit SQueue(std::size_t maximum) : maxFiles(maximum), finished(false) {}
+        };
+
+        /// Open a file and allocate the buffer for its content.
+        /// \return <-- NULL, in case the file cannot be opened
+        static std::unique_ptr<SFile> OpenFile(const std::string &strFile, std::size_t index)
+        {
+            const int fd = open(strFile.c_str(), O_RDONLY);
+            if(fd < 0)
+            {
+                return std::unique_ptr<SFile>();
+            }
+            struct stat status;
+            if(fstat(fd, &status) != 0 || !S_ISREG(status.st_mode))
+            {
+                close(fd);
+                return std::unique_ptr<SFile>();
+            }
+            std::unique_ptr<SFile> pFile(new SFile);
+            pFile->index  = index;
+            pFile->fd     = fd;
+            pFile->size   = static_cast<std::size_t>(status.st_size);
+            pFile->offset = 0;
+            pFile->data.reset(new char[pFile->size > 0 ? pFile->size : 1]);
+            return pFile;
+        }
+
+        void AddFailedFile(std::size_t index)
+        {
+            std::lock_guard<std::mutex> lock(m_failedMutex);
+            m_failedFiles.push_back(index);
+        }
+
+        template <class F> void ReadWithThreads(const std::vector<std::string> &roFiles, F &onFile);
+#ifdef __linux__
+        /// \return <-- true, in case the kernel supports IORING_OP_READ (Linux 5.6)
+        static bool CanReadWithIoUring(int ringFd)
+        {
+            // the probe itself is only known since Linux 5.6, older kernels fail with EINVAL
+            const unsigned int numberOfOps = 256;
+            std::vector<uint64_t> buffer((sizeof(struct io_uring_probe) + numberOfOps * sizeof(struct io_uring_probe_op)) / sizeof(uint64_t) + 1, 0);
+            struct io_uring_probe *pProbe = reinterpret_cast<struct io_uring_probe*>(buffer.data());
+            if(syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, pProbe, numberOfOps) < 0)
+            {
+                return false;
+            }
+            return IORING_OP_READ <= pProbe->last_op
+                   && IORING_OP_READ < pProbe->ops_len
+                   && (pProbe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) != 0;
+        }
+        template <class F> bool ReadWithIoUring(const std::vector<std::string> &roFiles, F &onFile);
+#endif
+
+        unsigned int             m_queueDepth;
+        unsigned int             m_numberOfWorkers;
+        bool                     m_useIoUring;
+        bool                     m_usedIoUring;
+        std::mutex               m_failedMutex;
+        std::vector<std::size_t> m_failedFiles;
+        std::atomic<uint64_t>    m_bytes;
+        std::atomic<uint64_t>    m_reads;
+        std::atomic<uint64_t>    m_syscalls;
+        unsigned int             m_maxInFlight;
+        std::size_t              m_maxQueued;
+        double                   m_seconds;
+};
+
+template <class F> bool simple_multi_file_reader::ReadFiles(const std::vector<std::string> &roFiles, F onFile)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    m_failedFiles.clear();
+    m_bytes       = 0;
+    m_reads       = 0;
+    m_syscalls    = 0;
+    m_maxInFlight = 0;
+    m_maxQueued   = 0;
+    m_usedIoUring = false;
+#ifdef __linux__
+    if(m_useIoUring)
+    {
+        m_usedIoUring = ReadWithIoUring(roFiles, onFile);
+    }
+#endif
+    if(!m_usedIoUring)
+    {
+        ReadWithThreads(roFiles, onFile);
+    }
+    m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::sort(m_failedFiles.begin(), m_failedFiles.end());
+    return m_failedFiles.empty();
+}
+
+template <class F> void simple_multi_file_reader::ReadWithThreads(const std::vector<std::string> &roFiles, F &onFile)
+{
+    std::atomic<std::size_t> next(0);
+    std::vector<std::thread> workers;
+    for(unsigned int ui = 0; ui < m_numberOfWorkers; ++ui)
+    {
+        workers.push_back(std::thread([this, &roFiles, &onFile, &next]()
+        {
+            for(std::size_t index = next++; index < roFiles.size(); index = next++)
+            {
+                std::unique_ptr<SFile> pFile(OpenFile(roFiles[index], index));
+                if(!pFile)
+                {
+                    AddFailedFile(index);
+                    continue;
+                }
+                bool failed = false;
+                while(pFile->offset < pFile->size)
+                {
+                    const ssize_t bytes = pread(pFile->fd, pFile->data.get() + pFile->offset, pFile->size - pFile->offset, static_cast<off_t>(pFile->offset));
+                    m_reads.fetch_add(1, std::memory_order_relaxed);
+                    m_syscalls.fetch_add(1, std::memory_order_relaxed);
+                    if(bytes <= 0)
+                    {
+                        failed = true;
+                        break;
+                    }
+                    pFile->offset += static_cast<std::size_t>(bytes);
+                }
+                close(pFile->fd);
+                if(failed)
+                {
+                    AddFailedFile(index);
+                    continue;
+                }
+                m_bytes.fetch_add(pFile->size, std::memory_order_relaxed);
+                onFile(index, std::string_view(pFile->data.get(), pFile->size));
+            }
+        }));
+    }
+    for(std::size_t ui = 0; ui < workers.size(); ++ui)
+    {
+        workers[ui].join();
+    }
+    m_maxInFlight = m_numberOfWorkers;
+}
+
+#ifdef __linux__
+template <class F> bool simple_multi_file_reader::ReadWithIoUring(const std::vector<std::string> &roFiles, F &onFile)
+{
+    // set up the rings, the kernel may round the number of entries up
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    const int ringFd = static_cast<int>(syscall(__NR_io_uring_setup, m_queueDepth, &params));
+    if(ringFd < 0)
+    {
+        return false;
+    }
+    if(!CanReadWithIoUring(ringFd))
+    {
+        close(ringFd);
+        return false;
+    }
+    std::size_t sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    std::size_t cqSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if(params.features & IORING_FEAT_SINGLE_MMAP)
+    {
+        sqSize = cqSize = (sqSize > cqSize) ? sqSize : cqSize;
+    }
+    void *sqRing = mmap(NULL, sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+    void *cqRing = (params.features & IORING_FEAT_SINGLE_MMAP) ? sqRing
+                   : mmap(NULL, cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+    const std::size_t sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqes = mmap(NULL, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+    if(sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqes == MAP_FAILED)
+    {
+        if(sqRing != MAP_FAILED) munmap(sqRing, sqSize);
+        if(cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqSize);
+        if(sqes != MAP_FAILED) munmap(sqes, sqesSize);
+        close(ringFd);
+        return false;
+    }
+    char *sq = static_cast<char*>(sqRing);
+    char *cq = static_cast<char*>(cqRing);
+    unsigned int *sqTail  = reinterpret_cast<unsigned int*>(sq + params.sq_off.tail);
+    unsigned int  sqMask  = *reinterpret_cast<unsigned int*>(sq + params.sq_off.ring_mask);
+    unsigned int *sqArray = reinterpret_cast<unsigned int*>(sq + params.sq_off.array);
+    unsigned int *cqHead  = reinterpret_cast<unsigned int*>(cq + params.cq_off.head);
+    unsigned int *cqTail  = reinterpret_cast<unsigned int*>(cq + params.cq_off.tail);
+    unsigned int  cqMask  = *reinterpret_cast<unsigned int*>(cq + params.cq_off.ring_mask);
+    struct io_uring_cqe *cqes = reinterpret_cast<struct io_uring_cqe*>(cq + params.cq_off.cqes);
+    struct io_uring_sqe *sqeArray = static_cast<struct io_uring_sqe*>(sqes);
+
+    // the workers tokenize the files, which are read completely
+    SQueue queue(2 * static_cast<std::size_t>(m_numberOfWorkers));
+    std::vector<std::thread> workers;
+    for(unsigned int ui = 0; ui < m_numberOfWorkers; ++ui)
+    {
+        workers.push_back(std::thread([this, &queue, &onFile]()
+        {
+            while(true)
+            {
+                std::unique_ptr<SFile> pFile;
+                {
+                    std::unique_lock<std::mutex> lock(queue.mutex);
+                    queue.condition.wait(lock, [&queue]()
+                    {
+                        return !queue.files.empty() || queue.finished;
+                    });
+                    if(queue.files.empty())
+                    {
+                        return;
+                    }
+                    pFile = std::move(queue.files.front());
+                    queue.files.pop_front();
+                }
+                queue.space.notify_one();
+                m_bytes.fetch_add(pFile->size, std::memory_order_relaxed);
+                onFile(pFile->index, std::string_view(pFile->data.get(), pFile->size));
+            }
+        }));
+    }
+
+    const unsigned int capacity = (params.sq_entries < m_queueDepth) ? params.sq_entries : m_queueDepth;
+    // the files, whose reads are in flight, the user data of a read is the slot
+    std::vector< std::unique_ptr<SFile> > inFlight(capacity);
+    std::vector<unsigned int> freeSlots;
+    for(unsigned int ui = capacity; ui > 0; --ui)
+    {
+        freeSlots.push_back(ui - 1);
+    }
+    std::size_t nextFile  = 0;
+    unsigned int pending  = 0;
+    unsigned int toSubmit = 0;
+
+    const auto Submit = [&](unsigned int slot)
+    {
+        SFile &file = *inFlight[slot];
+        const unsigned int tail = *sqTail;
+        const unsigned int index = tail & sqMask;
+        struct io_uring_sqe &sqe = sqeArray[index];
+        memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode    = IORING_OP_READ;
+        sqe.fd        = file.fd;
+        sqe.addr      = reinterpret_cast<uint64_t>(file.data.get() + file.offset);
+        sqe.len       = static_cast<uint32_t>((file.size - file.offset < 0x40000000U) ? file.size - file.offset : 0x40000000U);
+        sqe.off       = file.offset;
+        sqe.user_data = slot;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        ++pending;
+        ++toSubmit;
+        m_reads.fetch_add(1, std::memory_order_relaxed);
+    };
+    const auto Complete = [&](unsigned int slot)
+    {
+        close(inFlight[slot]->fd);
+        {
+            // wait for the workers, in case they are behind
+            std::unique_lock<std::mutex> lock(queue.mutex);
+            queue.space.wait(lock, [&queue]()
+            {
+                return queue.files.size() < queue.maxFiles;
+            });
+            queue.files.push_back(std::move(inFlight[slot]));
+            m_maxQueued = std::max(m_maxQueued, queue.files.size());
+        }
+        queue.condition.notify_one();
+        freeSlots.push_back(slot);
+    };
+
+    bool ok = true;
+    while(nextFile < roFiles.size() || pending > 0)
+    {
+        // fill the free slots with new files
+        while(!freeSlots.empty() && nextFile < roFiles.size())
+        {
+            std::unique_ptr<SFile> pFile(OpenFile(roFiles[nextFile], nextFile));
+            if(!pFile)
+            {
+                AddFailedFile(nextFile++);
+                continue;
+            }
+            ++nextFile;
+            const unsigned int slot = freeSlots.back();
+            freeSlots.pop_back();
+            inFlight[slot] = std::move(pFile);
+            if(inFlight[slot]->size == 0)
+            {
+                Complete(slot);
+                continue;
+            }
+            Submit(slot);
+        }
+        if(pending > m_maxInFlight)
+        {
+            m_maxInFlight = pending;
+        }
+        if(pending == 0)
+        {
+            continue;
+        }
+        // one system call submits the batch and waits for at least one completion
+        const int result = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, 1U, IORING_ENTER_GETEVENTS, NULL, 0));
+        m_syscalls.fetch_add(1, std::memory_order_relaxed);
+        if(result < 0 && errno != EINTR)
+        {
+            ok = false;
+            break;
+        }
+        toSubmit = (result > 0) ? toSubmit - static_cast<unsigned int>(result) : toSubmit;
+
+        unsigned int head = *cqHead;
+        while(head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+        {
+            const struct io_uring_cqe &cqe = cqes[head & cqMask];
+            const unsigned int slot = static_cast<unsigned int>(cqe.user_data);
+            const int bytes = cqe.res;
+            ++head;
+            --pending;
+            SFile &file = *inFlight[slot];
+            if(bytes <= 0)
+            {
+                // read error or the file was truncated meanwhile
+                AddFailedFile(file.index);
+                close(file.fd);
+                inFlight[slot].reset();
+                freeSlots.push_back(slot);
+                continue;
+            }
+            file.offset += static_cast<std::size_t>(bytes);
+            if(file.offset < file.size)
+            {
+                // short read, the rest is submitted again
+                Submit(slot);
+            }
+            else
+            {
+                Complete(slot);
+            }
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    // the kernel may still write into the buffers of the submitted reads, wait for them
+    unsigned int submitted = pending - toSubmit;
+    while(submitted > 0)
+    {
+        const int result = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, 0U, 1U, IORING_ENTER_GETEVENTS, NULL, 0));
+        if(result < 0 && errno != EINTR)
+        {
+            break;
+        }
+        unsigned int head = *cqHead;
+        for(; head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE) && submitted > 0; ++head)
+        {
+            --submitted;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.finished = true;
+    }
+    queue.condition.notify_all();
+    for(std::size_t ui = 0; ui < workers.size(); ++ui)
+    {
+        workers[ui].join();
+    }
+    munmap(sqes, sqesSize);
+    if(cqRing != sqRing)
+    {
+        munmap(cqRing, cqSize);
+    }
+    munmap(sqRing, sqSize);
+    close(ringFd);
+    for(std::size_t ui = 0; ui < inFlight.size(); ++ui)
+    {
+        if(inFlight[ui])
+        {
+            close(inFlight[ui]->fd);
+            AddFailedFile(inFlight[ui]->index);
+            if(submitted > 0)
+            {
+                // reads, which could not be waited for, may still write into the buffer
+                (void)inFlight[ui]->data.release();
+            }
+        }
+    }
+    // in case io_uring_enter failed, the files, that were not opened yet, are reported as failed
+    if(!ok)
+    {
+        for(; nextFile < roFiles.size(); ++nextFile)
+        {
+            AddFailedFile(nextFile);
+        }
+    }
+    return true;
+}
+#endif
+
+/** @}*/
+
+#endif // SIMPLE_MULTI_FILE_READER_HPP
@@ -0,0 +1,218 @@
+/*!
+ * \file simple_radix_sort.hpp
+ * \brief Sorting and deduplication of tokens with a most significant digit radix sort.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_RADIX_SORT_HPP
+#define SIMPLE_RADIX_SORT_HPP
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief An in-place American flag sort: the tokens are distributed into 257 buckets
+///  (end of token and one per byte) by the byte at the current depth, every bucket is
+///  sorted by the next byte. Small buckets are sorted by insertion sort.
+///  The buckets are kept on an explicit stack instead of a recursion, because the depth
+///  is only bounded by the length of the longest common prefix (e.g. "a", "aa", "aaa", ...).
+///  The duplicates are found while the buckets are sorted: tokens, which end at the
+///  current depth, are equal, so only the first of them is kept. They are removed in
+///  a final pass.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         std::vector<std::string_view> tokens = ...;
+///         simple_radix_sort::SortUnique(tokens);
+///
+///         std::vector<std::string_view> vocabulary;
+///         simple_radix_sort::SortedUniqueTokens(vocabulary, "to be or not to be");
+///         // vocabulary == {"be", "not", "or", "to"}
+///  \endcode
+class simple_radix_sort
+{
+    public:
+
+        /// Sort the tokens in ascending (byte wise) order and remove duplicates.
+        /// T is std::string_view or std::string.
+        template <class T> static void SortUnique(std::vector<T>& roTokens)
+        {
+            // the bucket of every token at the current depth and the duplicates, shared by all ranges
+            std::vector<uint16_t> buckets(roTokens.size());
+            std::vector<uint8_t>  duplicates(roTokens.size(), 0);
+            std::vector<SRange>   ranges;
+            if(!roTokens.empty())
+            {
+                ranges.push_back(SRange{0, roTokens.size(), 0});
+            }
+            while(!ranges.empty())
+            {
+                const SRange range = ranges.back();
+                ranges.pop_back();
+                SortRange(roTokens.data(), buckets.data(), duplicates.data(), range, ranges);
+            }
+            std::size_t unique = 0;
+            for(std::size_t ui = 0; ui < roTokens.size(); ++ui)
+            {
+                if(duplicates[ui] != 0)
+                {
+                    continue;
+                }
+                if(unique != ui)
+                {
+                    roTokens[unique] = std::move(roTokens[ui]);
+                }
+                ++unique;
+            }
+            roTokens.erase(roTokens.begin() + static_cast<std::ptrdiff_t>(unique), roTokens.end());
+        }
+
+        /// Tokenize a string and return every distinct token once, in ascending byte order.
+        /// \param roResult <-- the distinct tokens, std::string_view or std::string, views have to be outlived by str
+        /// \param str      --> the string to be tokenized
+        /// \param roPred   --> the separator
+        template <class Pred = CIsSpace, class T> static void SortedUniqueTokens(std::vector<T>& roResult
+                , std::string_view str
+                , const Pred & roPred = Pred())
+        {
+            roResult.clear();
+            simple_tokenize<Pred>::ForEachToken(str, [&roResult](std::string_view token)
+            {
+                roResult.push_back(T(token));
+            }, roPred);
+            SortUnique(roResult);
+        }
+
+    private:
+
+        /// below this number of tokens, insertion sort is faster than another pass over 257 buckets
+        static constexpr std::size_t INSERTION_SORT_CUTOFF = 32;
+        static constexpr std::size_t NUMBER_OF_BUCKETS     = 257;
+
+        /// tokens [begin, begin + size), which have the same first depth bytes
+        struct SRange
+        {
+            std::size_t begin;
+            std::size_t size;
+            std::size_t depth;
+        };
+
+        static uint16_t Bucket(std::string_view token, std::size_t depth)
+        {
+            return depth < token.size() ? static_cast<uint16_t>(static_cast<unsigned char>(token[depth]) + 1) : 0;
+        }
+
+        /// Sort a range by the byte at its depth, the buckets with more than one token are pushed to roRanges.
+        template <class T> static void SortRange(T *data, uint16_t *buckets, uint8_t *duplicates, SRange range, std::vector<SRange> &roRanges)
+        {
+            data       += range.begin;
+            buckets    += range.begin;
+            duplicates += range.begin;
+            const std::size_t size = range.size;
+            std::size_t depth = range.depth;
+            std::size_t counts[NUMBER_OF_BUCKETS];
+            while(true)
+            {
+                if(size <= INSERTION_SORT_CUTOFF)
+                {
+                    InsertionSort(data, duplicates, size, depth);
+                    return;
+                }
+                std::fill(counts, counts + NUMBER_OF_BUCKETS, 0);
+                for(std::size_t ui = 0; ui < size; ++ui)
+                {
+                    buckets[ui] = Bucket(std::string_view(data[ui]), depth);
+                    ++counts[buckets[ui]];
+                }
+                // a common prefix is skipped without moving any token
+                if(counts[buckets[0]] != size)
+                {
+                    break;
+                }
+                if(buckets[0] == 0)
+                {
+                    std::fill(duplicates + 1, duplicates + size, 1);
+                    return;
+                }
+                ++depth;
+            }
+
+            std::size_t begins[NUMBER_OF_BUCKETS];
+            std::size_t next[NUMBER_OF_BUCKETS];
+            std::size_t offset = 0;
+            for(std::size_t ui = 0; ui < NUMBER_OF_BUCKETS; ++ui)
+            {
+                begins[ui] = offset;
+                next[ui]   = offset;
+                offset    += counts[ui];
+            }
+            // move every token into its bucket by following the cycles of the permutation
+            for(std::size_t ui = 0; ui < NUMBER_OF_BUCKETS; ++ui)
+            {
+                const std::size_t end = begins[ui] + counts[ui];
+                while(next[ui] < end)
+                {
+                    const uint16_t bucket = buckets[next[ui]];
+                    if(bucket == ui)
+                    {
+                        ++next[ui];
+                    }
+                    else
+                    {
+                        std::swap(data[next[ui]], data[next[bucket]]);
+                        std::swap(buckets[next[ui]], buckets[next[bucket]]);
+                        ++next[bucket];
+                    }
+                }
+            }
+
+            // the tokens, which end at this depth, are equal
+            if(counts[0] > 1)
+            {
+                std::fill(duplicates + 1, duplicates + counts[0], 1);
+            }
+            for(std::size_t ui = 1; ui < NUMBER_OF_BUCKETS; ++ui)
+            {
+                if(counts[ui] > 1)
+                {
+                    roRanges.push_back(SRange{range.begin + begins[ui], counts[ui], depth + 1});
+                }
+            }
+        }
+
+        template <class T> static void InsertionSort(T *data, uint8_t *duplicates, std::size_t size, std::size_t depth)
+        {
+            for(std::size_t ui = 1; ui < size; ++ui)
+            {
+                T token(std::move(data[ui]));
+                const std::string_view suffix(std::string_view(token).substr(depth));
+                std::size_t pos = ui;
+                while(pos > 0 && std::string_view(data[pos - 1]).substr(depth).compare(suffix) > 0)
+                {
+                    data[pos] = std::move(data[pos - 1]);
+                    --pos;
+                }
+                data[pos] = std::move(token);
+            }
+            for(std::size_t ui = 1; ui < size; ++ui)
+            {
+                if(std::string_view(data[ui - 1]).substr(depth) == std::string_view(data[ui]).substr(depth))
+                {
+                    duplicates[ui] = 1;
+                }
+            }
+        }
+};
+
+/** @}*/
+
+#endif // SIMPLE_RADIX_SORT_HPP
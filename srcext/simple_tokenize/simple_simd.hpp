@@ -0,0 +1,263 @@
+/*!
+ * \file simple_simd.hpp
+ * \brief Byte scanning routines, which process 16 bytes at once with SSE2.
+ *  On platforms without SSE2, a portable scalar implementation is used.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_SIMD_HPP
+#define SIMPLE_SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief A collection of vectorised byte scanning routines.
+class simple_simd
+{
+    public:
+
+        /// \return the position of the first c in [beg, end) or end, in case there is none
+        static const char *FindByte(const char *beg, const char *end, char c)
+        {
+            const void *found = memchr(beg, c, static_cast<std::size_t>(end - beg));
+            return found ? static_cast<const char*>(found) : end;
+        }
+
+        /// \return the number of bytes equal to c in [beg, end)
+        static std::size_t CountByte(const char *beg, const char *end, char c)
+        {
+            std::size_t count = 0;
+            ForEachByte(beg, end, c, [&count](const char *)
+            {
+                ++count;
+            });
+            return count;
+        }
+
+        /// Call onByte(position) for every byte equal to c in [beg, end), in ascending order.
+        template <class F> static void ForEachByte(const char *beg, const char *end, char c, F onByte)
+        {
+            const char *it = beg;
+#ifdef __SSE2__
+            const __m128i pattern = _mm_set1_epi8(c);
+            for(; end - it >= 16; it += 16)
+            {
+                unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(it)), pattern)));
+                while(mask != 0)
+                {
+                    onByte(it + CountTrailingZeros(mask));
+                    mask &= mask - 1;
+                }
+            }
+#endif
+            for(; it != end; ++it)
+            {
+                if(*it == c)
+                {
+                    onByte(it);
+                }
+            }
+        }
+
+        /// \return the position of the first occurrence of the needle in [beg, end) or end, in case there is none
+        static const char *FindSubstring(const char *beg, const char *end, const char *needle, std::size_t needleSize)
+        {
+            const std::size_t size = static_cast<std::size_t>(end - beg);
+            if(needleSize == 0)
+            {
+                return beg;
+            }
+            if(needleSize > size)
+            {
+                return end;
+            }
+            if(needleSize == 1)
+            {
+                return FindByte(beg, end, needle[0]);
+            }
+            const char *it   = beg;
+            // the last position, where the needle may start
+            const char *last = end - needleSize;
+#ifdef __SSE2__
+            // compare the first and the last byte of the needle at 16 positions at once,
+            // only positions, where both match, are compared completely
+            const __m128i firstByte = _mm_set1_epi8(needle[0]);
+            const __m128i lastByte  = _mm_set1_epi8(needle[needleSize - 1]);
+            for(; last - it >= 16; it += 16)
+            {
+                const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));
+                const __m128i blockLast  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it + needleSize - 1));
+                unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstByte), _mm_cmpeq_epi8(blockLast, lastByte))));
+                while(mask != 0)
+                {
+                    const char *candidate = it + CountTrailingZeros(mask);
+                    if(memcmp(candidate + 1, needle + 1, needleSize - 2) == 0)
+                    {
+                        return candidate;
+                    }
+                    mask &= mask - 1;
+                }
+            }
+#endif
+            for(; it <= last; ++it)
+            {
+                if(*it == needle[0] && memcmp(it + 1, needle + 1, needleSize - 1) == 0)
+                {
+                    return it;
+                }
+            }
+            return end;
+        }
+
+        /// \return the position of the first byte in [beg, end), that is not c, or end
+        static const char *SkipByte(const char *beg, const char *end, char c)
+        {
+            for(; end - beg >= 16; beg += 16)
+            {
+                const unsigned int mask = ~MatchMask16(beg, c) & 0xFFFFU;
+                if(mask != 0)
+                {
+                    return beg + CountTrailingZeros(mask);
+                }
+            }
+            while(beg != end && *beg == c)
+            {
+                ++beg;
+            }
+            return beg;
+        }
+
+        /// \return the position behind the last byte in [beg, end), that is not c, or beg
+        static const char *SkipByteBackwards(const char *beg, const char *end, char c)
+        {
+            for(; end - beg >= 16; end -= 16)
+            {
+                const unsigned int mask = ~MatchMask16(end - 16, c) & 0xFFFFU;
+                if(mask != 0)
+                {
+                    return end - 16 + HighestSetBit(mask) + 1;
+                }
+            }
+            while(end != beg && *(end - 1) == c)
+            {
+                --end;
+            }
+            return end;
+        }
+
+        /// \return a bit mask of the 16 bytes at p, where bit i is set in case p[i] == c
+        static unsigned int MatchMask16(const char *p, char c)
+        {
+#ifdef __SSE2__
+            return static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8(c))));
+#else
+            unsigned int mask = 0;
+            for(unsigned int i = 0; i < 16; ++i)
+            {
+                mask |= static_cast<unsigned int>(p[i] == c) << i;
+            }
+            return mask;
+#endif
+        }
+
+        /// \return a bit mask of the 16 bytes at p, where bit i is set in case lo <= p[i] <= hi.
+        ///  lo and hi have to be ASCII characters.
+        static unsigned int RangeMask16(const char *p, char lo, char hi)
+        {
+#ifdef __SSE2__
+            // bytes above 0x7F are negative and hence below lo
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            return static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(static_cast<char>(lo - 1)))
+                                             , _mm_cmplt_epi8(block, _mm_set1_epi8(static_cast<char>(hi + 1))))));
+#else
+            unsigned int mask = 0;
+            for(unsigned int i = 0; i < 16; ++i)
+            {
+                mask |= static_cast<unsigned int>(p[i] >= lo && p[i] <= hi) << i;
+            }
+            return mask;
+#endif
+        }
+
+        /// Copy size bytes from src to dst and convert the ASCII upper case letters to lower case.
+        static void ToLowerAscii(char *dst, const char *src, std::size_t size)
+        {
+            std::size_t pos = 0;
+#ifdef __SSE2__
+            const __m128i beforeA = _mm_set1_epi8('A' - 1);
+            const __m128i afterZ  = _mm_set1_epi8('Z' + 1);
+            const __m128i offset  = _mm_set1_epi8('a' - 'A');
+            for(; size - pos >= 16; pos += 16)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos));
+                const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(block, beforeA), _mm_cmplt_epi8(block, afterZ));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + pos), _mm_add_epi8(block, _mm_and_si128(upper, offset)));
+            }
+#endif
+            for(; pos < size; ++pos)
+            {
+                const char c = src[pos];
+                dst[pos] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+            }
+        }
+
+        /// \return a bit mask of the 16 bytes at p, where bit i is set in case the highest bit of p[i] is set
+        static unsigned int HighBitMask16(const char *p)
+        {
+#ifdef __SSE2__
+            return static_cast<unsigned int>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))));
+#else
+            unsigned int mask = 0;
+            for(unsigned int i = 0; i < 16; ++i)
+            {
+                mask |= static_cast<unsigned int>((static_cast<unsigned char>(p[i]) & 0x80U) != 0) << i;
+            }
+            return mask;
+#endif
+        }
+
+        /// \return the index of the lowest set bit, mask must not be zero
+        static unsigned int CountTrailingZeros(unsigned int mask)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned int>(__builtin_ctz(mask));
+#else
+            unsigned int index = 0;
+            while((mask & 1U) == 0)
+            {
+                mask >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+
+        /// \return the index of the highest set bit, mask must not be zero
+        static unsigned int HighestSetBit(unsigned int mask)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return 31U - static_cast<unsigned int>(__builtin_clz(mask));
+#else
+            unsigned int index = 0;
+            while(mask > 1)
+            {
+                mask >>= 1;
+                ++index;
+            }
+            return index;
+#endif
+        }
+};
+
+/** @}*/
+
+#endif // SIMPLE_SIMD_HPP
@@ -0,0 +1,277 @@
+/*!
+ * \file simple_small_vector.hpp
+ * \brief A vector, that stores its first N elements inside of the object.
+ *  Only in case more than N elements are stored, memory is allocated from the heap.
+ *  It is designed to take the results of simple_tokenize, where most strings
+ *  consist of a few tokens only.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_SMALL_VECTOR_HPP
+#define SIMPLE_SMALL_VECTOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief A sequence container with an inline capacity of N elements.
+///  The interface is a subset of std::vector. In contrast to std::vector, moving
+///  a small vector, whose elements are stored inline, moves the elements one by one.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_small_vector<std::string_view, 16> tokens;
+///         simple_tokenize<CIsComma>::Tokenize(tokens, "a,b,c");
+///         // tokens.size() == 3, tokens.is_inline() == true
+///  \endcode
+template <class T, std::size_t N> class simple_small_vector
+{
+    static_assert(N > 0, "the inline capacity has to be at least one element");
+
+    public:
+        typedef T           value_type;
+        typedef T*          iterator;
+        typedef const T*    const_iterator;
+        typedef std::size_t size_type;
+
+        simple_small_vector(void)
+            : m_data(InlineData())
+            , m_size(0)
+            , m_capacity(N)
+        {}
+
+        simple_small_vector(const simple_small_vector &rhs)
+            : m_data(InlineData())
+            , m_size(0)
+            , m_capacity(N)
+        {
+            reserve(rhs.m_size);
+            for(size_type ui = 0; ui < rhs.m_size; ++ui)
+            {
+                push_back(rhs.m_data[ui]);
+            }
+        }
+
+        simple_small_vector(simple_small_vector &&rhs)
+            : m_data(InlineData())
+            , m_size(0)
+            , m_capacity(N)
+        {
+            MoveFrom(rhs);
+        }
+
+        simple_small_vector& operator=(const simple_small_vector &rhs)
+        {
+            // avoid copy when self assign
+            if(this != &rhs)
+            {
+                clear();
+                reserve(rhs.m_size);
+                for(size_type ui = 0; ui < rhs.m_size; ++ui)
+                {
+                    push_back(rhs.m_data[ui]);
+                }
+            }
+            return *this;
+        }
+
+        simple_small_vector& operator=(simple_small_vector &&rhs)
+        {
+            if(this != &rhs)
+            {
+                clear();
+                Deallocate();
+                MoveFrom(rhs);
+            }
+            return *this;
+        }
+
+        ~simple_small_vector(void)
+        {
+            clear();
+            Deallocate();
+        }
+
+        size_type size(void) const
+        {
+            return m_size;
+        }
+
+        size_type capacity(void) const
+        {
+            return m_capacity;
+        }
+
+        bool empty(void) const
+        {
+            return m_size == 0;
+        }
+
+        /// \return true, as long as the elements are stored inside of the object
+        bool is_inline(void) const
+        {
+            return m_data == InlineData();
+        }
+
+        T& operator[](size_type index)
+        {
+            return m_data[index];
+        }
+
+        const T& operator[](size_type index) const
+        {
+            return m_data[index];
+        }
+
+        T& back(void)
+        {
+            return m_data[m_size - 1];
+        }
+
+        T* data(void)
+        {
+            return m_data;
+        }
+
+        const T* data(void) const
+        {
+            return m_data;
+        }
+
+        iterator begin(void)
+        {
+            return m_data;
+        }
+
+        iterator end(void)
+        {
+            return m_data + m_size;
+        }
+
+        const_iterator begin(void) const
+        {
+            return m_data;
+        }
+
+        const_iterator end(void) const
+        {
+            return m_data + m_size;
+        }
+
+        /// Destroy all elements, the capacity is kept.
+        void clear(void)
+        {
+            for(size_type ui = 0; ui < m_size; ++ui)
+            {
+                m_data[ui].~T();
+            }
+            m_size = 0;
+        }
+
+        void reserve(size_type capacity)
+        {
+            if(capacity <= m_capacity)
+            {
+                return;
+            }
+            T *data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+            for(size_type ui = 0; ui < m_size; ++ui)
+            {
+                new(data + ui) T(std::move(m_data[ui]));
+                m_data[ui].~T();
+            }
+            Deallocate();
+            m_data     = data;
+            m_capacity = capacity;
+        }
+
+        template <class... Args> T& emplace_back(Args&&... args)
+        {
+            if(m_size == m_capacity)
+            {
+                // the arguments may refer to an element, that is moved by reserve()
+                T value(std::forward<Args>(args)...);
+                reserve(2 * m_capacity);
+                new(m_data + m_size) T(std::move(value));
+            }
+            else
+            {
+                new(m_data + m_size) T(std::forward<Args>(args)...);
+            }
+            return m_data[m_size++];
+        }
+
+        void push_back(const T &value)
+        {
+            emplace_back(value);
+        }
+
+        void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back(void)
+        {
+            m_data[--m_size].~T();
+        }
+
+    private:
+
+        T* InlineData(void)
+        {
+            return reinterpret_cast<T*>(m_inline);
+        }
+
+        const T* InlineData(void) const
+        {
+            return reinterpret_cast<const T*>(m_inline);
+        }
+
+        void Deallocate(void)
+        {
+            if(!is_inline())
+            {
+                ::operator delete(m_data);
+                m_data     = InlineData();
+                m_capacity = N;
+            }
+        }
+
+        /// Take the elements of an other vector, which is left empty. Expects this vector to be empty and inline.
+        void MoveFrom(simple_small_vector &rhs)
+        {
+            if(rhs.is_inline())
+            {
+                for(size_type ui = 0; ui < rhs.m_size; ++ui)
+                {
+                    new(m_data + ui) T(std::move(rhs.m_data[ui]));
+                }
+                m_size = rhs.m_size;
+                rhs.clear();
+            }
+            else
+            {
+                // steal the heap memory
+                m_data         = rhs.m_data;
+                m_size         = rhs.m_size;
+                m_capacity     = rhs.m_capacity;
+                rhs.m_data     = rhs.InlineData();
+                rhs.m_size     = 0;
+                rhs.m_capacity = N;
+            }
+        }
+
+        T         *m_data;
+        size_type  m_size;
+        size_type  m_capacity;
+        alignas(T) unsigned char m_inline[N * sizeof(T)];
+};
+
+/** @}*/
+
+#endif // SIMPLE_SMALL_VECTOR_HPP
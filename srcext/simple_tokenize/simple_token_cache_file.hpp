@@ -0,0 +1,447 @@
+/*!
+ * \file simple_token_cache_file.hpp
+ * \brief A persistent, columnar cache of the tokens of a file.
+ *  Jobs, which tokenize the same immutable input again and again, tokenize it once,
+ *  store the tokens next to the input (\<file\>.stok) and iterate the memory mapped
+ *  tokens on later runs without parsing.
+ *
+ *  Cache file format (version 1, native byte order):
+ *   - header: magic "STOKC", version, size, modification time and hash of the input,
+ *     a hash of the tokenizer, the section sizes and a checksum of all sections (104 bytes)
+ *   - records: per record (line) the number of tokens in front of it, the offset of its
+ *     lengths and the offset of its first token in the arena, followed by one sentinel
+ *   - lengths: the length of every token as LEB128 varint. Since the tokens of a record
+ *     are stored back to back, the lengths are the differences of their offsets.
+ *   - arena: the bytes of all tokens without separators
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_TOKEN_CACHE_FILE_HPP
+#define SIMPLE_TOKEN_CACHE_FILE_HPP
+
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/stat.h>
+
+#include "simple_mapped_file.hpp"
+#include "simple_simd.hpp"
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief Tokens of a file, which are tokenized once and read from a cache file afterwards.
+///  The cache is rebuilt, in case the size, the modification time or the content (hash)
+///  of the input changed, the tokenizer is a different one or the checksum of the cache
+///  does not match. Every line of the input is a record.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_token_cache_file<CIsComma> cache;
+///         if(cache.Open("orders.csv"))     // builds orders.csv.stok, in case it is missing or outdated
+///         {
+///             cache.ForEachToken(42, [](std::string_view token) { ... });
+///         }
+///  \endcode
+template < class Pred = CIsSpace > class simple_token_cache_file
+{
+    public:
+
+        static constexpr uint32_t VERSION = 1;
+
+        /// \param roPred         --> the separator
+        /// \param strTokenizerId --> identifies the tokenizer in the cache. Predicates with parameters
+        ///                           (e.g. CIsFromString) need a different id for every parameter.
+        ///                           By default the type name of Pred is used.
+        explicit simple_token_cache_file(const Pred & roPred = Pred(), const std::string &strTokenizerId = "");
+        ~simple_token_cache_file(void);
+
+        simple_token_cache_file(const simple_token_cache_file &) = delete;
+        simple_token_cache_file& operator=(const simple_token_cache_file &) = delete;
+
+        /// Map the cache of a file, the cache is (re)built, in case it is missing or outdated.
+        /// \param strFileName --> the input file
+        /// \param bVerify     --> compare the hash of the input and the checksum of the cache as well,
+        ///                        otherwise only the size and the modification time are compared
+        /// \return <-- false, in case the input cannot be read or the cache cannot be written
+        bool Open(const std::string &strFileName, bool bVerify = true);
+
+        void Close(void);
+
+        /// Tokenize a file and write the cache to strCacheFileName.
+        bool Build(const std::string &strFileName, const std::string &strCacheFileName) const;
+
+        static std::string GetCacheFileName(const std::string &strFileName)
+        {
+            return strFileName + ".stok";
+        }
+
+        /// \return true, in case the last call of Open() had to build the cache
+        bool WasCacheBuilt(void) const
+        {
+            return m_bCacheBuilt;
+        }
+
+        std::size_t GetNumberOfRecords(void) const
+        {
+            return (m_pHeader != NULL) ? static_cast<std::size_t>(m_pHeader->numberOfRecords) : 0;
+        }
+
+        uint64_t GetNumberOfTokens(void) const
+        {
+            return (m_pHeader != NULL) ? m_pHeader->numberOfTokens : 0;
+        }
+
+        /// \return the number of tokens of record n
+        std::size_t GetNumberOfTokens(std::size_t n) const
+        {
+            return static_cast<std::size_t>(m_pRecords[n + 1].firstToken - m_pRecords[n].firstToken);
+        }
+
+        /// Call onToken(std::string_view) for every token of record n, n has to be less than
+        /// GetNumberOfRecords(). The views point into the cache and are valid until Close().
+        template <class F> void ForEachToken(std::size_t n, F onToken) const
+        {
+            const SRecord &record = m_pRecords[n];
+            const unsigned char *pLength = m_pLengths + record.lengthsOffset;
+            const char *pToken = m_pArena + record.arenaOffset;
+            for(uint64_t token = record.firstToken; token < m_pRecords[n + 1].firstToken; ++token)
+            {
+                uint64_t length = 0;
+                unsigned int shift = 0;
+                do
+                {
+                    length |= static_cast<uint64_t>(*pLength & 0x7F) << shift;
+                    shift  += 7;
+                }
+                while(*pLength++ & 0x80);
+                onToken(std::string_view(pToken, static_cast<std::size_t>(length)));
+                pToken += length;
+            }
+        }
+
+        /// Store the tokens of record n as views.
+        void Tokenize(std::vector<std::string_view> &roResult, std::size_t n) const
+        {
+            roResult.clear();
+            ForEachToken(n, [&roResult](std::string_view token)
+            {
+                roResult.push_back(token);
+            });
+        }
+
+        /// \return a 64 bit hash of a block of bytes, which processes 8 bytes per step
+        static uint64_t Hash(const char *pData, std::size_t size);
+
+    private:
+
+        /// \brief The incremental form of Hash(): the blocks, which are passed to Update() one
+        ///  after the other, give the same hash as one block. The total size has to be known first.
+        class CHash
+        {
+            public:
+                explicit CHash(std::size_t totalSize)
+                    : m_hash(0xCBF29CE484222325ULL ^ (totalSize * PRIME))
+                    , m_pending(0)
+                {}
+
+                void Update(const char *pData, std::size_t size)
+                {
+                    // complete the word of the previous block
+                    while(m_pending > 0 && size > 0)
+                    {
+                        m_word[m_pending++] = *pData++;
+                        --size;
+                        if(m_pending == sizeof(m_word))
+                        {
+                            Mix(m_word);
+                            m_pending = 0;
+                        }
+                    }
+                    for(; size >= sizeof(m_word); pData += sizeof(m_word), size -= sizeof(m_word))
+                    {
+                        Mix(pData);
+                    }
+                    memcpy(m_word, pData, size);
+                    m_pending = size;
+                }
+
+                uint64_t Get(void) const
+                {
+                    uint64_t hash = m_hash;
+                    for(std::size_t ui = 0; ui < m_pending; ++ui)
+                    {
+                        hash = (hash ^ static_cast<unsigned char>(m_word[ui])) * PRIME;
+                    }
+                    return hash ^ (hash >> 29);
+                }
+
+            private:
+                static constexpr uint64_t PRIME = 0x9E3779B97F4A7C15ULL;
+
+                void Mix(const char *pWord)
+                {
+                    uint64_t word;
+                    memcpy(&word, pWord, sizeof(word));
+                    m_hash = (m_hash ^ word) * PRIME;
+                    m_hash ^= m_hash >> 32;
+                }
+
+                uint64_t    m_hash;
+                char        m_word[8];
+                std::size_t m_pending;
+        };
+
+        struct SHeader
+        {
+            char     magic[8];
+            uint32_t version;
+            uint32_t reserved;
+            uint64_t fileSize;
+            int64_t  fileModificationTime;      // seconds
+            int64_t  fileModificationTimeNsec;  // nanoseconds
+            uint64_t fileHash;
+            uint64_t tokenizerHash;
+            uint64_t numberOfRecords;
+            uint64_t numberOfTokens;
+            uint64_t lengthsSize;
+            uint64_t arenaSize;
+            /// the hash of all bytes behind the header
+            uint64_t checksum;
+        };
+
+        struct SRecord
+        {
+            uint64_t firstToken;
+            uint64_t lengthsOffset;
+            uint64_t arenaOffset;
+        };
+
+        bool MapCache(const std::string &strCacheFileName, bool bVerify);
+
+        Pred                  m_Pred;
+        uint64_t              m_tokenizerHash;
+        const char           *m_pCache;
+        std::size_t           m_cacheSize;
+        const SHeader        *m_pHeader;
+        const SRecord        *m_pRecords;
+        const unsigned char  *m_pLengths;
+        const char           *m_pArena;
+        bool                  m_bCacheBuilt;
+};
+
+template <class Pred> simple_token_cache_file<Pred>::simple_token_cache_file(const Pred & roPred, const std::string &strTokenizerId)
+    : m_Pred(roPred)
+    , m_tokenizerHash(0)
+    , m_pCache(NULL)
+    , m_cacheSize(0)
+    , m_pHeader(NULL)
+    , m_pRecords(NULL)
+    , m_pLengths(NULL)
+    , m_pArena(NULL)
+    , m_bCacheBuilt(false)
+{
+    const std::string strId(strTokenizerId.empty() ? std::string(typeid(Pred).name()) : strTokenizerId);
+    m_tokenizerHash = Hash(strId.data(), strId.size());
+}
+
+template <class Pred> simple_token_cache_file<Pred>::~simple_token_cache_file(void)
+{
+    Close();
+}
+
+template <class Pred> void simple_token_cache_file<Pred>::Close(void)
+{
+    simple_mapped_file::Unmap(m_pCache, m_cacheSize);
+    m_pHeader  = NULL;
+    m_pRecords = NULL;
+    m_pLengths = NULL;
+    m_pArena   = NULL;
+}
+
+template <class Pred> uint64_t simple_token_cache_file<Pred>::Hash(const char *pData, std::size_t size)
+{
+    CHash hash(size);
+    hash.Update(pData, size);
+    return hash.Get();
+}
+
+template <class Pred> bool simple_token_cache_file<Pred>::Build(const std::string &strFileName, const std::string &strCacheFileName) const
+{
+    const char *pData = NULL;
+    std::size_t size  = 0;
+    struct stat status;
+    if(!simple_mapped_file::Map(strFileName, pData, size, status))
+    {
+        return false;
+    }
+
+    std::vector<SRecord> records;
+    std::string strLengths;
+    std::string strArena;
+    strArena.reserve(size);
+    uint64_t numberOfTokens = 0;
+    const char *it  = pData;
+    const char *end = pData + size;
+    while(it != end)
+    {
+        const char *lineEnd = simple_simd::FindByte(it, end, '\n');
+        SRecord record;
+        record.firstToken    = numberOfTokens;
+        record.lengthsOffset = strLengths.size();
+        record.arenaOffset   = strArena.size();
+        records.push_back(record);
+        simple_tokenize<Pred>::ForEachToken(std::string_view(it, static_cast<std::size_t>(lineEnd - it)), [&](std::string_view token)
+        {
+            uint64_t length = token.size();
+            do
+            {
+                strLengths.push_back(static_cast<char>((length & 0x7F) | (length > 0x7F ? 0x80 : 0)));
+                length >>= 7;
+            }
+            while(length != 0);
+            strArena.append(token.data(), token.size());
+            ++numberOfTokens;
+        }, m_Pred);
+        it = (lineEnd != end) ? lineEnd + 1 : end;
+    }
+    SRecord sentinel;
+    sentinel.firstToken    = numberOfTokens;
+    sentinel.lengthsOffset = strLengths.size();
+    sentinel.arenaOffset   = strArena.size();
+    records.push_back(sentinel);
+
+    SHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "STOKC", 5);
+    header.version                  = VERSION;
+    header.fileSize                 = static_cast<uint64_t>(status.st_size);
+    header.fileModificationTime     = static_cast<int64_t>(status.st_mtim.tv_sec);
+    header.fileModificationTimeNsec = static_cast<int64_t>(status.st_mtim.tv_nsec);
+    header.fileHash                 = Hash(pData, size);
+    header.tokenizerHash            = m_tokenizerHash;
+    header.numberOfRecords          = records.size() - 1;
+    header.numberOfTokens           = numberOfTokens;
+    header.lengthsSize              = strLengths.size();
+    header.arenaSize                = strArena.size();
+    simple_mapped_file::Unmap(pData, size);
+
+    // write to a temporary file and rename it, so that readers never see a partial cache
+    const std::string strTempFileName(strCacheFileName + ".tmp");
+    FILE *pFile = fopen(strTempFileName.c_str(), "wb");
+    if(pFile == NULL)
+    {
+        return false;
+    }
+    // the sections behind the header are written one after the other, while the checksum is
+    // updated, the header with the checksum is written last
+    const std::pair<const char*, std::size_t> sections[] =
+    {
+        std::make_pair(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(SRecord)),
+        std::make_pair(strLengths.data(), strLengths.size()),
+        std::make_pair(strArena.data(), strArena.size())
+    };
+    CHash checksum(sections[0].second + sections[1].second + sections[2].second);
+    bool bSuccess = (fseek(pFile, static_cast<long>(sizeof(header)), SEEK_SET) == 0);
+    for(std::size_t ui = 0; bSuccess && ui < sizeof(sections) / sizeof(sections[0]); ++ui)
+    {
+        checksum.Update(sections[ui].first, sections[ui].second);
+        bSuccess = (fwrite(sections[ui].first, 1, sections[ui].second, pFile) == sections[ui].second);
+    }
+    header.checksum = checksum.Get();
+    bSuccess = bSuccess && (fseek(pFile, 0, SEEK_SET) == 0) && (fwrite(&header, sizeof(header), 1, pFile) == 1);
+    bSuccess = (fclose(pFile) == 0) && bSuccess;
+    if(!bSuccess || rename(strTempFileName.c_str(), strCacheFileName.c_str()) != 0)
+    {
+        (void)remove(strTempFileName.c_str());
+        return false;
+    }
+    return true;
+}
+
+template <class Pred> bool simple_token_cache_file<Pred>::MapCache(const std::string &strCacheFileName, bool bVerify)
+{
+    struct stat status;
+    if(!simple_mapped_file::Map(strCacheFileName, m_pCache, m_cacheSize, status))
+    {
+        return false;
+    }
+    if(m_cacheSize < sizeof(SHeader))
+    {
+        simple_mapped_file::Unmap(m_pCache, m_cacheSize);
+        return false;
+    }
+    const SHeader *pHeader = reinterpret_cast<const SHeader*>(m_pCache);
+    const uint64_t expectedSize = sizeof(SHeader)
+                                  + (pHeader->numberOfRecords + 1) * sizeof(SRecord)
+                                  + pHeader->lengthsSize
+                                  + pHeader->arenaSize;
+    if(memcmp(pHeader->magic, "STOKC", 5) != 0
+            || pHeader->version != VERSION
+            || pHeader->tokenizerHash != m_tokenizerHash
+            || expectedSize != m_cacheSize
+            || (bVerify && Hash(m_pCache + sizeof(SHeader), m_cacheSize - sizeof(SHeader)) != pHeader->checksum))
+    {
+        simple_mapped_file::Unmap(m_pCache, m_cacheSize);
+        return false;
+    }
+    m_pHeader  = pHeader;
+    m_pRecords = reinterpret_cast<const SRecord*>(m_pCache + sizeof(SHeader));
+    m_pLengths = reinterpret_cast<const unsigned char*>(m_pRecords + pHeader->numberOfRecords + 1);
+    m_pArena   = reinterpret_cast<const char*>(m_pLengths + pHeader->lengthsSize);
+    return true;
+}
+
+template <class Pred> bool simple_token_cache_file<Pred>::Open(const std::string &strFileName, bool bVerify)
+{
+    Close();
+    m_bCacheBuilt = false;
+    struct stat status;
+    if(stat(strFileName.c_str(), &status) != 0)
+    {
+        return false;
+    }
+    const std::string strCacheFileName(GetCacheFileName(strFileName));
+    if(MapCache(strCacheFileName, bVerify)
+            && m_pHeader->fileSize == static_cast<uint64_t>(status.st_size)
+            && m_pHeader->fileModificationTime == static_cast<int64_t>(status.st_mtim.tv_sec)
+            && m_pHeader->fileModificationTimeNsec == static_cast<int64_t>(status.st_mtim.tv_nsec))
+    {
+        if(!bVerify)
+        {
+            return true;
+        }
+        const char *pData = NULL;
+        std::size_t size  = 0;
+        if(simple_mapped_file::Map(strFileName, pData, size, status))
+        {
+            const bool bSameContent = (Hash(pData, size) == m_pHeader->fileHash);
+            simple_mapped_file::Unmap(pData, size);
+            if(bSameContent)
+            {
+                return true;
+            }
+        }
+    }
+    Close();
+
+    if(!Build(strFileName, strCacheFileName) || !MapCache(strCacheFileName, false))
+    {
+        Close();
+        return false;
+    }
+    m_bCacheBuilt = true;
+    return true;
+}
+
+/** @}*/
+
+#endif // SIMPLE_TOKEN_CACHE_FILE_HPP
@@ -0,0 +1,367 @@
+/*!
+ * \file simple_token_frequency.hpp
+ * \brief Approximate token frequencies and the most frequent tokens (heavy hitters)
+ *  of an unbounded stream of tokens in fixed memory.
+ *
+ *  The frequencies are estimated by a count-min sketch with conservative update.
+ *  The k tokens with the highest estimates are kept in a min-heap, where a new
+ *  token replaces the least frequent one, once its estimate exceeds it.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_TOKEN_FREQUENCY_HPP
+#define SIMPLE_TOKEN_FREQUENCY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief Streaming token frequencies with a count-min sketch and a top-k heap.
+///  The memory is fixed by the error bounds and k: width * depth counters and k tokens.
+///  An estimate is never below the true frequency. With a probability of 1 - delta it
+///  exceeds it by at most epsilon times the number of counted tokens (GetErrorBound()).
+///
+///  Every thread should count into its own instance, the instances are combined by Merge().
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_token_frequency<> frequency(0.0001, 0.001, 10);
+///         while(std::getline(ifs, line))
+///         {
+///             frequency.AddTokens(line);
+///         }
+///         std::vector<std::pair<std::string, uint64_t> > top;
+///         frequency.GetTopK(top);
+///  \endcode
+template < class Pred = CIsSpace > class simple_token_frequency
+{
+    public:
+
+        /// \param epsilon  --> the relative error of an estimate, determines the width of the sketch
+        /// \param delta    --> the probability to exceed the error, determines the depth of the sketch
+        /// \param capacity --> the number of most frequent tokens (k), which are reported
+        /// \param roPred   --> the separator used by AddTokens()
+        explicit simple_token_frequency(double epsilon = 0.0001
+                                        , double delta = 0.001
+                                        , std::size_t capacity = 100
+                                        , const Pred & roPred = Pred());
+
+        simple_token_frequency(const simple_token_frequency &) = delete;
+        simple_token_frequency& operator=(const simple_token_frequency &) = delete;
+
+        /// Count a token.
+        /// \param token --> the token
+        /// \param count --> its number of occurrences
+        void Add(std::string_view token, uint64_t count = 1);
+
+        /// Count every token of a line.
+        void AddTokens(std::string_view line)
+        {
+            simple_tokenize<Pred>::ForEachToken(line, [this](std::string_view token)
+            {
+                Add(token);
+            }, m_Pred);
+        }
+
+        /// \return <-- the estimated frequency of a token, it is never below the true frequency
+        uint64_t Estimate(std::string_view token) const;
+
+        /// \param roResult <-- the most frequent tokens and their estimated frequencies, in descending order
+        void GetTopK(std::vector< std::pair<std::string, uint64_t> > &roResult) const;
+
+        /// Add the counts of an other instance, e.g. the one of an other thread.
+        /// \return <-- false, in case the sketches have different dimensions
+        bool Merge(const simple_token_frequency &roOther);
+
+        void Clear(void);
+
+        /// \return the number of counted tokens
+        uint64_t GetTotal(void) const
+        {
+            return m_total;
+        }
+
+        /// \return the maximal overestimation of a frequency (with a probability of 1 - delta)
+        uint64_t GetErrorBound(void) const
+        {
+            return static_cast<uint64_t>(std::ceil(EULER * static_cast<double>(m_total) / static_cast<double>(m_width)));
+        }
+
+        std::size_t GetWidth(void) const
+        {
+            return m_width;
+        }
+
+        std::size_t GetDepth(void) const
+        {
+            return m_depth;
+        }
+
+        std::size_t GetCapacity(void) const
+        {
+            return m_capacity;
+        }
+
+        /// \return the memory of the sketch in bytes
+        std::size_t GetSketchSize(void) const
+        {
+            return m_counters.size() * sizeof(uint64_t);
+        }
+
+    private:
+
+        static constexpr double EULER = 2.718281828459045;
+
+        struct SEntry
+        {
+            std::string token;
+            uint64_t    count;
+            std::size_t heapIndex;
+        };
+
+        /// The rows use the hashes h1 + row * h2 of a single hash (double hashing).
+        std::size_t GetPosition(uint64_t hash, std::size_t row) const
+        {
+            const uint64_t h2 = ((hash * 0x9E3779B97F4A7C15ULL) >> 32) | 1;
+            return row * m_width + static_cast<std::size_t>((hash + row * h2) & m_mask);
+        }
+
+        void Track(std::string_view token, uint64_t estimate);
+        void SiftUp(std::size_t pos);
+        void SiftDown(std::size_t pos);
+        void Swap(std::size_t lhs, std::size_t rhs);
+
+        Pred                  m_Pred;
+        std::size_t           m_width;
+        std::size_t           m_mask;
+        std::size_t           m_depth;
+        std::size_t           m_capacity;
+        uint64_t              m_total;
+        std::vector<uint64_t> m_counters;
+        /// the tracked tokens, their strings are never moved, because the vector is reserved
+        std::vector<SEntry>   m_entries;
+        /// min-heap of indices into m_entries by count
+        std::vector<std::size_t> m_heap;
+        /// the keys refer to the strings of m_entries
+        std::unordered_map<std::string_view, std::size_t> m_index;
+};
+
+template <class Pred> simple_token_frequency<Pred>::simple_token_frequency(double epsilon
+        , double delta
+        , std::size_t capacity
+        , const Pred & roPred)
+    : m_Pred(roPred)
+    , m_width(1)
+    , m_mask(0)
+    , m_depth(1)
+    , m_capacity(capacity)
+    , m_total(0)
+    , m_counters()
+    , m_entries()
+    , m_heap()
+    , m_index()
+{
+    // the width is rounded up to a power of two, so that a row is selected by a mask
+    const double width = (epsilon > 0.0) ? std::ceil(EULER / epsilon) : 1.0;
+    while(static_cast<double>(m_width) < width)
+    {
+        m_width <<= 1;
+    }
+    m_mask = m_width - 1;
+    if(delta > 0.0 && delta < 1.0)
+    {
+        m_depth = std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(std::log(1.0 / delta))));
+    }
+    m_counters.assign(m_width * m_depth, 0);
+    m_entries.reserve(m_capacity);
+    m_heap.reserve(m_capacity);
+    m_index.reserve(m_capacity);
+}
+
+template <class Pred> void simple_token_frequency<Pred>::Add(std::string_view token, uint64_t count)
+{
+    const uint64_t hash = std::hash<std::string_view>()(token);
+    uint64_t minimum = UINT64_MAX;
+    for(std::size_t row = 0; row < m_depth; ++row)
+    {
+        minimum = std::min(minimum, m_counters[GetPosition(hash, row)]);
+    }
+    // conservative update: only the counters below the new estimate are raised
+    const uint64_t estimate = minimum + count;
+    for(std::size_t row = 0; row < m_depth; ++row)
+    {
+        uint64_t &counter = m_counters[GetPosition(hash, row)];
+        counter = std::max(counter, estimate);
+    }
+    m_total += count;
+    Track(token, estimate);
+}
+
+template <class Pred> uint64_t simple_token_frequency<Pred>::Estimate(std::string_view token) const
+{
+    const uint64_t hash = std::hash<std::string_view>()(token);
+    uint64_t minimum = UINT64_MAX;
+    for(std::size_t row = 0; row < m_depth; ++row)
+    {
+        minimum = std::min(minimum, m_counters[GetPosition(hash, row)]);
+    }
+    return minimum;
+}
+
+template <class Pred> void simple_token_frequency<Pred>::Track(std::string_view token, uint64_t estimate)
+{
+    if(m_capacity == 0)
+    {
+        return;
+    }
+    // the estimates never decrease, so a tracked token is never below the minimum of the heap.
+    // Most tokens of a long tail are rejected here without a lookup.
+    if(m_heap.size() == m_capacity && estimate <= m_entries[m_heap[0]].count)
+    {
+        return;
+    }
+    std::unordered_map<std::string_view, std::size_t>::const_iterator it = m_index.find(token);
+    if(it != m_index.end())
+    {
+        SEntry &entry = m_entries[it->second];
+        entry.count = estimate;
+        SiftDown(entry.heapIndex);
+        return;
+    }
+    if(m_heap.size() < m_capacity)
+    {
+        const std::size_t slot = m_entries.size();
+        m_entries.push_back(SEntry());
+        SEntry &entry = m_entries.back();
+        entry.token.assign(token.data(), token.size());
+        entry.count     = estimate;
+        entry.heapIndex = m_heap.size();
+        m_heap.push_back(slot);
+        m_index[entry.token] = slot;
+        SiftUp(entry.heapIndex);
+        return;
+    }
+    // replace the least frequent token
+    const std::size_t slot = m_heap[0];
+    SEntry &entry = m_entries[slot];
+    m_index.erase(entry.token);
+    entry.token.assign(token.data(), token.size());
+    entry.count = estimate;
+    m_index[entry.token] = slot;
+    SiftDown(0);
+}
+
+template <class Pred> void simple_token_frequency<Pred>::Swap(std::size_t lhs, std::size_t rhs)
+{
+    std::swap(m_heap[lhs], m_heap[rhs]);
+    m_entries[m_heap[lhs]].heapIndex = lhs;
+    m_entries[m_heap[rhs]].heapIndex = rhs;
+}
+
+template <class Pred> void simple_token_frequency<Pred>::SiftUp(std::size_t pos)
+{
+    while(pos > 0)
+    {
+        const std::size_t parent = (pos - 1) / 2;
+        if(m_entries[m_heap[parent]].count <= m_entries[m_heap[pos]].count)
+        {
+            break;
+        }
+        Swap(parent, pos);
+        pos = parent;
+    }
+}
+
+template <class Pred> void simple_token_frequency<Pred>::SiftDown(std::size_t pos)
+{
+    for(;;)
+    {
+        std::size_t smallest = pos;
+        const std::size_t left  = 2 * pos + 1;
+        const std::size_t right = left + 1;
+        if(left < m_heap.size() && m_entries[m_heap[left]].count < m_entries[m_heap[smallest]].count)
+        {
+            smallest = left;
+        }
+        if(right < m_heap.size() && m_entries[m_heap[right]].count < m_entries[m_heap[smallest]].count)
+        {
+            smallest = right;
+        }
+        if(smallest == pos)
+        {
+            break;
+        }
+        Swap(smallest, pos);
+        pos = smallest;
+    }
+}
+
+template <class Pred> void simple_token_frequency<Pred>::GetTopK(std::vector< std::pair<std::string, uint64_t> > &roResult) const
+{
+    roResult.clear();
+    for(std::size_t ui = 0; ui < m_entries.size(); ++ui)
+    {
+        roResult.push_back(std::make_pair(m_entries[ui].token, m_entries[ui].count));
+    }
+    std::sort(roResult.begin(), roResult.end(), [](const std::pair<std::string, uint64_t> &roLhs, const std::pair<std::string, uint64_t> &roRhs)
+    {
+        return (roLhs.second != roRhs.second) ? roLhs.second > roRhs.second : roLhs.first < roRhs.first;
+    });
+}
+
+template <class Pred> bool simple_token_frequency<Pred>::Merge(const simple_token_frequency &roOther)
+{
+    if(&roOther == this || roOther.m_width != m_width || roOther.m_depth != m_depth)
+    {
+        return false;
+    }
+    // the sum of two sketches is the sketch of both streams
+    for(std::size_t ui = 0; ui < m_counters.size(); ++ui)
+    {
+        m_counters[ui] += roOther.m_counters[ui];
+    }
+    m_total += roOther.m_total;
+
+    // the candidates of both heaps are tracked again with their merged estimates
+    std::vector<std::string> candidates;
+    for(std::size_t ui = 0; ui < m_entries.size(); ++ui)
+    {
+        candidates.push_back(m_entries[ui].token);
+    }
+    for(std::size_t ui = 0; ui < roOther.m_entries.size(); ++ui)
+    {
+        candidates.push_back(roOther.m_entries[ui].token);
+    }
+    m_index.clear();
+    m_heap.clear();
+    m_entries.clear();
+    for(std::size_t ui = 0; ui < candidates.size(); ++ui)
+    {
+        Track(candidates[ui], Estimate(candidates[ui]));
+    }
+    return true;
+}
+
+template <class Pred> void simple_token_frequency<Pred>::Clear(void)
+{
+    std::fill(m_counters.begin(), m_counters.end(), 0);
+    m_total = 0;
+    m_index.clear();
+    m_heap.clear();
+    m_entries.clear();
+}
+
+/** @}*/
+
+#endif // SIMPLE_TOKEN_FREQUENCY_HPP
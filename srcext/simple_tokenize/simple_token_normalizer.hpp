@@ -0,0 +1,187 @@
+/*!
+ * \file simple_token_normalizer.hpp
+ * \brief Normalization of tokens while they are copied out of the input:
+ *  ASCII lower case, stripping of leading and trailing punctuation and
+ *  collapsing of digit runs into a placeholder.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_TOKEN_NORMALIZER_HPP
+#define SIMPLE_TOKEN_NORMALIZER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+
+#include "simple_simd.hpp"
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief A set of transforms, which are applied to a token in the same pass,
+///  that copies it. The lower case conversion processes 16 bytes at once (SSE2),
+///  digits are searched 16 bytes at once, so that blocks without digits are
+///  copied without a look at the single bytes.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         const simple_token_normalizer normalizer(simple_token_normalizer::LOWERCASE
+///                                                  | simple_token_normalizer::STRIP_PUNCTUATION
+///                                                  | simple_token_normalizer::COLLAPSE_DIGITS);
+///         std::vector<std::string> strResult;
+///         normalizer.Tokenize(strResult, "Error: user42 (ID 7)!");
+///         // strResult: "error", "user#", "id", "#"
+///  \endcode
+class simple_token_normalizer
+{
+    public:
+
+        enum ETransform
+        {
+            /// convert A-Z to a-z, other bytes are kept
+            LOWERCASE         = 1,
+            /// remove punctuation at the beginning and the end of a token
+            STRIP_PUNCTUATION = 2,
+            /// replace every run of digits by a single placeholder
+            COLLAPSE_DIGITS   = 4
+        };
+
+        /// \param transforms   --> a combination of ETransform
+        /// \param strPunctuation --> the characters, that are stripped (default: the ASCII punctuation)
+        /// \param placeholder  --> the replacement of a run of digits
+        explicit simple_token_normalizer(unsigned int transforms = LOWERCASE
+                                         , const std::string &strPunctuation = "!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~"
+                                         , char placeholder = '#')
+            : m_transforms(transforms)
+            , m_placeholder(placeholder)
+        {
+            memset(m_punctuation, 0, sizeof(m_punctuation));
+            for(std::size_t ui = 0; ui < strPunctuation.size(); ++ui)
+            {
+                m_punctuation[static_cast<unsigned char>(strPunctuation[ui])] = true;
+            }
+        }
+
+        unsigned int GetTransforms(void) const
+        {
+            return m_transforms;
+        }
+
+        /// Normalize a token.
+        /// \param roResult <-- the normalized token, its capacity is reused
+        /// \param token    --> the token
+        /// \return <-- false, in case nothing is left of the token (e.g. it consists of punctuation)
+        bool Apply(std::string &roResult, std::string_view token) const
+        {
+            const char *beg = token.data();
+            const char *end = beg + token.size();
+            if(m_transforms & STRIP_PUNCTUATION)
+            {
+                while(beg != end && m_punctuation[static_cast<unsigned char>(*beg)])
+                {
+                    ++beg;
+                }
+                while(end != beg && m_punctuation[static_cast<unsigned char>(*(end - 1))])
+                {
+                    --end;
+                }
+            }
+            const std::size_t size = static_cast<std::size_t>(end - beg);
+            roResult.resize(size);
+            if(size == 0)
+            {
+                return false;
+            }
+            char *out = &roResult[0];
+            if(!(m_transforms & COLLAPSE_DIGITS))
+            {
+                Copy(out, beg, size);
+                return true;
+            }
+
+            // a collapsed token is not longer than the input, the blocks are written in place
+            bool inDigits = false;
+            const char *it = beg;
+            while(end - it >= 16)
+            {
+                if(simple_simd::RangeMask16(it, '0', '9') == 0)
+                {
+                    Copy(out, it, 16);
+                    out += 16;
+                    it  += 16;
+                    inDigits = false;
+                    continue;
+                }
+                for(const char *blockEnd = it + 16; it != blockEnd; ++it)
+                {
+                    Collapse(out, inDigits, *it);
+                }
+            }
+            for(; it != end; ++it)
+            {
+                Collapse(out, inDigits, *it);
+            }
+            roResult.resize(static_cast<std::size_t>(out - roResult.data()));
+            return true;
+        }
+
+        /// Tokenize a string and normalize every token, while it is copied out of the input.
+        /// Tokens, of which nothing is left, are dropped.
+        /// \param roResult <-- the normalized tokens, the vector is cleared first
+        /// \param str      --> the string to be tokenized
+        /// \param roPred   --> the separator
+        template <class Pred = CIsSpace> void Tokenize(std::vector<std::string>& roResult
+                , std::string_view str
+                , const Pred & roPred = Pred()) const
+        {
+            roResult.clear();
+            simple_tokenize<Pred>::ForEachToken(str, [this, &roResult](std::string_view token)
+            {
+                roResult.push_back(std::string());
+                if(!Apply(roResult.back(), token))
+                {
+                    roResult.pop_back();
+                }
+            }, roPred);
+        }
+
+    private:
+
+        void Copy(char *out, const char *in, std::size_t size) const
+        {
+            if(m_transforms & LOWERCASE)
+            {
+                simple_simd::ToLowerAscii(out, in, size);
+            }
+            else
+            {
+                memcpy(out, in, size);
+            }
+        }
+
+        void Collapse(char *&out, bool &inDigits, char c) const
+        {
+            if(c >= '0' && c <= '9')
+            {
+                if(!inDigits)
+                {
+                    *out++ = m_placeholder;
+                }
+                inDigits = true;
+                return;
+            }
+            inDigits = false;
+            *out++ = ((m_transforms & LOWERCASE) && c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+        }
+
+        unsigned int m_transforms;
+        char         m_placeholder;
+        bool         m_punctuation[256];
+};
+
+/** @}*/
+
+#endif // SIMPLE_TOKEN_NORMALIZER_HPP
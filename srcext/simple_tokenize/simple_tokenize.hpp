@@ -13,7 +13,10 @@
 
 #include <functional>
 #include <string>
+#include <string_view>
+#include <array>
 #include <vector>
+#include <type_traits>
 #include <algorithm>
 #include <cctype>
 #include <ctype.h>
@@ -22,6 +25,18 @@
 #include <cwchar>
 #include <wctype.h>
 
+#ifdef SIMPLE_TOKENIZE_STATS
+#include "simple_tokenize_stats.hpp"
+#else
+// the instrumentation is switched off, see simple_tokenize_stats.hpp
+#define SIMPLE_TOKENIZE_STATS_CALL(BYTES)
+#define SIMPLE_TOKENIZE_STATS_TOKEN(LENGTH)
+#define SIMPLE_TOKENIZE_STATS_COPY(VEC, LENGTH)
+#endif
+
+// see simple_small_vector.hpp
+template <class T, std::size_t N> class simple_small_vector;
+
 /** \addtogroup simple_tokenize simple_tokenize
  *  @{
  */
@@ -35,7 +50,7 @@
 ///  const std::vector<std::string> result;
 ///  result = simple_tokenize<CIsSpace>::Tokenize(stringToTokenize));
 /// \endcode
-class CIsSpace : public std::unary_function<char, bool>
+class CIsSpace
 {
     public:
         /// This operator overloading is required to check if the currently
@@ -43,11 +58,12 @@ class CIsSpace : public std::unary_function<char, bool>
         ///
         /// @param c The character to be validated.
         /// @return  true in case it is a space and false otherwise.
-        bool operator() (const char &c) const
+        constexpr bool operator() (const char &c) const
         {
-            // Zero is returned in case c is a white space and a value different
-            // from zero is returned in case c is not a white space.
-            return (isspace(c) != 0);
+            // Same set as isspace() in the "C" locale, spelled out so that
+            // the predicate can be evaluated at compile time.
+            return ((' ' == c) || ('\t' == c) || ('\n' == c)
+                    || ('\v' == c) || ('\f' == c) || ('\r' == c));
         }
 };
 #if 0
@@ -60,7 +76,7 @@ class CIsSpace : public std::unary_function<char, bool>
 ///  const std::vector<std::wstring> result;
 ///  result = simple_tokenize<CIsWSpace>::Tokenize(stringToTokenize));
 /// \endcode
-class CIsWSpace : public std::unary_function<wchar_t, bool>
+class CIsWSpace
 {
     public:
         /// This operator overloading is required to check if the currently
@@ -85,7 +101,7 @@ class CIsWSpace : public std::unary_function<wchar_t, bool>
 ///  const std::vector<std::string> result;
 ///  result = simple_tokenize<CIsComma>::Tokenize(stringToTokenize));
 /// \endcode
-class CIsComma : public std::unary_function<char, bool>
+class CIsComma
 {
     public:
         /// This operator overloading is required to check if the currently
@@ -93,7 +109,7 @@ class CIsComma : public std::unary_function<char, bool>
         ///
         /// @param c The string character to be validated.
         /// @return  true in case it is a comma and false otherwise.
-        bool operator()(const char &c) const
+        constexpr bool operator()(const char &c) const
         {
             return (',' == c);
         }
@@ -108,7 +124,7 @@ class CIsComma : public std::unary_function<char, bool>
 ///  const std::vector<std::wstring> result;
 ///  result = simple_tokenize<CIsWComma>::Tokenize(stringToTokenize));
 /// \endcode
-class CIsWComma : public std::unary_function<wchar_t, bool>
+class CIsWComma
 {
     public:
         /// This operator overloading is required to check if the currently
@@ -124,10 +140,10 @@ class CIsWComma : public std::unary_function<wchar_t, bool>
 #endif
 
 //For the case the separator is an ampersand ('&')
-class CIsAmpersand : public std::unary_function<char, bool>
+class CIsAmpersand
 {
     public:
-        bool operator()(const char &c) const
+        constexpr bool operator()(const char &c) const
         {
             return ('&' == c);
         }
@@ -135,7 +151,7 @@ class CIsAmpersand : public std::unary_function<char, bool>
 
 #if 0
 //For the case the separator is an ampersand ('&')
-class CIsWAmpersand : public std::unary_function<wchar_t, bool>
+class CIsWAmpersand
 {
     public:
         bool operator()(const wchar_t &c) const
@@ -146,10 +162,10 @@ class CIsWAmpersand : public std::unary_function<wchar_t, bool>
 #endif
 
 // For the case the separator is + (plus) or - (minus) or / (division) or * (multiplicand)
-class CIsArithmetic : public std::unary_function<char, bool>
+class CIsArithmetic
 {
     public:
-        bool operator()(const char &c) const
+        constexpr bool operator()(const char &c) const
         {
             return (('/' == c) || ('+' == c) || ('-' == c) || ('*' == c));
         }
@@ -157,7 +173,7 @@ class CIsArithmetic : public std::unary_function<char, bool>
 
 #if 0
 // For the case the separator is + (plus) or - (minus) or / (division) or * (multiplicand)
-class CIsWArithmetic : public std::unary_function<wchar_t, bool>
+class CIsWArithmetic
 {
     public:
         bool operator()(const wchar_t &c) const
@@ -168,7 +184,7 @@ class CIsWArithmetic : public std::unary_function<wchar_t, bool>
 #endif
 
 //For the case the separator is a character from a set of characters given in a string
-class CIsFromString : public std::unary_function<char, bool>
+class CIsFromString
 {
     public:
         CIsFromString(const std::string & rostr) : m_ostr(rostr) {}
@@ -181,9 +197,25 @@ class CIsFromString : public std::unary_function<char, bool>
         std::string m_ostr;
 };
 
+//For the case the separator is a character from a set of characters given at compile time.
+//In contrast to CIsFromString it can be used in constant expressions, the character set
+//is not copied and has to outlive the predicate (e.g. a string literal).
+class CIsFromChars
+{
+    public:
+        constexpr explicit CIsFromChars(std::string_view chars) : m_chars(chars) {}
+        constexpr bool operator()(const char &c) const
+        {
+            return (m_chars.find(c) != std::string_view::npos);
+        }
+
+    private:
+        std::string_view m_chars;
+};
+
 #if 0
 //For the case the separator is a character from a set of characters given in a string
-class CIsFromWString : public std::unary_function<wchar_t, bool>
+class CIsFromWString
 {
     public:
         //Constructor specifying the separators
@@ -198,6 +230,15 @@ class CIsFromWString : public std::unary_function<wchar_t, bool>
 };
 #endif
 
+/// \brief Separators, which do not consist of single characters but of whole
+/// character sequences (e.g. CIsRegex from simple_tokenize_regex.hpp), declare the
+/// type multichar_separator and split a string by their member function
+/// ForEachToken(const char *beg, const char *end, callback) themselves. Their member
+/// function MatchLength(const char *beg, const char *end) returns the length of the
+/// separator at beg (zero, in case there is none), it is used to step through a string.
+template <class Pred, class = void> struct simple_tokenize_is_multichar : std::false_type {};
+template <class Pred> struct simple_tokenize_is_multichar<Pred, std::void_t<typename Pred::multichar_separator> > : std::true_type {};
+
 /// \brief This class is capable of splitting strings according to a
 ///  provided separator.
 ///  The template parameter Pred consists of a set of predefined classes
@@ -238,6 +279,48 @@ template < class Pred = CIsSpace > class simple_tokenize
         // tokenize a string according to multiple tokens and keep the separators
         static std::vector<std::string> MultiTokenizeAndKeepSeparators(const std::string& stringToSplit, const std::string &separators, const std::string &filter = "");
 
+        // call onToken(std::string_view) for every token, the tokens are views into the input
+        template <class F> static void ForEachToken(std::string_view str
+                , F onToken
+                , const Pred & roPred = Pred());
+
+        // tokenize into a small vector, whose elements are std::string_view or std::string
+        template <class T, std::size_t N> static void Tokenize(simple_small_vector<T, N>& roResult
+                , std::string_view str
+                , const Pred & roPred = Pred());
+
+        // tokenize only the first maxSplit tokens, the unsplit remainder is appended as last token
+        static void TokenizeFirstN(std::vector<std::string>& roResult
+                                   , const std::string & rostr
+                                   , const std::size_t &maxSplit
+                                   , const Pred & roPred = Pred());
+
+        // tokenize only the last maxSplit tokens by scanning backwards, the unsplit remainder is the first token
+        static void TokenizeLastN(std::vector<std::string>& roResult
+                                  , const std::string & rostr
+                                  , const std::size_t &maxSplit
+                                  , const Pred & roPred = Pred());
+
+        // compile-time capable tokenization, the tokens are views into the input
+        static constexpr std::string_view NextToken(std::string_view str
+                , std::size_t &pos
+                , const Pred & roPred = Pred());
+
+        static constexpr std::size_t CountTokens(std::string_view str
+                , const Pred & roPred = Pred());
+
+        template <std::size_t Count> static constexpr std::array<std::string_view, Count> Tokenize(std::string_view str
+                , const Pred & roPred = Pred());
+
+    private:
+
+        // the length of the separator at str[pos], zero in case there is none
+        static constexpr std::size_t SeparatorLength(std::string_view str
+                , std::size_t pos
+                , const Pred & roPred);
+
+    public:
+
         // wstring version
 #if 0
         static void Tokenize(std::vector<std::wstring>& roResult
@@ -286,21 +369,37 @@ template < class Pred = CIsSpace > class simple_tokenize
 ///
 template <class Pred> inline void simple_tokenize<Pred>::Tokenize(std::vector<std::string>& roResult, const std::string & rostr, const Pred & roPred)
 {
+    SIMPLE_TOKENIZE_STATS_CALL(rostr.size());
     //First clear the results vector
     roResult.clear();
-    std::string::const_iterator it          = rostr.begin();
-    std::string::const_iterator itTokenEnd  = it;
-    while(it != rostr.end())
+    if constexpr (simple_tokenize_is_multichar<Pred>::value)
     {
-        //Eat separators
-        while (it != rostr.end() && roPred(*it)) ++it;
+        //The separator finds the tokens itself
+        roPred.ForEachToken(rostr.data(), rostr.data() + rostr.size(), [&roResult](const char *tokenBeg, const char *tokenEnd)
+        {
+            SIMPLE_TOKENIZE_STATS_COPY(roResult, static_cast<std::size_t>(tokenEnd - tokenBeg));
+            roResult.push_back(std::string(tokenBeg, tokenEnd));
+        });
+    }
+    else
+    {
+        std::string::const_iterator it          = rostr.begin();
+        std::string::const_iterator itTokenEnd  = it;
+        while(it != rostr.end())
+        {
+            //Eat separators
+            while (it != rostr.end() && roPred(*it)) ++it;
 
-        //Find next token
-        itTokenEnd = find_if(it, rostr.end(), roPred);
-        //Append token to result
-        if(it < itTokenEnd)
-            roResult.push_back(std::string(it, itTokenEnd));
-        it = itTokenEnd;
+            //Find next token
+            itTokenEnd = find_if(it, rostr.end(), roPred);
+            //Append token to result
+            if(it < itTokenEnd)
+            {
+                SIMPLE_TOKENIZE_STATS_COPY(roResult, static_cast<std::size_t>(itTokenEnd - it));
+                roResult.push_back(std::string(it, itTokenEnd));
+            }
+            it = itTokenEnd;
+        }
     }
 }
 #if 0
@@ -417,6 +516,9 @@ template <class Pred> inline std::vector<std::wstring> simple_tokenize<Pred>::To
 ///
 ///
 ///
+/// The strings are tokenized one after the other on the calling thread. See
+/// simple_tokenize_parallel for the version, which uses several threads.
+///
 /// \param vector_of_strings    --> a vector of string that should be tokenized
 /// \param roPred               --> the token
 ///
@@ -426,10 +528,10 @@ template <class Pred> inline std::vector<std::wstring> simple_tokenize<Pred>::To
 template <class Pred> inline std::vector< std::vector<std::string> > simple_tokenize<Pred>::Tokenize(const std::vector<std::string> & vector_of_strings
         , const Pred & roPred)
 {
-    std::vector< std::vector < std::string > > result;
+    std::vector< std::vector < std::string > > result(vector_of_strings.size());
     for(size_t ui = 0; ui < vector_of_strings.size(); ui++)
     {
-        result.push_back(Tokenize(vector_of_strings[ui], roPred));
+        Tokenize(result[ui], vector_of_strings[ui], roPred);
     }
     return result;
 }
@@ -458,6 +560,7 @@ template <class Pred> void simple_tokenize<Pred>::Tokenize(std::vector<std::stri
         , const std::string &strToTokenize
         , const std::string &strPattern)
 {
+    SIMPLE_TOKENIZE_STATS_CALL(strToTokenize.size());
     // ---------
     // precheck:
     // ---------
@@ -479,11 +582,13 @@ template <class Pred> void simple_tokenize<Pred>::Tokenize(std::vector<std::stri
         size_t foundPatternBeg = str.find(strPattern);
         if (foundPatternBeg != std::string::npos)
         {
+            SIMPLE_TOKENIZE_STATS_COPY(strResult, foundPatternBeg);
             strResult.push_back(str.substr(0, foundPatternBeg));
             str = str.substr(foundPatternBeg + strPattern.length());
         }
         else
         {
+            SIMPLE_TOKENIZE_STATS_COPY(strResult, str.size());
             strResult.push_back(str.substr(0, foundPatternBeg));
             break;
         }
@@ -648,6 +753,301 @@ template <class Pred> std::vector<std::string> simple_tokenize<Pred>::MultiToken
     return result;
 }
 
+// --------------------------------------------------------------------------------------------
+/// Visit the tokens of a string without copying them.
+/// This works for single character predicates as well as for separators of several
+/// characters (see simple_tokenize_is_multichar).
+///
+/// usage:
+///         std::size_t length = 0;
+///         simple_tokenize<CIsComma>::ForEachToken(line, [&length](std::string_view token)
+///         {
+///             length += token.size();
+///         });
+///
+/// \param str      --> the string to be tokenized
+/// \param onToken  --> the function, that is called with a std::string_view of every token
+/// \param roPred   --> the separator
+// --------------------------------------------------------------------------------------------
+template <class Pred> template <class F> void simple_tokenize<Pred>::ForEachToken(std::string_view str
+        , F onToken
+        , const Pred & roPred)
+{
+    SIMPLE_TOKENIZE_STATS_CALL(str.size());
+    if constexpr (simple_tokenize_is_multichar<Pred>::value)
+    {
+        roPred.ForEachToken(str.data(), str.data() + str.size(), [&onToken](const char *tokenBeg, const char *tokenEnd)
+        {
+            SIMPLE_TOKENIZE_STATS_TOKEN(static_cast<std::size_t>(tokenEnd - tokenBeg));
+            onToken(std::string_view(tokenBeg, static_cast<std::size_t>(tokenEnd - tokenBeg)));
+        });
+    }
+    else
+    {
+        std::size_t pos = 0;
+        while(true)
+        {
+            const std::string_view token = NextToken(str, pos, roPred);
+            if(token.empty())
+            {
+                break;
+            }
+            SIMPLE_TOKENIZE_STATS_TOKEN(token.size());
+            onToken(token);
+        }
+    }
+}
+
+// --------------------------------------------------------------------------------------------
+/// tokenize function
+/// The tokens are stored in a simple_small_vector, which does not allocate memory as
+/// long as the number of tokens does not exceed its inline capacity N. Views into
+/// the input (std::string_view) as well as copies (std::string) can be stored.
+/// Short std::string tokens do not allocate either, due to the small string optimisation.
+///
+/// usage:
+///         simple_small_vector<std::string_view, 16> tokens;
+///         simple_tokenize<CIsComma>::Tokenize(tokens, line);
+///
+/// \param roResult <--> the tokens, the vector is cleared first
+/// \param str      --> the string to be tokenized, it has to outlive views stored in roResult
+/// \param roPred   --> the separator
+// --------------------------------------------------------------------------------------------
+template <class Pred> template <class T, std::size_t N> void simple_tokenize<Pred>::Tokenize(simple_small_vector<T, N>& roResult
+        , std::string_view str
+        , const Pred & roPred)
+{
+    roResult.clear();
+    ForEachToken(str, [&roResult](std::string_view token)
+    {
+        roResult.emplace_back(token.data(), token.size());
+    }, roPred);
+}
+
+// --------------------------------------------------------------------------------------------
+/// Tokenize the beginning of a string.
+/// At most maxSplit tokens are split off the front of the string. The rest of the string,
+/// without the separators in front of it, is appended verbatim as a single token. The
+/// characters of the remainder are not examined, which saves the scan of long lines,
+/// where only the first fields are of interest.
+///
+/// usage:
+///         std::vector<std::string> strResult;
+///         simple_tokenize<>::TokenizeFirstN(strResult, "GET /index.html  HTTP/1.1 extra", 2);
+///         // strResult: "GET", "/index.html", "HTTP/1.1 extra"
+///
+/// \param roResult <--> the tokens, followed by the remainder (if any)
+/// \param rostr    --> the string to be tokenized
+/// \param maxSplit --> the maximal number of tokens to split off
+/// \param roPred   --> the separator
+// --------------------------------------------------------------------------------------------
+template <class Pred> void simple_tokenize<Pred>::TokenizeFirstN(std::vector<std::string>& roResult
+        , const std::string & rostr
+        , const std::size_t &maxSplit
+        , const Pred & roPred)
+{
+    SIMPLE_TOKENIZE_STATS_CALL(rostr.size());
+    roResult.clear();
+    std::size_t pos = 0;
+    for(std::size_t ui = 0; ui < maxSplit; ++ui)
+    {
+        const std::string_view token = NextToken(rostr, pos, roPred);
+        if(token.empty())
+        {
+            return;
+        }
+        SIMPLE_TOKENIZE_STATS_COPY(roResult, token.size());
+        roResult.push_back(std::string(token));
+    }
+    // eat separators in front of the remainder
+    std::size_t length = 0;
+    while(pos < rostr.size() && (length = SeparatorLength(rostr, pos, roPred)) > 0) pos += length;
+    if(pos < rostr.size())
+    {
+        SIMPLE_TOKENIZE_STATS_COPY(roResult, rostr.size() - pos);
+        roResult.push_back(rostr.substr(pos));
+    }
+}
+
+// --------------------------------------------------------------------------------------------
+/// Tokenize the end of a string.
+/// The string is scanned backwards and at most maxSplit tokens are split off its end.
+/// The rest of the string, without the separators behind it, is inserted verbatim as
+/// the first token. The tokens are returned in the order of the string.
+///
+/// usage:
+///         std::vector<std::string> strResult;
+///         simple_tokenize<CIsComma>::TokenizeLastN(strResult, "a,b,c,d", 2);
+///         // strResult: "a,b", "c", "d"
+///
+/// \param roResult <--> the remainder (if any), followed by the tokens
+/// \param rostr    --> the string to be tokenized
+/// \param maxSplit --> the maximal number of tokens to split off
+/// \param roPred   --> the separator
+// --------------------------------------------------------------------------------------------
+template <class Pred> void simple_tokenize<Pred>::TokenizeLastN(std::vector<std::string>& roResult
+        , const std::string & rostr
+        , const std::size_t &maxSplit
+        , const Pred & roPred)
+{
+    SIMPLE_TOKENIZE_STATS_CALL(rostr.size());
+    roResult.clear();
+    if constexpr (simple_tokenize_is_multichar<Pred>::value)
+    {
+        // a separator of several characters can only be matched forwards
+        std::vector<std::string_view> tokens;
+        roPred.ForEachToken(rostr.data(), rostr.data() + rostr.size(), [&tokens](const char *tokenBeg, const char *tokenEnd)
+        {
+            tokens.push_back(std::string_view(tokenBeg, static_cast<std::size_t>(tokenEnd - tokenBeg)));
+        });
+        const std::size_t first = (tokens.size() > maxSplit) ? tokens.size() - maxSplit : 0;
+        if(first > 0)
+        {
+            const std::size_t remainderEnd = static_cast<std::size_t>(tokens[first - 1].data() - rostr.data()) + tokens[first - 1].size();
+            SIMPLE_TOKENIZE_STATS_COPY(roResult, remainderEnd);
+            roResult.push_back(rostr.substr(0, remainderEnd));
+        }
+        for(std::size_t ui = first; ui < tokens.size(); ++ui)
+        {
+            SIMPLE_TOKENIZE_STATS_COPY(roResult, tokens[ui].size());
+            roResult.push_back(std::string(tokens[ui]));
+        }
+    }
+    else
+    {
+        std::size_t tokenEnd = rostr.size();
+        for(std::size_t ui = 0; ui < maxSplit; ++ui)
+        {
+            // eat separators
+            while(tokenEnd > 0 && roPred(rostr[tokenEnd - 1])) --tokenEnd;
+            if(tokenEnd == 0)
+            {
+                break;
+            }
+            // find the beginning of the token
+            std::size_t tokenBeg = tokenEnd;
+            while(tokenBeg > 0 && !roPred(rostr[tokenBeg - 1])) --tokenBeg;
+            SIMPLE_TOKENIZE_STATS_COPY(roResult, tokenEnd - tokenBeg);
+            roResult.push_back(rostr.substr(tokenBeg, tokenEnd - tokenBeg));
+            tokenEnd = tokenBeg;
+        }
+        // eat separators behind the remainder
+        while(tokenEnd > 0 && roPred(rostr[tokenEnd - 1])) --tokenEnd;
+        if(tokenEnd > 0)
+        {
+            SIMPLE_TOKENIZE_STATS_COPY(roResult, tokenEnd);
+            roResult.push_back(rostr.substr(0, tokenEnd));
+        }
+        // the tokens were collected from the end
+        std::reverse(roResult.begin(), roResult.end());
+    }
+}
+
+// --------------------------------------------------------------------------------------------
+/// Fetch the next token of a string, starting at a given position.
+/// Leading separators are skipped. This is the building block of the
+/// constexpr tokenization functions below.
+///
+/// \param str      --> the string to be tokenized
+/// \param pos      <--> the position to start from, it is moved behind the returned token
+/// \param roPred   --> the separator
+///
+/// \return <-- a view of the token or an empty view in case there are no more tokens
+// --------------------------------------------------------------------------------------------
+template <class Pred> constexpr std::string_view simple_tokenize<Pred>::NextToken(std::string_view str
+        , std::size_t &pos
+        , const Pred & roPred)
+{
+    // eat separators
+    std::size_t length = 0;
+    while(pos < str.size() && (length = SeparatorLength(str, pos, roPred)) > 0) pos += length;
+    const std::size_t tokenBeg = pos;
+    // find the end of the token
+    while(pos < str.size() && SeparatorLength(str, pos, roPred) == 0) ++pos;
+    return str.substr(tokenBeg, pos - tokenBeg);
+}
+
+// --------------------------------------------------------------------------------------------
+/// A single character predicate separates one character, a separator of several
+/// characters is matched at the position (see simple_tokenize_is_multichar).
+// --------------------------------------------------------------------------------------------
+template <class Pred> constexpr std::size_t simple_tokenize<Pred>::SeparatorLength(std::string_view str
+        , std::size_t pos
+        , const Pred & roPred)
+{
+    if constexpr (simple_tokenize_is_multichar<Pred>::value)
+    {
+        return roPred.MatchLength(str.data() + pos, str.data() + str.size());
+    }
+    else
+    {
+        return roPred(str[pos]) ? 1 : 0;
+    }
+}
+
+// --------------------------------------------------------------------------------------------
+/// Count the tokens of a string without extracting them.
+///
+/// \param str      --> the string to be tokenized
+/// \param roPred   --> the separator
+///
+/// \return <-- the number of tokens, Tokenize() would produce
+// --------------------------------------------------------------------------------------------
+template <class Pred> constexpr std::size_t simple_tokenize<Pred>::CountTokens(std::string_view str
+        , const Pred & roPred)
+{
+    std::size_t count = 0;
+    std::size_t pos   = 0;
+    while(!NextToken(str, pos, roPred).empty()) ++count;
+    return count;
+}
+
+// --------------------------------------------------------------------------------------------
+/// tokenize function for compile-time strings
+/// The tokens are views into the input string, hence the input has to outlive the result.
+/// In case the input has more than Count tokens, the surplus tokens are dropped.
+/// Superfluous entries of the array stay empty.
+///
+/// usage:
+///         static constexpr std::string_view route = "api/v1/users";
+///         constexpr auto tokens = simple_tokenize<CIsFromChars>::Tokenize<3>(route, CIsFromChars("/"));
+///         static_assert(tokens[1] == "v1", "");
+///
+///  The macro SIMPLE_TOKENIZE_CONSTEXPR determines the number of tokens itself.
+///
+/// \param str      --> the string to be tokenized
+/// \param roPred   --> the separator
+///
+/// \return <-- an array of views of the tokenized items
+// --------------------------------------------------------------------------------------------
+template <class Pred> template <std::size_t Count> constexpr std::array<std::string_view, Count> simple_tokenize<Pred>::Tokenize(std::string_view str
+        , const Pred & roPred)
+{
+    std::array<std::string_view, Count> result{};
+    std::size_t pos = 0;
+    for(std::size_t ui = 0; ui < Count; ++ui)
+    {
+        result[ui] = NextToken(str, pos, roPred);
+    }
+    return result;
+}
+
+/// Tokenize a string literal at compile time into a std::array of std::string_view,
+/// whose size is exactly the number of tokens.
+/// \code{.cpp}
+///  constexpr auto fields = SIMPLE_TOKENIZE_CONSTEXPR(CIsComma, "host,port,,user");
+///  static_assert(fields.size() == 3, "");
+/// \endcode
+#define SIMPLE_TOKENIZE_CONSTEXPR(PRED, STR) \
+    simple_tokenize<PRED>::Tokenize<simple_tokenize<PRED>::CountTokens(STR)>(STR)
+
+/// The same for a separator, which is not default constructed.
+/// \code{.cpp}
+///  constexpr auto parts = SIMPLE_TOKENIZE_CONSTEXPR_WITH(CIsFromChars, CIsFromChars("/"), "/api/v1/users");
+/// \endcode
+#define SIMPLE_TOKENIZE_CONSTEXPR_WITH(PRED, SEPARATOR, STR) \
+    simple_tokenize<PRED>::Tokenize<simple_tokenize<PRED>::CountTokens(STR, SEPARATOR)>(STR, SEPARATOR)
+
 /** @}*/
 
 #endif // SIMPLE_TOKENIZE_HPP
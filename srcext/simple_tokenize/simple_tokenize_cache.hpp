@@ -0,0 +1,268 @@
+/*!
+ * \file simple_tokenize_cache.hpp
+ * \brief A memoizing front end for simple_tokenize.
+ *  Inputs that repeat (heartbeats, health checks, templated messages) are
+ *  looked up in a bounded LRU cache of token boundaries instead of being scanned again.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_TOKENIZE_CACHE_HPP
+#define SIMPLE_TOKENIZE_CACHE_HPP
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief This class memoizes the results of simple_tokenize<Pred>::Tokenize.
+///  The cache is split into shards, each guarded by its own mutex, which is only held
+///  while an entry is looked up or inserted. The tokens are built from the input
+///  outside of the lock. The byte budget covers the cached inputs and their token
+///  boundaries and is divided evenly among the shards. Inputs larger than the budget
+///  of a shard are tokenized, but not cached.
+///
+///  A hit still hashes and compares the whole input and copies the tokens out, so
+///  it only pays off, in case the scan is expensive: long inputs with many tokens or
+///  a multi character separator (e.g. CIsRegex). Short inputs with a single character
+///  separator are tokenized faster without the cache, see "tokenize_bench cache".
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_tokenize_cache<CIsComma> cache(1024 * 1024);
+///         std::vector<std::string> strResult;
+///         cache.Tokenize(strResult, "GET,/health,200");   // miss, the string is scanned
+///         cache.Tokenize(strResult, "GET,/health,200");   // hit, no scan
+///  \endcode
+template < class Pred = CIsSpace > class simple_tokenize_cache
+{
+    public:
+
+        /// \param byteBudget     --> the maximal number of bytes, the cached entries may occupy
+        /// \param numberOfShards --> the number of independently locked parts of the cache
+        /// \param roPred         --> the separator
+        explicit simple_tokenize_cache(std::size_t byteBudget = 1024 * 1024
+                                       , std::size_t numberOfShards = 16
+                                       , const Pred & roPred = Pred());
+
+        simple_tokenize_cache(const simple_tokenize_cache &) = delete;
+        simple_tokenize_cache& operator=(const simple_tokenize_cache &) = delete;
+
+        /// Same result as simple_tokenize<Pred>::Tokenize(roResult, rostr, roPred).
+        void Tokenize(std::vector<std::string>& roResult, const std::string & rostr);
+
+        // a more convenient function. It returns an vector of strings
+        std::vector<std::string> Tokenize(const std::string & rostr);
+
+        /// remove all entries, the counters are kept
+        void Clear(void);
+
+        uint64_t GetHits(void) const
+        {
+            return m_hits.load(std::memory_order_relaxed);
+        }
+
+        uint64_t GetMisses(void) const
+        {
+            return m_misses.load(std::memory_order_relaxed);
+        }
+
+        uint64_t GetEvictions(void) const
+        {
+            return m_evictions.load(std::memory_order_relaxed);
+        }
+
+        /// \return the number of bytes, the cached entries occupy at the moment
+        std::size_t GetBytes(void) const;
+
+        std::size_t GetByteBudget(void) const
+        {
+            return m_shardBudget * m_numberOfShards;
+        }
+
+    private:
+
+        struct SEntry
+        {
+            std::size_t           hash;
+            std::string           line;
+            /// begin and end offset of every token
+            std::vector<uint32_t> bounds;
+
+            std::size_t Bytes(void) const
+            {
+                return sizeof(SEntry) + line.size() + bounds.size() * sizeof(uint32_t);
+            }
+        };
+
+        struct SShard
+        {
+            std::mutex mutex;
+            /// the most recently used entry is in front
+            std::list<SEntry> lru;
+            std::unordered_map<std::size_t, typename std::list<SEntry>::iterator> index;
+            std::size_t bytes;
+
+            SShard(void) : bytes(0) {}
+        };
+
+        void ComputeBounds(std::vector<uint32_t> &bounds, const std::string &rostr) const;
+        bool Lookup(SShard &shard, std::size_t hash, const std::string &rostr, std::vector<uint32_t> &bounds);
+        void Insert(SShard &shard, std::size_t hash, const std::string &rostr, const std::vector<uint32_t> &bounds);
+
+        Pred                      m_Pred;
+        std::size_t               m_numberOfShards;
+        std::size_t               m_shardBudget;
+        std::unique_ptr<SShard[]> m_shards;
+        std::atomic<uint64_t>     m_hits;
+        std::atomic<uint64_t>     m_misses;
+        std::atomic<uint64_t>     m_evictions;
+};
+
+template <class Pred> simple_tokenize_cache<Pred>::simple_tokenize_cache(std::size_t byteBudget
+        , std::size_t numberOfShards
+        , const Pred & roPred)
+    : m_Pred(roPred)
+    , m_numberOfShards(numberOfShards > 0 ? numberOfShards : 1)
+    , m_shardBudget(byteBudget / (numberOfShards > 0 ? numberOfShards : 1))
+    , m_shards(new SShard[numberOfShards > 0 ? numberOfShards : 1])
+    , m_hits(0)
+    , m_misses(0)
+    , m_evictions(0)
+{}
+
+template <class Pred> void simple_tokenize_cache<Pred>::Tokenize(std::vector<std::string>& roResult, const std::string & rostr)
+{
+    // the token boundaries are collected in a per thread buffer, to avoid allocations
+    static thread_local std::vector<uint32_t> bounds;
+    bounds.clear();
+    // the offsets of the boundaries are stored with 32 bits
+    if(rostr.size() > UINT32_MAX)
+    {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        simple_tokenize<Pred>::Tokenize(roResult, rostr, m_Pred);
+        return;
+    }
+
+    const std::size_t hash = std::hash<std::string_view>()(rostr);
+    SShard &shard = m_shards[(hash >> 7) % m_numberOfShards];
+    if(Lookup(shard, hash, rostr, bounds))
+    {
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        ComputeBounds(bounds, rostr);
+        Insert(shard, hash, rostr, bounds);
+    }
+
+    roResult.clear();
+    for(std::size_t ui = 0; ui + 1 < bounds.size(); ui += 2)
+    {
+        roResult.push_back(rostr.substr(bounds[ui], bounds[ui + 1] - bounds[ui]));
+    }
+}
+
+template <class Pred> std::vector<std::string> simple_tokenize_cache<Pred>::Tokenize(const std::string & rostr)
+{
+    std::vector<std::string> roResult;
+    Tokenize(roResult, rostr);
+    return roResult;
+}
+
+template <class Pred> void simple_tokenize_cache<Pred>::ComputeBounds(std::vector<uint32_t> &bounds, const std::string &rostr) const
+{
+    const char *beg = rostr.data();
+    simple_tokenize<Pred>::ForEachToken(rostr, [&bounds, beg](std::string_view token)
+    {
+        bounds.push_back(static_cast<uint32_t>(token.data() - beg));
+        bounds.push_back(static_cast<uint32_t>(token.data() + token.size() - beg));
+    }, m_Pred);
+}
+
+template <class Pred> bool simple_tokenize_cache<Pred>::Lookup(SShard &shard, std::size_t hash, const std::string &rostr, std::vector<uint32_t> &bounds)
+{
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    typename std::unordered_map<std::size_t, typename std::list<SEntry>::iterator>::const_iterator it = shard.index.find(hash);
+    // the input is compared as well, since different inputs may have the same hash
+    if(it == shard.index.end() || it->second->line != rostr)
+    {
+        return false;
+    }
+    // mark as most recently used
+    shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+    bounds = it->second->bounds;
+    return true;
+}
+
+template <class Pred> void simple_tokenize_cache<Pred>::Insert(SShard &shard, std::size_t hash, const std::string &rostr, const std::vector<uint32_t> &bounds)
+{
+    // inputs, that are too large for the cache, are not cached
+    const std::size_t bytes = sizeof(SEntry) + rostr.size() + bounds.size() * sizeof(uint32_t);
+    if(bytes > m_shardBudget)
+    {
+        return;
+    }
+    SEntry entry;
+    entry.hash   = hash;
+    entry.line   = rostr;
+    entry.bounds = bounds;
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    typename std::unordered_map<std::size_t, typename std::list<SEntry>::iterator>::iterator it = shard.index.find(hash);
+    if(it != shard.index.end())
+    {
+        // another thread inserted it meanwhile or a different input has the same hash
+        shard.bytes -= it->second->Bytes();
+        shard.lru.erase(it->second);
+        shard.index.erase(it);
+    }
+    while(!shard.lru.empty() && shard.bytes + bytes > m_shardBudget)
+    {
+        shard.bytes -= shard.lru.back().Bytes();
+        shard.index.erase(shard.lru.back().hash);
+        shard.lru.pop_back();
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.lru.push_front(std::move(entry));
+    shard.index[hash] = shard.lru.begin();
+    shard.bytes += bytes;
+}
+
+template <class Pred> void simple_tokenize_cache<Pred>::Clear(void)
+{
+    for(std::size_t ui = 0; ui < m_numberOfShards; ++ui)
+    {
+        std::lock_guard<std::mutex> lock(m_shards[ui].mutex);
+        m_shards[ui].lru.clear();
+        m_shards[ui].index.clear();
+        m_shards[ui].bytes = 0;
+    }
+}
+
+template <class Pred> std::size_t simple_tokenize_cache<Pred>::GetBytes(void) const
+{
+    std::size_t bytes = 0;
+    for(std::size_t ui = 0; ui < m_numberOfShards; ++ui)
+    {
+        std::lock_guard<std::mutex> lock(m_shards[ui].mutex);
+        bytes += m_shards[ui].bytes;
+    }
+    return bytes;
+}
+
+/** @}*/
+
+#endif // SIMPLE_TOKENIZE_CACHE_HPP
@@ -0,0 +1,234 @@
+/*!
+ * \file simple_tokenize_filter.hpp
+ * \brief A filter stage in front of simple_tokenize.
+ *  Lines, which do not contain the required literals, are rejected before they are
+ *  tokenized. Only the surviving lines are split into tokens.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_TOKENIZE_FILTER_HPP
+#define SIMPLE_TOKENIZE_FILTER_HPP
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "simple_tokenize.hpp"
+#include "simple_simd.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief This class tokenizes only lines, which contain the required literals.
+///  A line passes two stages:
+///   1. a fingerprint of the byte pairs (bigrams) of the line. In case a bigram of a
+///      literal is missing in the line, the literal cannot be contained. This stage is
+///      only used for several literals, because it scans the line once for all of them.
+///   2. a SSE2 substring search of every literal.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_tokenize_filter<> filter(std::vector<std::string>(1, "ERROR"));
+///         std::vector<std::string> strResult;
+///         while(std::getline(ifs, line))
+///         {
+///             if(filter.Tokenize(strResult, line))
+///             {
+///                 process(strResult);
+///             }
+///         }
+///  \endcode
+template < class Pred = CIsSpace > class simple_tokenize_filter
+{
+    public:
+
+        enum EMode
+        {
+            /// all literals have to be contained
+            MODE_ALL,
+            /// at least one literal has to be contained
+            MODE_ANY
+        };
+
+        /// \param roLiterals --> the required literals, empty literals are ignored
+        /// \param mode       --> whether all or any of the literals have to be contained
+        /// \param roPred     --> the separator
+        explicit simple_tokenize_filter(const std::vector<std::string> &roLiterals
+                                        , EMode mode = MODE_ALL
+                                        , const Pred & roPred = Pred());
+
+        simple_tokenize_filter(const simple_tokenize_filter &) = delete;
+        simple_tokenize_filter& operator=(const simple_tokenize_filter &) = delete;
+
+        /// \return true, in case the line contains the required literals
+        bool Accept(std::string_view line);
+
+        /// Tokenize the line, in case it contains the required literals.
+        /// \param roResult <-- the tokens, empty in case the line is rejected
+        /// \return <-- true, in case the line is accepted
+        bool Tokenize(std::vector<std::string>& roResult, std::string_view line);
+
+        /// Enable or disable the fingerprint stage, by default it is used for more than one literal.
+        void SetUseFingerprint(bool useFingerprint)
+        {
+            m_useFingerprint = useFingerprint;
+        }
+
+        uint64_t GetLinesSeen(void) const
+        {
+            return m_linesSeen.load(std::memory_order_relaxed);
+        }
+
+        /// \return the number of lines, that were rejected by the fingerprint
+        uint64_t GetLinesRejectedByFingerprint(void) const
+        {
+            return m_linesRejectedByFingerprint.load(std::memory_order_relaxed);
+        }
+
+        /// \return the number of lines, that were rejected by the substring search
+        uint64_t GetLinesRejectedBySearch(void) const
+        {
+            return m_linesRejectedBySearch.load(std::memory_order_relaxed);
+        }
+
+        uint64_t GetLinesRejected(void) const
+        {
+            return GetLinesRejectedByFingerprint() + GetLinesRejectedBySearch();
+        }
+
+        /// \return the number of bytes of the rejected lines, which were not tokenized
+        uint64_t GetBytesSkipped(void) const
+        {
+            return m_bytesSkipped.load(std::memory_order_relaxed);
+        }
+
+        /// \return the fingerprint of the bigrams of a string, every bigram sets one of 64 bits
+        static uint64_t Fingerprint(std::string_view str)
+        {
+            uint64_t fingerprint = 0;
+            for(std::size_t ui = 1; ui < str.size(); ++ui)
+            {
+                fingerprint |= BigramBit(str[ui - 1], str[ui]);
+            }
+            return fingerprint;
+        }
+
+    private:
+
+        static uint64_t BigramBit(char first, char second)
+        {
+            const unsigned int bigram = (static_cast<unsigned int>(static_cast<unsigned char>(first)) << 8)
+                                        | static_cast<unsigned char>(second);
+            // multiplicative hashing, the upper six bits select the bit
+            return uint64_t(1) << ((bigram * 0x9E3779B1U) >> 26);
+        }
+
+        bool Contains(std::string_view line, const std::string &strLiteral) const
+        {
+            const char *end = line.data() + line.size();
+            return simple_simd::FindSubstring(line.data(), end, strLiteral.data(), strLiteral.size()) != end;
+        }
+
+        bool PassesFingerprint(uint64_t fingerprint) const;
+
+        Pred                     m_Pred;
+        std::vector<std::string> m_literals;
+        std::vector<uint64_t>    m_fingerprints;
+        EMode                    m_mode;
+        bool                     m_useFingerprint;
+        std::atomic<uint64_t>    m_linesSeen;
+        std::atomic<uint64_t>    m_linesRejectedByFingerprint;
+        std::atomic<uint64_t>    m_linesRejectedBySearch;
+        std::atomic<uint64_t>    m_bytesSkipped;
+};
+
+template <class Pred> simple_tokenize_filter<Pred>::simple_tokenize_filter(const std::vector<std::string> &roLiterals
+        , EMode mode
+        , const Pred & roPred)
+    : m_Pred(roPred)
+    , m_mode(mode)
+    , m_useFingerprint(false)
+    , m_linesSeen(0)
+    , m_linesRejectedByFingerprint(0)
+    , m_linesRejectedBySearch(0)
+    , m_bytesSkipped(0)
+{
+    for(std::size_t ui = 0; ui < roLiterals.size(); ++ui)
+    {
+        if(!roLiterals[ui].empty())
+        {
+            m_literals.push_back(roLiterals[ui]);
+            m_fingerprints.push_back(Fingerprint(roLiterals[ui]));
+        }
+    }
+    m_useFingerprint = m_literals.size() > 1;
+}
+
+template <class Pred> bool simple_tokenize_filter<Pred>::PassesFingerprint(uint64_t fingerprint) const
+{
+    for(std::size_t ui = 0; ui < m_fingerprints.size(); ++ui)
+    {
+        const bool possible = (m_fingerprints[ui] & ~fingerprint) == 0;
+        if(m_mode == MODE_ALL && !possible)
+        {
+            return false;
+        }
+        if(m_mode == MODE_ANY && possible)
+        {
+            return true;
+        }
+    }
+    return m_mode == MODE_ALL;
+}
+
+template <class Pred> bool simple_tokenize_filter<Pred>::Accept(std::string_view line)
+{
+    m_linesSeen.fetch_add(1, std::memory_order_relaxed);
+    // without literals every line is accepted
+    if(m_literals.empty())
+    {
+        return true;
+    }
+    if(m_useFingerprint && !PassesFingerprint(Fingerprint(line)))
+    {
+        m_linesRejectedByFingerprint.fetch_add(1, std::memory_order_relaxed);
+        m_bytesSkipped.fetch_add(line.size(), std::memory_order_relaxed);
+        return false;
+    }
+    bool accepted = (m_mode == MODE_ALL);
+    for(std::size_t ui = 0; ui < m_literals.size(); ++ui)
+    {
+        if(Contains(line, m_literals[ui]) != accepted)
+        {
+            accepted = !accepted;
+            break;
+        }
+    }
+    if(!accepted)
+    {
+        m_linesRejectedBySearch.fetch_add(1, std::memory_order_relaxed);
+        m_bytesSkipped.fetch_add(line.size(), std::memory_order_relaxed);
+    }
+    return accepted;
+}
+
+template <class Pred> bool simple_tokenize_filter<Pred>::Tokenize(std::vector<std::string>& roResult, std::string_view line)
+{
+    roResult.clear();
+    if(!Accept(line))
+    {
+        return false;
+    }
+    simple_tokenize<Pred>::ForEachToken(line, [&roResult](std::string_view token)
+    {
+        roResult.push_back(std::string(token));
+    }, m_Pred);
+    return true;
+}
+
+/** @}*/
+
+#endif // SIMPLE_TOKENIZE_FILTER_HPP
@@ -0,0 +1,370 @@
+/*!
+ * \file simple_tokenize_gzip.hpp
+ * \brief Tokenization of gzip compressed files without decompressing them first.
+ *  One thread decompresses the file with zlib into a ring of reusable buffers,
+ *  while the calling thread tokenizes the buffers, that are complete.
+ *  Link with -lz.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_TOKENIZE_GZIP_HPP
+#define SIMPLE_TOKENIZE_GZIP_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include <zlib.h>
+
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief This class streams a gzip file through the tokenizer.
+///  The decompressed data is never held completely in memory, only the ring of buffers
+///  and the beginning of a token, that crosses the end of a buffer, are kept. A token
+///  crossing a buffer boundary is reported as one token. Files, which are not compressed,
+///  are read as they are.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_tokenize_gzip<CIsFromString> reader(1024 * 1024, 4, CIsFromString("\n"));
+///         std::size_t lines = 0;
+///         if(!reader.TokenizeFile("access.log.gz", [&lines](std::string_view line) { ++lines; }))
+///         {
+///             std::cerr << reader.GetError() << std::endl;
+///         }
+///  \endcode
+template < class Pred = CIsSpace > class simple_tokenize_gzip
+{
+    static_assert(!simple_tokenize_is_multichar<Pred>::value, "tokens crossing a buffer are detected by single character separators");
+
+    public:
+
+        /// \param bufferSize      --> the size of one buffer of decompressed data
+        /// \param numberOfBuffers --> the number of buffers in the ring, at least two
+        /// \param roPred          --> the separator
+        explicit simple_tokenize_gzip(std::size_t bufferSize = 1024 * 1024
+                                      , std::size_t numberOfBuffers = 4
+                                      , const Pred & roPred = Pred());
+
+        simple_tokenize_gzip(const simple_tokenize_gzip &) = delete;
+        simple_tokenize_gzip& operator=(const simple_tokenize_gzip &) = delete;
+
+        /// Decompress and tokenize a file. onToken(std::string_view) is called on the calling thread,
+        /// the view is valid only during the call. In case onToken throws, the decompression is
+        /// stopped and the exception is passed on.
+        /// \return <-- false, in case the file cannot be opened or is corrupt, see GetError()
+        template <class F> bool TokenizeFile(const std::string &strFile, F onToken);
+
+        const std::string &GetError(void) const
+        {
+            return m_strError;
+        }
+
+        /// \return the number of decompressed bytes of the last file
+        uint64_t GetBytes(void) const
+        {
+            return m_bytes;
+        }
+
+        /// \return the number of buffers, that were passed from the decompression to the tokenization
+        uint64_t GetNumberOfBuffers(void) const
+        {
+            return m_buffers;
+        }
+
+        /// \return the number of tokens, that crossed a buffer boundary
+        uint64_t GetNumberOfCarriedTokens(void) const
+        {
+            return m_carriedTokens;
+        }
+
+        /// \return the seconds, the decompression thread was busy
+        double GetDecompressSeconds(void) const
+        {
+            return m_decompressSeconds;
+        }
+
+        /// \return the seconds, the tokenization was busy (including onToken)
+        double GetTokenizeSeconds(void) const
+        {
+            return m_tokenizeSeconds;
+        }
+
+        /// \return the seconds of the last call of TokenizeFile
+        double GetWallSeconds(void) const
+        {
+            return m_wallSeconds;
+        }
+
+        /// \return how much of the shorter stage was hidden behind the longer one, between
+        ///         0 (both ran one after the other) and 1 (the shorter stage ran completely in parallel)
+        double GetOverlap(void) const
+        {
+            const double shorter = (m_decompressSeconds < m_tokenizeSeconds) ? m_decompressSeconds : m_tokenizeSeconds;
+            if(shorter <= 0.0)
+            {
+                return 0.0;
+            }
+            const double overlap = (m_decompressSeconds + m_tokenizeSeconds - m_wallSeconds) / shorter;
+            return (overlap < 0.0) ? 0.0 : ((overlap > 1.0) ? 1.0 : overlap);
+        }
+
+    private:
+
+        typedef std::chrono::steady_clock clock;
+
+        static double Seconds(clock::duration duration)
+        {
+            return std::chrono::duration<double>(duration).count();
+        }
+
+        /// the decompression thread
+        void Decompress(gzFile file);
+
+        /// \brief Stops, wakes and joins the decompression thread and closes the file
+        ///  on every way out of TokenizeFile.
+        class CProducerGuard
+        {
+            public:
+                CProducerGuard(simple_tokenize_gzip<Pred> &roOwner, gzFile file)
+                    : m_roOwner(roOwner)
+                    , m_file(file)
+                    , m_thread(&simple_tokenize_gzip<Pred>::Decompress, &roOwner, file)
+                {}
+
+                ~CProducerGuard(void)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_roOwner.m_mutex);
+                        m_roOwner.m_stop = true;
+                    }
+                    m_roOwner.m_freeCondition.notify_all();
+                    m_thread.join();
+                    gzclose(m_file);
+                }
+
+                CProducerGuard(const CProducerGuard &) = delete;
+                CProducerGuard& operator=(const CProducerGuard &) = delete;
+
+            private:
+                simple_tokenize_gzip<Pred> &m_roOwner;
+                gzFile                      m_file;
+                std::thread                 m_thread;
+        };
+
+        /// Tokenize a buffer, the beginning of a token at its end is kept in m_strCarry.
+        template <class F> void TokenizeBuffer(const char *beg, const char *end, F &onToken);
+
+        Pred                     m_Pred;
+        std::size_t              m_bufferSize;
+        std::vector< std::vector<char> > m_ring;
+
+
+        /// the queue of filled buffers (index and size) and of free buffers
+        std::mutex               m_mutex;
+        std::condition_variable  m_filledCondition;
+        std::condition_variable  m_freeCondition;
+        std::deque< std::pair<std::size_t, std::size_t> > m_filled;
+        std::deque<std::size_t>  m_free;
+        bool                     m_finished;
+        /// set by the consumer, in case it leaves before the end of the file
+        bool                     m_stop;
+
+        std::string              m_strCarry;
+        std::string              m_strError;
+        uint64_t                 m_bytes;
+        uint64_t                 m_buffers;
+        uint64_t                 m_carriedTokens;
+        double                   m_decompressSeconds;
+        double                   m_tokenizeSeconds;
+        double                   m_wallSeconds;
+};
+
+template <class Pred> simple_tokenize_gzip<Pred>::simple_tokenize_gzip(std::size_t bufferSize
+        , std::size_t numberOfBuffers
+        , const Pred & roPred)
+    : m_Pred(roPred)
+    , m_bufferSize(bufferSize > 0 ? bufferSize : 1)
+    , m_ring(numberOfBuffers > 2 ? numberOfBuffers : 2)
+    , m_finished(false)
+    , m_stop(false)
+    , m_bytes(0)
+    , m_buffers(0)
+    , m_carriedTokens(0)
+    , m_decompressSeconds(0.0)
+    , m_tokenizeSeconds(0.0)
+    , m_wallSeconds(0.0)
+{}
+
+template <class Pred> template <class F> bool simple_tokenize_gzip<Pred>::TokenizeFile(const std::string &strFile, F onToken)
+{
+    m_strError.clear();
+    m_strCarry.clear();
+    m_bytes = m_buffers = m_carriedTokens = 0;
+    m_decompressSeconds = m_tokenizeSeconds = m_wallSeconds = 0.0;
+
+    gzFile file = gzopen(strFile.c_str(), "rb");
+    if(file == NULL)
+    {
+        m_strError = "unable to open " + strFile;
+        return false;
+    }
+    // the internal buffer of zlib is sized like the buffers of the ring
+    gzbuffer(file, static_cast<unsigned int>(m_bufferSize < 128 * 1024 ? 128 * 1024 : m_bufferSize));
+
+    const clock::time_point start = clock::now();
+    m_filled.clear();
+    m_free.clear();
+    for(std::size_t ui = 0; ui < m_ring.size(); ++ui)
+    {
+        m_ring[ui].resize(m_bufferSize);
+        m_free.push_back(ui);
+    }
+    m_finished = false;
+    m_stop = false;
+    {
+        const CProducerGuard producer(*this, file);
+        while(true)
+        {
+            std::pair<std::size_t, std::size_t> buffer;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_filledCondition.wait(lock, [this]()
+                {
+                    return !m_filled.empty() || m_finished;
+                });
+                if(m_filled.empty())
+                {
+                    break;
+                }
+                buffer = m_filled.front();
+                m_filled.pop_front();
+            }
+
+            const clock::time_point tokenizeStart = clock::now();
+            const char *beg = m_ring[buffer.first].data();
+            TokenizeBuffer(beg, beg + buffer.second, onToken);
+            m_tokenizeSeconds += Seconds(clock::now() - tokenizeStart);
+            ++m_buffers;
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_free.push_back(buffer.first);
+            }
+            m_freeCondition.notify_one();
+        }
+    }
+
+    // the last token of the file
+    if(!m_strCarry.empty() && m_strError.empty())
+    {
+        const clock::time_point tokenizeStart = clock::now();
+        onToken(std::string_view(m_strCarry));
+        m_tokenizeSeconds += Seconds(clock::now() - tokenizeStart);
+    }
+    m_strCarry.clear();
+    m_wallSeconds = Seconds(clock::now() - start);
+    return m_strError.empty();
+}
+
+template <class Pred> void simple_tokenize_gzip<Pred>::Decompress(gzFile file)
+{
+    while(true)
+    {
+        std::size_t index;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_freeCondition.wait(lock, [this]()
+            {
+                return !m_free.empty() || m_stop;
+            });
+            if(m_stop)
+            {
+                return;
+            }
+            index = m_free.front();
+            m_free.pop_front();
+        }
+
+        const clock::time_point start = clock::now();
+        // fill the buffer completely, gzread may return less bytes at the end of a gzip member
+        std::size_t size = 0;
+        bool end = false;
+        while(size < m_bufferSize)
+        {
+            const int bytes = gzread(file, m_ring[index].data() + size, static_cast<unsigned int>(m_bufferSize - size));
+            if(bytes <= 0)
+            {
+                // a truncated file ends with Z_BUF_ERROR, not with a negative result
+                int errorNumber = Z_OK;
+                const char *message = gzerror(file, &errorNumber);
+                if(bytes < 0 || (errorNumber != Z_OK && errorNumber != Z_STREAM_END))
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_strError = std::string("decompression failed: ") + (message ? message : "");
+                }
+                end = true;
+                break;
+            }
+            size += static_cast<std::size_t>(bytes);
+        }
+        m_decompressSeconds += Seconds(clock::now() - start);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bytes += size;
+        if(size > 0)
+        {
+            m_filled.push_back(std::make_pair(index, size));
+        }
+        if(end)
+        {
+            m_finished = true;
+        }
+        m_filledCondition.notify_one();
+        if(end)
+        {
+            return;
+        }
+    }
+}
+
+template <class Pred> template <class F> void simple_tokenize_gzip<Pred>::TokenizeBuffer(const char *beg, const char *end, F &onToken)
+{
+    const char *it = beg;
+    // complete the token of the previous buffer
+    if(!m_strCarry.empty())
+    {
+        while(it != end && !m_Pred(*it)) ++it;
+        m_strCarry.append(beg, it);
+        if(it == end)
+        {
+            // the whole buffer belongs to the token
+            return;
+        }
+        onToken(std::string_view(m_strCarry));
+        m_strCarry.clear();
+        ++m_carriedTokens;
+    }
+    // the last token may continue in the next buffer
+    const char *tokensEnd = end;
+    while(tokensEnd != it && !m_Pred(*(tokensEnd - 1))) --tokensEnd;
+    simple_tokenize<Pred>::ForEachToken(std::string_view(it, static_cast<std::size_t>(tokensEnd - it)), [&onToken](std::string_view token)
+    {
+        onToken(token);
+    }, m_Pred);
+    m_strCarry.assign(tokensEnd, end);
+}
+
+/** @}*/
+
+#endif // SIMPLE_TOKENIZE_GZIP_HPP
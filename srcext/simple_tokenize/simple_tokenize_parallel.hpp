@@ -0,0 +1,54 @@
+/*!
+ * \file simple_tokenize_parallel.hpp
+ * \brief Tokenization of many strings on the threads of simple_thread_pool.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_TOKENIZE_PARALLEL_HPP
+#define SIMPLE_TOKENIZE_PARALLEL_HPP
+
+#include <string>
+#include <vector>
+
+#include "simple_thread_pool.hpp"
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief The parallel counterpart of simple_tokenize<Pred>::Tokenize for a vector of strings.
+///  Every string is tokenized into its own slot, the strings are distributed over the
+///  threads of the shared pool in tasks of at least 64 strings. The order is kept.
+///
+///  The separator is called from several threads at the same time, so its operator()
+///  has to be safe for concurrent calls. The predicates of simple_tokenize.hpp are;
+///  a predicate with mutable state (e.g. a counter) is not and has to use the
+///  sequential simple_tokenize<Pred>::Tokenize instead.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         const std::vector< std::vector<std::string> > strResult = simple_tokenize_parallel<>::Tokenize(strLines);
+///  \endcode
+template < class Pred = CIsSpace > class simple_tokenize_parallel
+{
+    public:
+
+        /// \param vector_of_strings --> the strings to be tokenized
+        /// \param roPred            --> the separator, it is shared by all threads
+        /// \return <-- the tokens of every string, in the order of the strings
+        static std::vector< std::vector<std::string> > Tokenize(const std::vector<std::string> & vector_of_strings
+                , const Pred & roPred = Pred())
+        {
+            std::vector< std::vector<std::string> > result(vector_of_strings.size());
+            simple_thread_pool::GetInstance().ParallelFor(0, vector_of_strings.size(), [&](std::size_t ui)
+            {
+                simple_tokenize<Pred>::Tokenize(result[ui], vector_of_strings[ui], roPred);
+            }, 64);
+            return result;
+        }
+};
+
+/** @}*/
+
+#endif // SIMPLE_TOKENIZE_PARALLEL_HPP
@@ -0,0 +1,838 @@
+/*!
+ * \file simple_tokenize_regex.hpp
+ * \brief A separator for simple_tokenize, which is described by a regular expression.
+ *  The expression is compiled into a minimised, table-driven DFA, whose input
+ *  alphabet is compressed into byte classes. Matching never backtracks.
+ *
+ *  Supported syntax (a restricted regular expression language):
+ *   - literals, '.' (any byte), escapes \\t \\n \\r \\f \\v \\xHH and escaped meta characters
+ *   - the classes \\s \\d \\w \\S \\D \\W and bracket expressions [a-z,;] [^...]
+ *   - groups (...), alternation a|b and the quantifiers * + ?
+ *  Anchors, counted repetitions and back references are not supported.
+ *  Expressions that match the empty string are rejected, since a separator
+ *  has to consume at least one character. So are expressions, whose groups are
+ *  nested deeper than MAX_DEPTH or whose DFA needs more than MAX_STATES states.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_TOKENIZE_REGEX_HPP
+#define SIMPLE_TOKENIZE_REGEX_HPP
+
+#include <algorithm>
+#include <bitset>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "simple_tokenize.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief This class can be used as template parameter for simple_tokenize.
+/// In case a string should be split according to a regular expression, use this
+/// class as template parameter.
+/// This is illustrated in following example code:
+/// \code{.cpp}
+///  const CIsRegex separator(" *[,;] *");
+///  std::vector<std::string> result;
+///  simple_tokenize<CIsRegex>::Tokenize(result, "a , b;c ;d", separator);
+///  // result: "a", "b", "c", "d"
+/// \endcode
+/// The separators are matched leftmost-longest. Tokenizing a string takes time
+/// linear in its length: the scan from a candidate position stops at the first
+/// (state, position) pair that is already known not to lead to a match.
+/// The member functions are const and may be called by several threads at the same time.
+class CIsRegex
+{
+    public:
+        /// marks this class as a separator of several characters, see simple_tokenize_is_multichar
+        typedef void multichar_separator;
+
+        /// the maximal nesting depth of groups
+        static constexpr std::size_t MAX_DEPTH  = 256;
+        /// the maximal number of states of the DFA before it is minimised
+        static constexpr std::size_t MAX_STATES = 10000;
+
+        /// Compile the expression. By default, runs of blanks are separators.
+        /// \param strPattern --> the regular expression describing a separator
+        explicit CIsRegex(const std::string &strPattern = " +");
+
+        /// \return true, in case the expression was compiled successfully
+        bool IsValid(void) const
+        {
+            return m_strError.empty();
+        }
+
+        /// \return a description of the compilation error or an empty string
+        const std::string &GetError(void) const
+        {
+            return m_strError;
+        }
+
+        /// \return the number of states of the minimised DFA (including the dead state)
+        std::size_t GetNumberOfStates(void) const
+        {
+            return m_accept.size();
+        }
+
+        /// \return the number of byte classes, the DFA distinguishes
+        std::size_t GetNumberOfByteClasses(void) const
+        {
+            return m_numClasses;
+        }
+
+        /// Determine the length of the longest separator, which starts at beg.
+        /// \return <-- the length of the match or zero, in case there is none
+        std::size_t MatchLength(const char *beg, const char *end) const;
+
+        /// Call onToken(tokenBeg, tokenEnd) for every non-empty token of [beg, end).
+        template <class F> void ForEachToken(const char *beg, const char *end, F onToken) const;
+
+    private:
+
+        // ----------------------------------------
+        // parser, building an abstract syntax tree
+        // ----------------------------------------
+        typedef enum
+        {
+            NODE_SET
+            , NODE_CONCAT
+            , NODE_ALTERNATE
+            , NODE_STAR
+            , NODE_PLUS
+            , NODE_OPTIONAL
+        } ENodeType;
+
+        struct SNode
+        {
+            ENodeType type;
+            int       set;      // index into m_sets for NODE_SET
+            int       left;
+            int       right;
+        };
+
+        int ParseAlternate(void);
+        int ParseConcat(void);
+        int ParseRepeat(void);
+        int ParseAtom(void);
+        bool ParseEscape(std::bitset<256> &set);
+        int AddNode(ENodeType type, int set, int left, int right);
+        int Fail(const std::string &strError);
+        /// Record the error and replace the automaton by the dead state.
+        void Reject(const std::string &strError);
+
+        // ----------------------------------------
+        // Thompson NFA
+        // ----------------------------------------
+        struct SNfaState
+        {
+            int              set;   // byte transition, -1 in case there is none
+            int              next;
+            std::vector<int> epsilon;
+        };
+
+        void BuildNfa(int node, int &start, int &accept);
+        int AddNfaState(void);
+        void Closure(std::vector<int> &states) const;
+
+        // ----------------------------------------
+        // DFA construction
+        // ----------------------------------------
+        void BuildByteClasses(void);
+        bool BuildDfa(int nfaStart, int nfaAccept);
+        void Minimise(void);
+
+        /// The (state, position) pairs of ForEachToken, that do not lead to a match.
+        /// Only the set pairs are cleared, so the buffer is reused by the calls of a thread.
+        struct SFailedPairs
+        {
+            std::vector<bool>        failed;
+            std::vector<std::size_t> set;
+            /// the pairs of the current scan
+            std::vector<std::size_t> trail;
+            bool                     busy;
+
+            SFailedPairs(void) : busy(false) {}
+        };
+
+        /// \return <-- the buffer of the calling thread
+        static SFailedPairs &ThreadPairs(void)
+        {
+            static thread_local SFailedPairs pairs;
+            return pairs;
+        }
+
+        std::string                   m_strPattern;
+        std::size_t                   m_parsePos;
+        std::size_t                   m_depth;
+        std::string                   m_strError;
+        std::vector<SNode>            m_nodes;
+        std::vector< std::bitset<256> > m_sets;
+        std::vector<SNfaState>        m_nfa;
+
+        /// byte -> byte class
+        uint8_t                       m_byteClass[256];
+        /// true for every byte, a separator can start with
+        bool                          m_canStart[256];
+        std::size_t                   m_numClasses;
+        /// transition table, m_table[state * m_numClasses + class], state 0 is the dead state
+        std::vector<uint32_t>         m_table;
+        std::vector<uint8_t>          m_accept;
+        uint32_t                      m_start;
+};
+
+inline CIsRegex::CIsRegex(const std::string &strPattern)
+    : m_strPattern(strPattern)
+    , m_parsePos(0)
+    , m_depth(0)
+    , m_numClasses(1)
+    , m_start(0)
+{
+    std::fill(m_byteClass, m_byteClass + 256, 0);
+    std::fill(m_canStart, m_canStart + 256, false);
+    // a single dead state, that never matches
+    m_table.assign(1, 0);
+    m_accept.assign(1, 0);
+
+    if(m_strPattern.empty())
+    {
+        Reject("empty expression");
+        return;
+    }
+    const int root = ParseAlternate();
+    if(m_strError.empty() && m_parsePos < m_strPattern.size())
+    {
+        Fail("unbalanced ')'");
+    }
+    if(!m_strError.empty())
+    {
+        Reject(m_strError);
+        return;
+    }
+
+    int nfaStart  = 0;
+    int nfaAccept = 0;
+    BuildNfa(root, nfaStart, nfaAccept);
+    BuildByteClasses();
+    if(!BuildDfa(nfaStart, nfaAccept))
+    {
+        Reject("expression needs more than " + std::to_string(MAX_STATES) + " DFA states");
+        return;
+    }
+    Minimise();
+
+    if(m_accept[m_start])
+    {
+        Reject("expression matches the empty string");
+        return;
+    }
+    for(unsigned int c = 0; c < 256; ++c)
+    {
+        m_canStart[c] = (m_table[m_start * m_numClasses + m_byteClass[c]] != 0);
+    }
+    // the syntax tree and the NFA are not needed anymore
+    m_nodes.clear();
+    m_sets.clear();
+    m_nfa.clear();
+}
+
+inline int CIsRegex::Fail(const std::string &strError)
+{
+    if(m_strError.empty())
+    {
+        m_strError = strError + " at position " + std::to_string(m_parsePos);
+    }
+    return -1;
+}
+
+inline void CIsRegex::Reject(const std::string &strError)
+{
+    m_strError = strError;
+    std::fill(m_byteClass, m_byteClass + 256, 0);
+    m_numClasses = 1;
+    m_table.assign(1, 0);
+    m_accept.assign(1, 0);
+    m_start = 0;
+    m_nodes.clear();
+    m_sets.clear();
+    m_nfa.clear();
+}
+
+inline int CIsRegex::AddNode(ENodeType type, int set, int left, int right)
+{
+    SNode node = { type, set, left, right };
+    m_nodes.push_back(node);
+    return static_cast<int>(m_nodes.size()) - 1;
+}
+
+inline int CIsRegex::ParseAlternate(void)
+{
+    int left = ParseConcat();
+    while(left >= 0 && m_parsePos < m_strPattern.size() && m_strPattern[m_parsePos] == '|')
+    {
+        ++m_parsePos;
+        const int right = ParseConcat();
+        if(right < 0)
+        {
+            return -1;
+        }
+        left = AddNode(NODE_ALTERNATE, -1, left, right);
+    }
+    return left;
+}
+
+inline int CIsRegex::ParseConcat(void)
+{
+    int left = -1;
+    while(m_parsePos < m_strPattern.size() && m_strPattern[m_parsePos] != '|' && m_strPattern[m_parsePos] != ')')
+    {
+        const int right = ParseRepeat();
+        if(right < 0)
+        {
+            return -1;
+        }
+        left = (left < 0) ? right : AddNode(NODE_CONCAT, -1, left, right);
+    }
+    if(left < 0)
+    {
+        return Fail("empty sub-expression");
+    }
+    return left;
+}
+
+inline int CIsRegex::ParseRepeat(void)
+{
+    int node = ParseAtom();
+    while(node >= 0 && m_parsePos < m_strPattern.size())
+    {
+        const char c = m_strPattern[m_parsePos];
+        if(c == '*')
+        {
+            node = AddNode(NODE_STAR, -1, node, -1);
+        }
+        else if(c == '+')
+        {
+            node = AddNode(NODE_PLUS, -1, node, -1);
+        }
+        else if(c == '?')
+        {
+            node = AddNode(NODE_OPTIONAL, -1, node, -1);
+        }
+        else
+        {
+            break;
+        }
+        ++m_parsePos;
+    }
+    return node;
+}
+
+inline int CIsRegex::ParseAtom(void)
+{
+    std::bitset<256> set;
+    const char c = m_strPattern[m_parsePos++];
+    switch(c)
+    {
+        case '(':
+        {
+            // the parser descends once per group, the depth bounds its recursion
+            if(++m_depth > MAX_DEPTH)
+            {
+                return Fail("groups nested too deeply");
+            }
+            const int node = ParseAlternate();
+            --m_depth;
+            if(node < 0)
+            {
+                return -1;
+            }
+            if(m_parsePos >= m_strPattern.size() || m_strPattern[m_parsePos] != ')')
+            {
+                return Fail("missing ')'");
+            }
+            ++m_parsePos;
+            return node;
+        }
+        case '*':
+        case '+':
+        case '?':
+            return Fail("quantifier without operand");
+        case '.':
+            set.set();
+            break;
+        case '\\':
+            if(!ParseEscape(set))
+            {
+                return -1;
+            }
+            break;
+        case '[':
+        {
+            bool bNegate = false;
+            if(m_parsePos < m_strPattern.size() && m_strPattern[m_parsePos] == '^')
+            {
+                bNegate = true;
+                ++m_parsePos;
+            }
+            bool bFirst = true;
+            while(m_parsePos < m_strPattern.size() && (bFirst || m_strPattern[m_parsePos] != ']'))
+            {
+                bFirst = false;
+                std::bitset<256> item;
+                unsigned char lower = static_cast<unsigned char>(m_strPattern[m_parsePos++]);
+                if(lower == '\\')
+                {
+                    if(!ParseEscape(item))
+                    {
+                        return -1;
+                    }
+                    if(item.count() != 1)
+                    {
+                        set |= item;
+                        continue;
+                    }
+                    for(lower = 0; !item.test(lower); ++lower) {}
+                }
+                unsigned char upper = lower;
+                if(m_parsePos + 1 < m_strPattern.size() && m_strPattern[m_parsePos] == '-' && m_strPattern[m_parsePos + 1] != ']')
+                {
+                    ++m_parsePos;
+                    upper = static_cast<unsigned char>(m_strPattern[m_parsePos++]);
+                    if(upper == '\\')
+                    {
+                        std::bitset<256> upperItem;
+                        if(!ParseEscape(upperItem))
+                        {
+                            return -1;
+                        }
+                        if(upperItem.count() != 1)
+                        {
+                            return Fail("invalid range");
+                        }
+                        for(upper = 0; !upperItem.test(upper); ++upper) {}
+                    }
+                    if(upper < lower)
+                    {
+                        return Fail("invalid range");
+                    }
+                }
+                for(unsigned int b = lower; b <= upper; ++b)
+                {
+                    set.set(b);
+                }
+            }
+            if(m_parsePos >= m_strPattern.size())
+            {
+                return Fail("missing ']'");
+            }
+            ++m_parsePos;
+            if(bNegate)
+            {
+                set.flip();
+            }
+            break;
+        }
+        default:
+            set.set(static_cast<unsigned char>(c));
+            break;
+    }
+    m_sets.push_back(set);
+    return AddNode(NODE_SET, static_cast<int>(m_sets.size()) - 1, -1, -1);
+}
+
+inline bool CIsRegex::ParseEscape(std::bitset<256> &set)
+{
+    if(m_parsePos >= m_strPattern.size())
+    {
+        Fail("trailing '\\'");
+        return false;
+    }
+    const char c = m_strPattern[m_parsePos++];
+    switch(c)
+    {
+        case 't':
+            set.set('\t');
+            break;
+        case 'n':
+            set.set('\n');
+            break;
+        case 'r':
+            set.set('\r');
+            break;
+        case 'f':
+            set.set('\f');
+            break;
+        case 'v':
+            set.set('\v');
+            break;
+        case 's':
+        case 'S':
+            set.set(' ').set('\t').set('\n').set('\v').set('\f').set('\r');
+            break;
+        case 'd':
+        case 'D':
+            for(unsigned int b = '0'; b <= '9'; ++b) set.set(b);
+            break;
+        case 'w':
+        case 'W':
+            for(unsigned int b = 0; b < 256; ++b)
+            {
+                if(isalnum(static_cast<int>(b)) || b == '_') set.set(b);
+            }
+            break;
+        case 'x':
+        {
+            if(m_parsePos + 2 > m_strPattern.size()
+                    || !isxdigit(static_cast<unsigned char>(m_strPattern[m_parsePos]))
+                    || !isxdigit(static_cast<unsigned char>(m_strPattern[m_parsePos + 1])))
+            {
+                Fail("invalid \\x escape");
+                return false;
+            }
+            set.set(std::stoul(m_strPattern.substr(m_parsePos, 2), NULL, 16));
+            m_parsePos += 2;
+            break;
+        }
+        default:
+            set.set(static_cast<unsigned char>(c));
+            break;
+    }
+    if(c == 'S' || c == 'D' || c == 'W')
+    {
+        set.flip();
+    }
+    return true;
+}
+
+inline int CIsRegex::AddNfaState(void)
+{
+    SNfaState state;
+    state.set  = -1;
+    state.next = -1;
+    m_nfa.push_back(state);
+    return static_cast<int>(m_nfa.size()) - 1;
+}
+
+inline void CIsRegex::BuildNfa(int root, int &start, int &accept)
+{
+    // the children of a node are created before the node itself, so the fragments
+    // are built in the order of the nodes and a long expression does not recurse
+    std::vector<int> starts(m_nodes.size(), 0);
+    std::vector<int> accepts(m_nodes.size(), 0);
+    for(int node = 0; node <= root; ++node)
+    {
+        const SNode current = m_nodes[node];
+        if(current.type == NODE_SET)
+        {
+            starts[node]  = AddNfaState();
+            accepts[node] = AddNfaState();
+            m_nfa[starts[node]].set  = current.set;
+            m_nfa[starts[node]].next = accepts[node];
+            continue;
+        }
+        const int leftStart  = starts[current.left];
+        const int leftAccept = accepts[current.left];
+        if(current.type == NODE_CONCAT)
+        {
+            m_nfa[leftAccept].epsilon.push_back(starts[current.right]);
+            starts[node]  = leftStart;
+            accepts[node] = accepts[current.right];
+            continue;
+        }
+        const int nodeStart  = AddNfaState();
+        const int nodeAccept = AddNfaState();
+        starts[node]  = nodeStart;
+        accepts[node] = nodeAccept;
+        m_nfa[nodeStart].epsilon.push_back(leftStart);
+        m_nfa[leftAccept].epsilon.push_back(nodeAccept);
+        switch(current.type)
+        {
+            case NODE_ALTERNATE:
+                m_nfa[nodeStart].epsilon.push_back(starts[current.right]);
+                m_nfa[accepts[current.right]].epsilon.push_back(nodeAccept);
+                break;
+            case NODE_STAR:
+                m_nfa[nodeStart].epsilon.push_back(nodeAccept);
+                m_nfa[leftAccept].epsilon.push_back(leftStart);
+                break;
+            case NODE_PLUS:
+                m_nfa[leftAccept].epsilon.push_back(leftStart);
+                break;
+            case NODE_OPTIONAL:
+                m_nfa[nodeStart].epsilon.push_back(nodeAccept);
+                break;
+            default:
+                break;
+        }
+    }
+    start  = starts[root];
+    accept = accepts[root];
+}
+
+inline void CIsRegex::Closure(std::vector<int> &states) const
+{
+    std::vector<bool> visited(m_nfa.size(), false);
+    std::vector<int> stack(states);
+    states.clear();
+    while(!stack.empty())
+    {
+        const int state = stack.back();
+        stack.pop_back();
+        if(visited[state])
+        {
+            continue;
+        }
+        visited[state] = true;
+        states.push_back(state);
+        stack.insert(stack.end(), m_nfa[state].epsilon.begin(), m_nfa[state].epsilon.end());
+    }
+    std::sort(states.begin(), states.end());
+}
+
+inline void CIsRegex::BuildByteClasses(void)
+{
+    // two bytes are in the same class, in case every set of the expression
+    // either contains both of them or none of them
+    std::map<std::vector<bool>, uint8_t> classes;
+    for(unsigned int b = 0; b < 256; ++b)
+    {
+        std::vector<bool> signature(m_sets.size());
+        for(std::size_t s = 0; s < m_sets.size(); ++s)
+        {
+            signature[s] = m_sets[s].test(b);
+        }
+        std::map<std::vector<bool>, uint8_t>::const_iterator it = classes.find(signature);
+        if(it == classes.end())
+        {
+            it = classes.insert(std::make_pair(signature, static_cast<uint8_t>(classes.size()))).first;
+        }
+        m_byteClass[b] = it->second;
+    }
+    m_numClasses = classes.size();
+}
+
+inline bool CIsRegex::BuildDfa(int nfaStart, int nfaAccept)
+{
+    // a representative byte of every class
+    std::vector<unsigned int> representative(m_numClasses, 0);
+    for(unsigned int b = 256; b-- > 0;)
+    {
+        representative[m_byteClass[b]] = b;
+    }
+
+    // subset construction, the empty set is the dead state 0
+    std::map<std::vector<int>, uint32_t> ids;
+    std::vector< std::vector<int> > subsets(1);
+    ids[subsets[0]] = 0;
+    std::vector<int> startSet(1, nfaStart);
+    Closure(startSet);
+    ids[startSet] = 1;
+    subsets.push_back(startSet);
+
+    m_table.assign(m_numClasses, 0);
+    for(std::size_t current = 1; current < subsets.size(); ++current)
+    {
+        m_table.resize((current + 1) * m_numClasses, 0);
+        for(std::size_t cls = 0; cls < m_numClasses; ++cls)
+        {
+            std::vector<int> target;
+            for(std::size_t i = 0; i < subsets[current].size(); ++i)
+            {
+                const SNfaState &state = m_nfa[subsets[current][i]];
+                if(state.set >= 0 && m_sets[state.set].test(representative[cls]))
+                {
+                    target.push_back(state.next);
+                }
+            }
+            Closure(target);
+            std::map<std::vector<int>, uint32_t>::const_iterator it = ids.find(target);
+            if(it == ids.end())
+            {
+                // the number of subsets can grow exponentially with the expression
+                if(subsets.size() >= MAX_STATES)
+                {
+                    return false;
+                }
+                it = ids.insert(std::make_pair(target, static_cast<uint32_t>(subsets.size()))).first;
+                subsets.push_back(target);
+            }
+            m_table[current * m_numClasses + cls] = it->second;
+        }
+    }
+
+    m_accept.assign(subsets.size(), 0);
+    for(std::size_t current = 0; current < subsets.size(); ++current)
+    {
+        m_accept[current] = std::binary_search(subsets[current].begin(), subsets[current].end(), nfaAccept) ? 1 : 0;
+    }
+    m_start = 1;
+    return true;
+}
+
+inline void CIsRegex::Minimise(void)
+{
+    // Moore's partition refinement: start with accepting/non accepting states and split
+    // blocks, whose states reach different blocks, until the partition is stable
+    const std::size_t numStates = m_accept.size();
+    std::vector<uint32_t> block(numStates);
+    for(std::size_t s = 0; s < numStates; ++s)
+    {
+        block[s] = m_accept[s];
+    }
+    std::size_t numBlocks = 0;
+    while(true)
+    {
+        std::map<std::vector<uint32_t>, uint32_t> signatures;
+        // the dead state gets block 0
+        std::vector<uint32_t> newBlock(numStates);
+        for(std::size_t s = 0; s < numStates; ++s)
+        {
+            std::vector<uint32_t> signature(1, block[s]);
+            for(std::size_t cls = 0; cls < m_numClasses; ++cls)
+            {
+                signature.push_back(block[m_table[s * m_numClasses + cls]]);
+            }
+            std::map<std::vector<uint32_t>, uint32_t>::const_iterator it = signatures.find(signature);
+            if(it == signatures.end())
+            {
+                it = signatures.insert(std::make_pair(signature, static_cast<uint32_t>(signatures.size()))).first;
+            }
+            newBlock[s] = it->second;
+        }
+        block.swap(newBlock);
+        if(signatures.size() == numBlocks)
+        {
+            break;
+        }
+        numBlocks = signatures.size();
+    }
+
+    std::vector<uint32_t> table(numBlocks * m_numClasses, 0);
+    std::vector<uint8_t> accept(numBlocks, 0);
+    for(std::size_t s = 0; s < numStates; ++s)
+    {
+        for(std::size_t cls = 0; cls < m_numClasses; ++cls)
+        {
+            table[block[s] * m_numClasses + cls] = block[m_table[s * m_numClasses + cls]];
+        }
+        accept[block[s]] = m_accept[s];
+    }
+    m_table.swap(table);
+    m_accept.swap(accept);
+    m_start = block[m_start];
+}
+
+inline std::size_t CIsRegex::MatchLength(const char *beg, const char *end) const
+{
+    std::size_t length = 0;
+    uint32_t state = m_start;
+    for(const char *it = beg; it != end; ++it)
+    {
+        state = m_table[state * m_numClasses + m_byteClass[static_cast<unsigned char>(*it)]];
+        if(state == 0)
+        {
+            break;
+        }
+        if(m_accept[state])
+        {
+            length = static_cast<std::size_t>(it - beg) + 1;
+        }
+    }
+    return length;
+}
+
+template <class F> inline void CIsRegex::ForEachToken(const char *beg, const char *end, F onToken) const
+{
+    const std::size_t length = static_cast<std::size_t>(end - beg);
+    // (state, position) pairs, that are known not to lead to a match. The bitmap of
+    // the thread is reused, unless onToken tokenizes again (then it is in use).
+    SFailedPairs &threadPairs = ThreadPairs();
+    SFailedPairs localPairs;
+    SFailedPairs &pairs = threadPairs.busy ? localPairs : threadPairs;
+    for(std::size_t i = 0; i < pairs.set.size(); ++i)
+    {
+        pairs.failed[pairs.set[i]] = false;
+    }
+    pairs.set.clear();
+    pairs.busy = true;
+    struct SRelease
+    {
+        SFailedPairs &pairs;
+        ~SRelease(void)
+        {
+            pairs.busy = false;
+        }
+    } release = { pairs };
+    bool bFailed = false;
+    std::vector<std::size_t> &trail = pairs.trail;
+
+    std::size_t tokenBeg = 0;
+    std::size_t pos      = 0;
+    while(pos < length)
+    {
+        // skip characters, a separator cannot start with
+        if(!m_canStart[static_cast<unsigned char>(beg[pos])])
+        {
+            ++pos;
+            continue;
+        }
+        // longest match starting at pos
+        std::size_t matchEnd = 0;
+        uint32_t state = m_start;
+        trail.clear();
+        for(std::size_t i = pos; i < length; ++i)
+        {
+            if(bFailed && pairs.failed[state * (length + 1) + i])
+            {
+                break;
+            }
+            trail.push_back(state * (length + 1) + i);
+            state = m_table[state * m_numClasses + m_byteClass[static_cast<unsigned char>(beg[i])]];
+            if(state == 0)
+            {
+                break;
+            }
+            if(m_accept[state])
+            {
+                matchEnd = i + 1;
+                trail.clear();
+            }
+        }
+        // the pairs after the last accepting state do not lead to a match
+        if(trail.size() > 1)
+        {
+            if(pairs.failed.size() < m_accept.size() * (length + 1))
+            {
+                pairs.failed.resize(m_accept.size() * (length + 1), false);
+            }
+            bFailed = true;
+            for(std::size_t i = 0; i < trail.size(); ++i)
+            {
+                pairs.failed[trail[i]] = true;
+            }
+            pairs.set.insert(pairs.set.end(), trail.begin(), trail.end());
+        }
+        if(matchEnd == 0)
+        {
+            ++pos;
+            continue;
+        }
+        if(pos > tokenBeg)
+        {
+            onToken(beg + tokenBeg, beg + pos);
+        }
+        pos      = matchEnd;
+        tokenBeg = matchEnd;
+    }
+    if(length > tokenBeg)
+    {
+        onToken(beg + tokenBeg, end);
+    }
+}
+
+/** @}*/
+
+#endif // SIMPLE_TOKENIZE_REGEX_HPP
@@ -0,0 +1,280 @@
+/*!
+ * \file simple_tokenize_stats.hpp
+ * \brief Optional instrumentation of simple_tokenize.
+ *  The hooks, which are placed in simple_tokenize, only count, in case
+ *  SIMPLE_TOKENIZE_STATS is defined. Only then simple_tokenize.hpp includes this
+ *  header, otherwise the hooks expand to nothing. The counters themselves do not
+ *  depend on the switch.
+ *
+ *  The switch changes the bodies of the inline templates of simple_tokenize, so it
+ *  has to be the same in every translation unit of a program. Never define it in a
+ *  source file, pass it to the compiler instead: -DSIMPLE_TOKENIZE_STATS, which is
+ *  what 'make STATS=yes' does.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_TOKENIZE_STATS_HPP
+#define SIMPLE_TOKENIZE_STATS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief The aggregated counters of all threads.
+struct simple_tokenize_counters
+{
+    uint64_t calls;
+    uint64_t bytesScanned;
+    uint64_t tokens;
+    uint64_t bytesCopied;
+    /// estimated heap allocations of the result vector and of the token strings.
+    /// The allocator is not hooked: a full vector counts as one allocation and a
+    /// token counts as one, in case it does not fit into the short string buffer.
+    uint64_t allocations;
+    uint64_t longestToken;
+    uint64_t nanoseconds;
+
+    simple_tokenize_counters(void)
+        : calls(0), bytesScanned(0), tokens(0), bytesCopied(0)
+        , allocations(0), longestToken(0), nanoseconds(0)
+    {}
+};
+
+/// \brief Every thread counts into its own set of counters, which are only written
+///  by that thread. Snapshot() sums them up on demand. The counters of a terminated
+///  thread are kept.
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         // compiled with -DSIMPLE_TOKENIZE_STATS
+///         #include "simple_tokenize.hpp"
+///         ...
+///         simple_tokenize_stats::Dump(std::cout);
+///  \endcode
+class simple_tokenize_stats
+{
+    public:
+
+        /// \return the sum of the counters of all threads
+        static simple_tokenize_counters Snapshot(void)
+        {
+            SRegistry &registry = Registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            simple_tokenize_counters result(registry.retired);
+            for(std::size_t ui = 0; ui < registry.threads.size(); ++ui)
+            {
+                Add(result, *registry.threads[ui]);
+            }
+            return result;
+        }
+
+        /// Set the counters of all threads to zero.
+        static void Reset(void)
+        {
+            SRegistry &registry = Registry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.retired = simple_tokenize_counters();
+            for(std::size_t ui = 0; ui < registry.threads.size(); ++ui)
+            {
+                STLSCounters &counters = *registry.threads[ui];
+                counters.calls.store(0, std::memory_order_relaxed);
+                counters.bytesScanned.store(0, std::memory_order_relaxed);
+                counters.tokens.store(0, std::memory_order_relaxed);
+                counters.bytesCopied.store(0, std::memory_order_relaxed);
+                counters.allocations.store(0, std::memory_order_relaxed);
+                counters.longestToken.store(0, std::memory_order_relaxed);
+                counters.nanoseconds.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /// Write the counters in the text format of Prometheus.
+        static void Dump(std::ostream &os, const std::string &strPrefix = "simple_tokenize")
+        {
+            const simple_tokenize_counters counters(Snapshot());
+            DumpMetric(os, strPrefix + "_calls_total", "counter", "Number of tokenize calls.", counters.calls);
+            DumpMetric(os, strPrefix + "_scanned_bytes_total", "counter", "Number of bytes scanned.", counters.bytesScanned);
+            DumpMetric(os, strPrefix + "_tokens_total", "counter", "Number of tokens emitted.", counters.tokens);
+            DumpMetric(os, strPrefix + "_copied_bytes_total", "counter", "Number of bytes copied into result strings.", counters.bytesCopied);
+            DumpMetric(os, strPrefix + "_allocations_total", "counter", "Estimated number of heap allocations.", counters.allocations);
+            DumpMetric(os, strPrefix + "_longest_token_bytes", "gauge", "Length of the longest token.", counters.longestToken);
+            os << "# HELP " << strPrefix << "_seconds_total Time spent tokenizing.\n"
+               << "# TYPE " << strPrefix << "_seconds_total counter\n"
+               << strPrefix << "_seconds_total " << static_cast<double>(counters.nanoseconds) * 1e-9 << "\n";
+        }
+
+        /// \return the output of Dump() as string
+        static std::string ToPrometheus(const std::string &strPrefix = "simple_tokenize")
+        {
+            std::ostringstream oss;
+            Dump(oss, strPrefix);
+            return oss.str();
+        }
+
+        /// \brief Counts one call and measures its duration, see SIMPLE_TOKENIZE_STATS_CALL.
+        class CCall
+        {
+            public:
+                explicit CCall(std::size_t bytes)
+                    : m_start(std::chrono::steady_clock::now())
+                {
+                    STLSCounters &counters = Local();
+                    Increment(counters.calls, 1);
+                    Increment(counters.bytesScanned, bytes);
+                }
+
+                ~CCall(void)
+                {
+                    Increment(Local().nanoseconds, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count()));
+                }
+
+                CCall(const CCall &) = delete;
+                CCall& operator=(const CCall &) = delete;
+
+            private:
+                std::chrono::steady_clock::time_point m_start;
+        };
+
+        /// Count an emitted token.
+        static void OnToken(std::size_t length)
+        {
+            STLSCounters &counters = Local();
+            Increment(counters.tokens, 1);
+            if(length > counters.longestToken.load(std::memory_order_relaxed))
+            {
+                counters.longestToken.store(length, std::memory_order_relaxed);
+            }
+        }
+
+        /// Count a token, which is copied into a new string, that is appended to a vector.
+        /// \param vectorGrows --> true, in case the vector is full before the token is appended
+        static void OnCopy(bool vectorGrows, std::size_t length)
+        {
+            STLSCounters &counters = Local();
+            OnToken(length);
+            Increment(counters.bytesCopied, length);
+            // short strings are stored inside of std::string
+            const uint64_t allocations = (vectorGrows ? 1 : 0) + (length > std::string().capacity() ? 1 : 0);
+            Increment(counters.allocations, allocations);
+        }
+
+    private:
+
+        /// The counters of one thread. Only the owning thread writes, so a relaxed
+        /// load and store is sufficient and no locked instruction is needed.
+        struct STLSCounters
+        {
+            std::atomic<uint64_t> calls;
+            std::atomic<uint64_t> bytesScanned;
+            std::atomic<uint64_t> tokens;
+            std::atomic<uint64_t> bytesCopied;
+            std::atomic<uint64_t> allocations;
+            std::atomic<uint64_t> longestToken;
+            std::atomic<uint64_t> nanoseconds;
+
+            STLSCounters(void)
+                : calls(0), bytesScanned(0), tokens(0), bytesCopied(0)
+                , allocations(0), longestToken(0), nanoseconds(0)
+            {}
+        };
+
+        struct SRegistry
+        {
+            std::mutex                     mutex;
+            std::vector<STLSCounters*>     threads;
+            /// the sum of the counters of terminated threads
+            simple_tokenize_counters       retired;
+        };
+
+        /// Registers the counters of a thread while it is running.
+        struct SThreadHandle
+        {
+            STLSCounters counters;
+
+            SThreadHandle(void)
+            {
+                SRegistry &registry = Registry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                registry.threads.push_back(&counters);
+            }
+
+            ~SThreadHandle(void)
+            {
+                SRegistry &registry = Registry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                Add(registry.retired, counters);
+                for(std::size_t ui = 0; ui < registry.threads.size(); ++ui)
+                {
+                    if(registry.threads[ui] == &counters)
+                    {
+                        registry.threads.erase(registry.threads.begin() + static_cast<std::ptrdiff_t>(ui));
+                        break;
+                    }
+                }
+            }
+        };
+
+        static SRegistry &Registry(void)
+        {
+            // never destroyed, since threads may terminate after the static destructors ran
+            static SRegistry *registry = new SRegistry;
+            return *registry;
+        }
+
+        static STLSCounters &Local(void)
+        {
+            static thread_local SThreadHandle handle;
+            return handle.counters;
+        }
+
+        static void Increment(std::atomic<uint64_t> &counter, uint64_t value)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+        }
+
+        static void Add(simple_tokenize_counters &result, const STLSCounters &counters)
+        {
+            result.calls        += counters.calls.load(std::memory_order_relaxed);
+            result.bytesScanned += counters.bytesScanned.load(std::memory_order_relaxed);
+            result.tokens       += counters.tokens.load(std::memory_order_relaxed);
+            result.bytesCopied  += counters.bytesCopied.load(std::memory_order_relaxed);
+            result.allocations  += counters.allocations.load(std::memory_order_relaxed);
+            result.nanoseconds  += counters.nanoseconds.load(std::memory_order_relaxed);
+            const uint64_t longestToken = counters.longestToken.load(std::memory_order_relaxed);
+            if(longestToken > result.longestToken)
+            {
+                result.longestToken = longestToken;
+            }
+        }
+
+        static void DumpMetric(std::ostream &os, const std::string &strName, const char *type, const char *help, uint64_t value)
+        {
+            os << "# HELP " << strName << " " << help << "\n"
+               << "# TYPE " << strName << " " << type << "\n"
+               << strName << " " << value << "\n";
+        }
+};
+
+/** @}*/
+
+#ifdef SIMPLE_TOKENIZE_STATS
+
+/// Count a call, that scans BYTES bytes, and measure the time until the end of the scope.
+#define SIMPLE_TOKENIZE_STATS_CALL(BYTES) const simple_tokenize_stats::CCall simple_tokenize_stats_call(BYTES)
+/// Count a token, that is not copied.
+#define SIMPLE_TOKENIZE_STATS_TOKEN(LENGTH) simple_tokenize_stats::OnToken(LENGTH)
+/// Count a token, that is copied into a string, which is appended to the vector VEC.
+#define SIMPLE_TOKENIZE_STATS_COPY(VEC, LENGTH) simple_tokenize_stats::OnCopy((VEC).size() == (VEC).capacity(), LENGTH)
+
+#endif // SIMPLE_TOKENIZE_STATS
+
+#endif // SIMPLE_TOKENIZE_STATS_HPP
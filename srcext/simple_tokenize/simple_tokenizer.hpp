@@ -0,0 +1,147 @@
+/*!
+ * \file simple_tokenizer.hpp
+ * \brief A reusable tokenizer object, that keeps its output storage between calls.
+ *
+ * \author Dr. Martin Ettl
+ */
+#ifndef SIMPLE_TOKENIZER_HPP
+#define SIMPLE_TOKENIZER_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "simple_tokenize.hpp"
+#include "simple_token_normalizer.hpp"
+
+/** \addtogroup simple_tokenize simple_tokenize
+ *  @{
+ */
+
+/// \brief In contrast to simple_tokenize<Pred>::Tokenize, which clears the result vector and
+///  thereby frees the memory of every token, this class overwrites the tokens of the
+///  previous call in place. Neither the capacity of the vector nor the capacity of the
+///  token strings is released. Tokenizing similar strings in a loop reaches a state,
+///  where no memory is allocated anymore.
+///
+///  The tokens of the last call are valid until the next call. One instance per thread
+///  can be kept as a thread_local variable, see GetThreadInstance().
+///
+///  It can be used as follows:
+///  \code{.cpp}
+///         simple_tokenizer<CIsComma> tokenizer;
+///         while(std::getline(ifs, line))
+///         {
+///             tokenizer.Tokenize(line);
+///             for(std::size_t ui = 0; ui < tokenizer.size(); ++ui)
+///             {
+///                 process(tokenizer[ui]);
+///             }
+///         }
+///  \endcode
+template < class Pred = CIsSpace > class simple_tokenizer
+{
+    public:
+        typedef std::vector<std::string>::const_iterator const_iterator;
+
+        explicit simple_tokenizer(const Pred & roPred = Pred())
+            : m_Pred(roPred)
+            , m_size(0)
+        {}
+
+        /// Tokenize a string, the tokens of the previous call are overwritten.
+        /// \return <-- the number of tokens
+        std::size_t Tokenize(std::string_view str)
+        {
+            m_size = 0;
+            simple_tokenize<Pred>::ForEachToken(str, [this](std::string_view token)
+            {
+                if(m_size < m_tokens.size())
+                {
+                    // reuse the memory of the token
+                    m_tokens[m_size].assign(token.data(), token.size());
+                }
+                else
+                {
+                    m_tokens.push_back(std::string(token));
+                }
+                ++m_size;
+            }, m_Pred);
+            return m_size;
+        }
+
+        /// Tokenize a string and normalize the tokens into the memory of the previous ones.
+        /// Tokens, of which nothing is left, are dropped.
+        /// \return <-- the number of tokens
+        std::size_t TokenizeAndTransform(std::string_view str, const simple_token_normalizer &roNormalizer)
+        {
+            m_size = 0;
+            simple_tokenize<Pred>::ForEachToken(str, [this, &roNormalizer](std::string_view token)
+            {
+                if(m_size == m_tokens.size())
+                {
+                    m_tokens.push_back(std::string());
+                }
+                if(roNormalizer.Apply(m_tokens[m_size], token))
+                {
+                    ++m_size;
+                }
+            }, m_Pred);
+            return m_size;
+        }
+
+        std::size_t size(void) const
+        {
+            return m_size;
+        }
+
+        bool empty(void) const
+        {
+            return m_size == 0;
+        }
+
+        const std::string& operator[](std::size_t index) const
+        {
+            return m_tokens[index];
+        }
+
+        const_iterator begin(void) const
+        {
+            return m_tokens.begin();
+        }
+
+        const_iterator end(void) const
+        {
+            return m_tokens.begin() + static_cast<std::ptrdiff_t>(m_size);
+        }
+
+        /// Copy the tokens into a vector, e.g. to keep them beyond the next call.
+        std::vector<std::string> GetTokens(void) const
+        {
+            return std::vector<std::string>(begin(), end());
+        }
+
+        /// Release all memory, e.g. after an unusually long string.
+        void ShrinkToFit(void)
+        {
+            std::vector<std::string>().swap(m_tokens);
+            m_size = 0;
+        }
+
+        /// \return the tokenizer of the calling thread (requires a default constructible Pred)
+        static simple_tokenizer &GetThreadInstance(void)
+        {
+            static thread_local simple_tokenizer instance;
+            return instance;
+        }
+
+    private:
+        Pred                     m_Pred;
+        /// the first m_size elements are the tokens of the last call, the others keep their memory
+        std::vector<std::string> m_tokens;
+        std::size_t              m_size;
+};
+
+/** @}*/
+
+#endif // SIMPLE_TOKENIZER_HPP